@@ -0,0 +1,33 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<eeprom.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<The <avr/eeprom.h> of the host HAL, the EEMEM variables are
+ * 					kept in the file of HOST_AVR_EEPROM by host_eeprom.c>
+ ---------------------------------------------------------------------------*/
+
+#ifndef HOST_AVR_EEPROM_H_
+#define HOST_AVR_EEPROM_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+#define EEMEM		__attribute__((section("host_eeprom")))
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+
+uint8_t eeprom_read_byte(const uint8_t *a_addressPtr);
+uint16_t eeprom_read_word(const uint16_t *a_addressPtr);
+void eeprom_read_block(void *a_dataPtr, const void *a_addressPtr, size_t size);
+void eeprom_update_byte(uint8_t *a_addressPtr, uint8_t value);
+void eeprom_update_word(uint16_t *a_addressPtr, uint16_t value);
+void eeprom_update_block(const void *a_dataPtr, void *a_addressPtr, size_t size);
+
+#endif /* HOST_AVR_EEPROM_H_ */
@@ -0,0 +1,26 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<interrupt.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<The <avr/interrupt.h> of the host HAL, an ISR is a function
+ * 					the HAL calls when its flag, its enable bit and the I bit are set>
+ ---------------------------------------------------------------------------*/
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include <avr/io.h>
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+#define ISR(vector)		void vector(void); void vector(void)
+
+#define sei()			(SREG |= (uint8_t)(1<<7))
+#define cli()			(SREG &= (uint8_t)~(1<<7))
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
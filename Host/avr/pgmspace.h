@@ -0,0 +1,28 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<pgmspace.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<The <avr/pgmspace.h> of the host HAL, the flash tables are
+ * 					constants in the memory of the host>
+ ---------------------------------------------------------------------------*/
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include <stdint.h>
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+#define PROGMEM
+
+#define pgm_read_byte(address)		(*(const uint8_t *)(address))
+#define pgm_read_word(address)		(*(const uint16_t *)(address))
+#define pgm_read_dword(address)		(*(const uint32_t *)(address))
+#define pgm_read_ptr(address)		(*(void * const *)(address))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
@@ -0,0 +1,1164 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<cosim.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the co-simulation of mC1 and mC2: the host builds of
+ * 					the two MCUs are run with their UARTs connected by a virtual serial line,
+ * 					the keypad is driven by scenario scripts and the LCD is checked. By default
+ * 					the MCUs run on simulated time in lockstep windows of the harness, with -w
+ * 					they run on the clock of the host>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "std_types.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define COSIM_NUM_OF_MCUS		2
+#define COSIM_MC1				0
+#define COSIM_MC2				1
+
+#define COSIM_LINE_SIZE			256
+#define COSIM_MAX_STEPS			256
+#define COSIM_MAX_METRICS		16
+#define COSIM_LINE_QUEUE_SIZE	256		/* Bytes on the way on a direction of the line */
+
+#define COSIM_DEFAULT_BAUD		19200
+#define COSIM_FRAME_BITS		10		/* Start bit, 8 data bits and the stop bit */
+#define COSIM_DEFAULT_TIMEOUT	60000	/* Time in ms of an expect without a timeout */
+#define COSIM_READY_TIMEOUT		5000	/* Time in ms to wait for the start of the MCUs */
+#define COSIM_WINDOW_TIMEOUT	5000	/* Time in ms of the host to wait for the end of a window */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* An event reported by an MCU on its control channel */
+typedef struct
+{
+	uint64 time;				/* Time in us of the harness */
+	char *text;
+}COSIM_EventType;
+
+/* One direction of the serial line, a byte written by an MCU takes a frame time
+ * on the line and is delivered at the end of its stop bit */
+typedef struct
+{
+	uint8 byte[COSIM_LINE_QUEUE_SIZE];
+	uint64 time[COSIM_LINE_QUEUE_SIZE];
+	uint16 head;
+	uint16 tail;
+	uint64 free;				/* The line is free for the next frame */
+	uint64 last;				/* Delivery of the last byte, the order is kept */
+	uint32 bytes;
+	uint32 corrupted;			/* Delivered with flipped data bits */
+	uint32 lost;				/* Dropped for a flipped start or stop bit */
+}COSIM_LineType;
+
+typedef struct
+{
+	const char *name;
+	pid_t pid;
+	int uart;
+	int control;
+	boolean ready;
+	boolean waiting;			/* At the end of its window in the lockstep */
+	sint64 offset;				/* Time in us of the harness at the cycle 0 of the MCU */
+	char input[COSIM_LINE_SIZE];
+	uint16 input_size;
+	COSIM_EventType *events;
+	uint32 num_of_events;
+	uint32 cursor;				/* First event not matched by an expect */
+	uint64 last_key;			/* Time of the last key seen by the firmware */
+}COSIM_McuType;
+
+typedef enum
+{
+	COSIM_PRESS, COSIM_SEND, COSIM_INJECT, COSIM_WAIT, COSIM_EXPECT
+}COSIM_StepKindType;
+
+/* A line of a scenario */
+typedef struct
+{
+	COSIM_StepKindType kind;
+	uint8 mcu;
+	char text[COSIM_LINE_SIZE];
+	uint32 time;				/* Time in ms of a wait or of the timeout of an expect */
+	sint8 metric;				/* Latency measured by an expect, -1 for none */
+	uint16 line;
+}COSIM_StepType;
+
+/* The latencies of a named expect, from the last key seen by the firmware */
+typedef struct
+{
+	char name[32];
+	double *samples;			/* Time in ms */
+	uint32 count;
+}COSIM_MetricType;
+
+typedef struct
+{
+	const char *path;
+	COSIM_StepType steps[COSIM_MAX_STEPS];
+	uint16 num_of_steps;
+	COSIM_MetricType metrics[COSIM_MAX_METRICS];
+	uint8 num_of_metrics;
+	uint32 passed;
+	uint32 failed;
+	uint32 bytes[COSIM_NUM_OF_MCUS];		/* Totals of the lines of all the runs */
+	uint32 corrupted[COSIM_NUM_OF_MCUS];
+	uint32 lost[COSIM_NUM_OF_MCUS];
+	double simulated;			/* Time in s of the MCUs of all the runs */
+	double elapsed;				/* Time in s of the host of all the runs */
+}COSIM_ScenarioType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static const char * const g_COSIM_names[COSIM_NUM_OF_MCUS] = {"mc1", "mc2"};
+
+static COSIM_McuType g_COSIM_mcus[COSIM_NUM_OF_MCUS];
+static COSIM_LineType g_COSIM_lines[COSIM_NUM_OF_MCUS];	/* Indexed by the sender */
+
+/* Options */
+static uint32 g_COSIM_baud = COSIM_DEFAULT_BAUD;
+static uint32 g_COSIM_jitter = 0;		/* Largest random delay in us of a byte */
+static double g_COSIM_ber = 0.0;		/* Bit error rate of the line */
+static uint32 g_COSIM_runs = 1;
+static uint64 g_COSIM_seed = 1;
+static boolean g_COSIM_verbose = FALSE;
+static boolean g_COSIM_wall = FALSE;	/* The MCUs run on the clock of the host */
+static uint32 g_COSIM_quantum = 0;		/* Time in us of a lockstep window, a frame by default */
+static char g_COSIM_directory[COSIM_LINE_SIZE];	/* Directory of mc1 and mc2 */
+static const char *g_COSIM_trace = NULL_PTR;	/* Directory of the traces of the MCUs */
+
+static struct timespec g_COSIM_start;
+static uint64 g_COSIM_time = 0;			/* Simulated time in us, the end of the last window */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void COSIM_usage(const char *a_name);
+static boolean COSIM_load(COSIM_ScenarioType *a_scenarioPtr);
+static sint8 COSIM_metric(COSIM_ScenarioType *a_scenarioPtr, const char *a_name);
+static boolean COSIM_run(COSIM_ScenarioType *a_scenarioPtr, uint32 run);
+static boolean COSIM_startMcus(const char *a_directory);
+static void COSIM_stopMcus(void);
+static boolean COSIM_expect(COSIM_ScenarioType *a_scenarioPtr, const COSIM_StepType *a_stepPtr);
+static boolean COSIM_pump(uint64 until);
+static boolean COSIM_window(uint64 end);
+static boolean COSIM_poll(int timeout);
+static void COSIM_readUart(uint8 mcu);
+static boolean COSIM_readControl(uint8 mcu);
+static void COSIM_send(uint8 mcu, uint8 data, uint64 now);
+static void COSIM_deliver(uint64 now);
+static void COSIM_command(uint8 mcu, const char *a_format, const char *a_text);
+static void COSIM_report(const COSIM_ScenarioType *a_scenarioPtr);
+static int COSIM_compare(const void *a_first, const void *a_second);
+static uint64 COSIM_now(void);
+static uint64 COSIM_elapsed(void);
+static double COSIM_random(void);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	main
+ * [DESCRIPTION]:	This Function is used to run each scenario the number of runs asked,
+ * 					then report its results
+ * [ARGS]:		int argc :		This Arg shall indicate the number of arguments
+ * 				char **argv :	This Arg shall indicate the options and the scenarios
+ * [RETURNS]:	0 when all the runs passed, else 1
+ ----------------------------------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+	char program[COSIM_LINE_SIZE];
+	COSIM_ScenarioType *scenario;
+	boolean passed = TRUE;
+	uint32 run;
+	int option;
+
+	snprintf(program, sizeof(program), "%s", argv[0]);
+	snprintf(g_COSIM_directory, sizeof(g_COSIM_directory), "%s", dirname(program));
+
+	while((option = getopt(argc, argv, "b:j:e:n:s:d:q:t:wv")) != -1)
+	{
+		switch(option)
+		{
+		case 'b':
+			g_COSIM_baud = (uint32)strtoul(optarg, NULL_PTR, 10);
+			break;
+		case 'j':
+			g_COSIM_jitter = (uint32)strtoul(optarg, NULL_PTR, 10);
+			break;
+		case 'e':
+			g_COSIM_ber = strtod(optarg, NULL_PTR);
+			break;
+		case 'n':
+			g_COSIM_runs = (uint32)strtoul(optarg, NULL_PTR, 10);
+			break;
+		case 's':
+			g_COSIM_seed = strtoull(optarg, NULL_PTR, 10);
+			break;
+		case 'd':
+			snprintf(g_COSIM_directory, sizeof(g_COSIM_directory), "%s", optarg);
+			break;
+		case 'q':
+			g_COSIM_quantum = (uint32)strtoul(optarg, NULL_PTR, 10);
+			break;
+		case 't':
+			g_COSIM_trace = optarg;
+			break;
+		case 'w':
+			g_COSIM_wall = TRUE;
+			break;
+		case 'v':
+			g_COSIM_verbose = TRUE;
+			break;
+		default:
+			COSIM_usage(argv[0]);
+			return 1;
+		}
+	}
+	if((optind == argc) || (g_COSIM_baud == 0) || (g_COSIM_runs == 0))
+	{
+		COSIM_usage(argv[0]);
+		return 1;
+	}
+	if(g_COSIM_seed == 0)
+	{
+		g_COSIM_seed = 1;
+	}
+	if(g_COSIM_quantum == 0)
+	{
+		/* A byte sent in a window is not delivered before the end of the next one */
+		g_COSIM_quantum = (COSIM_FRAME_BITS * 1000000UL) / g_COSIM_baud;
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	for(; optind < argc; optind++)
+	{
+		scenario = calloc(1, sizeof(COSIM_ScenarioType));
+		scenario->path = argv[optind];
+		if(COSIM_load(scenario) == FALSE)
+		{
+			return 1;
+		}
+
+		for(run = 1; run <= g_COSIM_runs; run++)
+		{
+			if(COSIM_run(scenario, run) == TRUE)
+			{
+				scenario->passed++;
+			}
+			else
+			{
+				scenario->failed++;
+				passed = FALSE;
+			}
+		}
+		COSIM_report(scenario);
+	}
+
+	return (passed == TRUE) ? 0 : 1;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_usage
+ * [DESCRIPTION]:	This Function is used to print the options
+ * [ARGS]:		const char *a_name :	This Arg shall indicate the name of the program
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void COSIM_usage(const char *a_name)
+{
+	fprintf(stderr,
+			"usage: %s [options] scenario...\n"
+			"  -b baud     baud rate of the line (%u)\n"
+			"  -j usec     largest random delay of a byte on the line (0)\n"
+			"  -e rate     bit error rate of the line (0)\n"
+			"  -n runs     runs of each scenario (1)\n"
+			"  -s seed     seed of the jitter and of the bit errors (1)\n"
+			"  -d dir      directory of mc1 and mc2 (the one of %s)\n"
+			"  -q usec     time of a lockstep window (a frame of the line)\n"
+			"  -t dir      write the trace of each MCU of the last run to dir/<mcu>.trace\n"
+			"  -w          run on the clock of the host instead of simulated time\n"
+			"  -v          print the events of the MCUs\n",
+			a_name, COSIM_DEFAULT_BAUD, a_name);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_load
+ * [DESCRIPTION]:	This Function is used to read a scenario. Its lines are:
+ * 					press <keys>						keys of the keypad of mC1
+ * 					send <mcu> <command>				a command of the control channel
+ * 					inject <mcu> <bytes>				bytes of a PC on the RX line of the MCU
+ * 					wait <ms>
+ * 					expect <mcu> "<text>" [ms] [as <name>]
+ * 					An expect waits for an event of the MCU that contains the text, the
+ * 					events after the last match are searched first. With a name, the time
+ * 					from the last key seen by mC1 is added to the latencies of the name
+ * [ARGS]:		COSIM_ScenarioType *a_scenarioPtr :	This Arg shall indicate the scenario
+ * [RETURNS]:	TRUE when the scenario is valid
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_load(COSIM_ScenarioType *a_scenarioPtr)
+{
+	char line[COSIM_LINE_SIZE];
+	char word[COSIM_LINE_SIZE];
+	char mcu[8];
+	char name[32];
+	COSIM_StepType *step;
+	FILE *file = fopen(a_scenarioPtr->path, "r");
+	uint16 number = 0;
+	char *rest;
+	char *end;
+	int used;
+
+	if(file == NULL_PTR)
+	{
+		fprintf(stderr, "%s: %s\n", a_scenarioPtr->path, strerror(errno));
+		return FALSE;
+	}
+
+	while(fgets(line, sizeof(line), file) != NULL_PTR)
+	{
+		number++;
+		line[strcspn(line, "\r\n")] = '\0';
+		if((sscanf(line, "%s%n", word, &used) != 1) || (word[0] == '#'))
+		{
+			continue;
+		}
+		if(a_scenarioPtr->num_of_steps == COSIM_MAX_STEPS)
+		{
+			break;
+		}
+
+		step = &a_scenarioPtr->steps[a_scenarioPtr->num_of_steps];
+		step->line = number;
+		step->metric = -1;
+		step->mcu = COSIM_MC1;
+		rest = line + used + strspn(line + used, " \t");
+
+		if(strcmp(word, "press") == 0)
+		{
+			step->kind = COSIM_PRESS;
+			snprintf(step->text, sizeof(step->text), "%s", rest);
+		}
+		else if(strcmp(word, "wait") == 0)
+		{
+			step->kind = COSIM_WAIT;
+			step->time = (uint32)strtoul(rest, NULL_PTR, 10);
+		}
+		else if(((strcmp(word, "send") == 0) || (strcmp(word, "inject") == 0) || (strcmp(word, "expect") == 0)) &&
+				(sscanf(rest, "%7s%n", mcu, &used) == 1)
+				&& ((strcmp(mcu, "mc1") == 0) || (strcmp(mcu, "mc2") == 0)))
+		{
+			step->mcu = (strcmp(mcu, "mc1") == 0) ? COSIM_MC1 : COSIM_MC2;
+			rest += used;
+			rest += strspn(rest, " \t");
+			if(word[0] == 's')
+			{
+				step->kind = COSIM_SEND;
+				snprintf(step->text, sizeof(step->text), "%s", rest);
+			}
+			else if(word[0] == 'i')
+			{
+				step->kind = COSIM_INJECT;
+				snprintf(step->text, sizeof(step->text), "%s", rest);
+			}
+			else if((rest[0] == '"') && ((end = strchr(rest + 1, '"')) != NULL_PTR))
+			{
+				step->kind = COSIM_EXPECT;
+				snprintf(step->text, sizeof(step->text), "%.*s", (int)(end - rest - 1), rest + 1);
+				step->time = (uint32)strtoul(end + 1, &rest, 10);
+				if(step->time == 0)
+				{
+					step->time = COSIM_DEFAULT_TIMEOUT;
+				}
+				if(sscanf(rest, " as %31s", name) == 1)
+				{
+					step->metric = COSIM_metric(a_scenarioPtr, name);
+				}
+			}
+			else
+			{
+				fprintf(stderr, "%s:%u: the text of expect shall be quoted\n", a_scenarioPtr->path, number);
+				fclose(file);
+				return FALSE;
+			}
+		}
+		else
+		{
+			fprintf(stderr, "%s:%u: unknown step '%s'\n", a_scenarioPtr->path, number, line);
+			fclose(file);
+			return FALSE;
+		}
+		a_scenarioPtr->num_of_steps++;
+	}
+
+	fclose(file);
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_metric
+ * [DESCRIPTION]:	This Function is used to get the index of a latency, it is added when
+ * 					the name is new
+ * [ARGS]:		COSIM_ScenarioType *a_scenarioPtr :	This Arg shall indicate the scenario
+ * 				const char *a_name :				This Arg shall indicate the name
+ * [RETURNS]:	The index, -1 when there are too many
+ ----------------------------------------------------------------------------------------*/
+static sint8 COSIM_metric(COSIM_ScenarioType *a_scenarioPtr, const char *a_name)
+{
+	uint8 i;
+
+	for(i = 0; i < a_scenarioPtr->num_of_metrics; i++)
+	{
+		if(strcmp(a_scenarioPtr->metrics[i].name, a_name) == 0)
+		{
+			return (sint8)i;
+		}
+	}
+	if(i == COSIM_MAX_METRICS)
+	{
+		return -1;
+	}
+
+	snprintf(a_scenarioPtr->metrics[i].name, sizeof(a_scenarioPtr->metrics[i].name), "%s", a_name);
+	a_scenarioPtr->metrics[i].samples = calloc(g_COSIM_runs, sizeof(double));
+	a_scenarioPtr->num_of_metrics++;
+	return (sint8)i;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_run
+ * [DESCRIPTION]:	This Function is used to run a scenario once from erased EEPROMs, each
+ * 					run has its own directory for the EEPROM files of the MCUs
+ * [ARGS]:		COSIM_ScenarioType *a_scenarioPtr :	This Arg shall indicate the scenario
+ * 				uint32 run :						This Arg shall indicate the number of the run
+ * [RETURNS]:	TRUE when all the expects matched
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_run(COSIM_ScenarioType *a_scenarioPtr, uint32 run)
+{
+	char directory[] = "/tmp/cosim.XXXXXX";
+	char path[COSIM_LINE_SIZE];
+	const COSIM_StepType *step;
+	const char *text;
+	boolean passed = TRUE;
+	uint16 i;
+	uint8 mcu;
+
+	if(mkdtemp(directory) == NULL_PTR)
+	{
+		perror("mkdtemp");
+		return FALSE;
+	}
+
+	memset(g_COSIM_lines, 0, sizeof(g_COSIM_lines));
+	clock_gettime(CLOCK_MONOTONIC, &g_COSIM_start);
+	g_COSIM_time = 0;
+	if(COSIM_startMcus(directory) == FALSE)
+	{
+		fprintf(stderr, "%s run %u: the MCUs did not start\n", a_scenarioPtr->path, run);
+		passed = FALSE;
+	}
+
+	for(i = 0; (passed == TRUE) && (i < a_scenarioPtr->num_of_steps); i++)
+	{
+		step = &a_scenarioPtr->steps[i];
+		switch(step->kind)
+		{
+		case COSIM_PRESS:
+			COSIM_command(COSIM_MC1, "press %s\n", step->text);
+			break;
+		case COSIM_SEND:
+			COSIM_command(step->mcu, "%s\n", step->text);
+			break;
+		case COSIM_INJECT:
+			/* The bytes share the line of the other MCU, after its last frame */
+			for(text = step->text; *text != '\0'; text++)
+			{
+				COSIM_send(step->mcu ^ 1, (uint8)*text, COSIM_now());
+			}
+			break;
+		case COSIM_WAIT:
+			if(COSIM_pump(COSIM_now() + ((uint64)step->time * 1000)) == FALSE)
+			{
+				fprintf(stderr, "%s run %u line %u: an MCU stopped\n", a_scenarioPtr->path, run, step->line);
+				passed = FALSE;
+			}
+			break;
+		case COSIM_EXPECT:
+			if(COSIM_expect(a_scenarioPtr, step) == FALSE)
+			{
+				fprintf(stderr, "%s run %u line %u: no \"%s\" from %s\n", a_scenarioPtr->path, run,
+						step->line, step->text, g_COSIM_names[step->mcu]);
+				passed = FALSE;
+			}
+			break;
+		}
+	}
+
+	a_scenarioPtr->simulated += COSIM_now() / 1000000.0;
+	a_scenarioPtr->elapsed += COSIM_elapsed() / 1000000.0;
+	COSIM_stopMcus();
+	for(mcu = 0; mcu < COSIM_NUM_OF_MCUS; mcu++)
+	{
+		a_scenarioPtr->bytes[mcu] += g_COSIM_lines[mcu].bytes;
+		a_scenarioPtr->corrupted[mcu] += g_COSIM_lines[mcu].corrupted;
+		a_scenarioPtr->lost[mcu] += g_COSIM_lines[mcu].lost;
+		snprintf(path, sizeof(path), "%s/%s.24c16", directory, g_COSIM_names[mcu]);
+		unlink(path);
+		snprintf(path, sizeof(path), "%s/%s.eeprom", directory, g_COSIM_names[mcu]);
+		unlink(path);
+	}
+	rmdir(directory);
+
+	return passed;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_startMcus
+ * [DESCRIPTION]:	This Function is used to start mc1 and mc2, the UART and the control
+ * 					channel of each one are sockets to the harness. It waits for them to be
+ * 					ready, the time of their cycle 0 is taken from the ready event. In the
+ * 					lockstep the UART is on the control channel and the MCUs wait for the
+ * 					first window
+ * [ARGS]:		const char *a_directory :	This Arg shall indicate the directory of the
+ * 											EEPROM files
+ * [RETURNS]:	TRUE when both MCUs are ready
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_startMcus(const char *a_directory)
+{
+	char path[COSIM_LINE_SIZE + 8];
+	char value[COSIM_LINE_SIZE];
+	int uart[2] = {-1, -1};
+	int control[2];
+	COSIM_McuType *mcuPtr;
+	uint64 deadline;
+	uint8 mcu;
+	int null;
+
+	for(mcu = 0; mcu < COSIM_NUM_OF_MCUS; mcu++)
+	{
+		mcuPtr = &g_COSIM_mcus[mcu];
+		memset(mcuPtr, 0, sizeof(COSIM_McuType));
+		mcuPtr->name = g_COSIM_names[mcu];
+		mcuPtr->pid = -1;
+
+		if(((g_COSIM_wall == TRUE) && (socketpair(AF_UNIX, SOCK_STREAM, 0, uart) < 0)) || (socketpair(AF_UNIX, SOCK_STREAM, 0, control) < 0))
+		{
+			perror("socketpair");
+			return FALSE;
+		}
+
+		mcuPtr->pid = fork();
+		if(mcuPtr->pid == 0)
+		{
+			close(uart[0]);
+			close(control[0]);
+			null = open("/dev/null", O_RDWR);
+			dup2(null, STDIN_FILENO);
+			dup2(null, STDOUT_FILENO);
+
+			if(g_COSIM_wall == TRUE)
+			{
+				snprintf(value, sizeof(value), "%d", uart[1]);
+			}
+			else
+			{
+				snprintf(value, sizeof(value), "control");
+				setenv("HOST_CLOCK", "lockstep", 1);
+			}
+			setenv("HOST_UART_IN", value, 1);
+			setenv("HOST_UART_OUT", value, 1);
+			snprintf(value, sizeof(value), "%d", control[1]);
+			setenv("HOST_CONTROL", value, 1);
+			snprintf(value, sizeof(value), "%s/%s.24c16", a_directory, mcuPtr->name);
+			setenv("HOST_EEPROM", value, 1);
+			snprintf(value, sizeof(value), "%s/%s.eeprom", a_directory, mcuPtr->name);
+			setenv("HOST_AVR_EEPROM", value, 1);
+			if(g_COSIM_trace != NULL_PTR)
+			{
+				snprintf(value, sizeof(value), "%s/%s.trace", g_COSIM_trace, mcuPtr->name);
+				setenv("HOST_TRACE", value, 1);
+			}
+
+			snprintf(path, sizeof(path), "%s/%s", g_COSIM_directory, mcuPtr->name);
+			execl(path, path, (char *)NULL_PTR);
+			perror(path);
+			_exit(127);
+		}
+
+		if(g_COSIM_wall == TRUE)
+		{
+			close(uart[1]);
+			fcntl(uart[0], F_SETFL, O_NONBLOCK);
+		}
+		close(control[1]);
+		mcuPtr->uart = uart[0];
+		mcuPtr->control = control[0];
+		fcntl(mcuPtr->control, F_SETFL, O_NONBLOCK);
+	}
+
+	deadline = COSIM_elapsed() + (COSIM_READY_TIMEOUT * 1000ULL);
+	for(mcu = 0; (mcu < COSIM_NUM_OF_MCUS) && (COSIM_elapsed() < deadline);)
+	{
+		mcuPtr = &g_COSIM_mcus[mcu];
+		if((mcuPtr->ready == TRUE) && ((g_COSIM_wall == TRUE) || (mcuPtr->waiting == TRUE)))
+		{
+			mcu++;
+		}
+		else if(COSIM_poll(COSIM_READY_TIMEOUT) == FALSE)
+		{
+			return FALSE;
+		}
+	}
+
+	return (mcu == COSIM_NUM_OF_MCUS);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_stopMcus
+ * [DESCRIPTION]:	This Function is used to end mc1 and mc2 and free their events
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void COSIM_stopMcus(void)
+{
+	COSIM_McuType *mcuPtr;
+	uint32 i;
+	uint8 mcu;
+
+	for(mcu = 0; mcu < COSIM_NUM_OF_MCUS; mcu++)
+	{
+		mcuPtr = &g_COSIM_mcus[mcu];
+		if(mcuPtr->pid > 0)
+		{
+			kill(mcuPtr->pid, SIGTERM);
+			waitpid(mcuPtr->pid, NULL_PTR, 0);
+			if(mcuPtr->uart >= 0)
+			{
+				close(mcuPtr->uart);
+			}
+			close(mcuPtr->control);
+		}
+		for(i = 0; i < mcuPtr->num_of_events; i++)
+		{
+			free(mcuPtr->events[i].text);
+		}
+		free(mcuPtr->events);
+		mcuPtr->events = NULL_PTR;
+		mcuPtr->num_of_events = 0;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_expect
+ * [DESCRIPTION]:	This Function is used to wait for an event that contains the text of
+ * 					the step and take its latency
+ * [ARGS]:		COSIM_ScenarioType *a_scenarioPtr :	This Arg shall indicate the scenario
+ * 				const COSIM_StepType *a_stepPtr :	This Arg shall indicate the expect
+ * [RETURNS]:	TRUE when the event came before the timeout
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_expect(COSIM_ScenarioType *a_scenarioPtr, const COSIM_StepType *a_stepPtr)
+{
+	COSIM_McuType *mcuPtr = &g_COSIM_mcus[a_stepPtr->mcu];
+	uint64 deadline = COSIM_now() + ((uint64)a_stepPtr->time * 1000);
+	COSIM_MetricType *metricPtr;
+	const COSIM_EventType *eventPtr;
+
+	for(;;)
+	{
+		for(; mcuPtr->cursor < mcuPtr->num_of_events; mcuPtr->cursor++)
+		{
+			eventPtr = &mcuPtr->events[mcuPtr->cursor];
+			if(strstr(eventPtr->text, a_stepPtr->text) != NULL_PTR)
+			{
+				mcuPtr->cursor++;
+				if(a_stepPtr->metric >= 0)
+				{
+					metricPtr = &a_scenarioPtr->metrics[a_stepPtr->metric];
+					metricPtr->samples[metricPtr->count++] = (eventPtr->time - g_COSIM_mcus[COSIM_MC1].last_key) / 1000.0;
+				}
+				return TRUE;
+			}
+		}
+
+		if((COSIM_now() >= deadline) || (COSIM_pump(COSIM_now() + 1000) == FALSE))
+		{
+			return FALSE;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_pump
+ * [DESCRIPTION]:	This Function is used to move the bytes of the line and read the events
+ * 					of the MCUs until a time. In the lockstep the time is run in windows
+ * [ARGS]:		uint64 until :	This Arg shall indicate the time in us of the harness
+ * [RETURNS]:	FALSE when an MCU stopped
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_pump(uint64 until)
+{
+	COSIM_LineType *linePtr;
+	uint64 now = COSIM_now();
+	uint64 next;
+	uint8 mcu;
+
+	while(now < until)
+	{
+		if(g_COSIM_wall == FALSE)
+		{
+			next = ((until - now) > g_COSIM_quantum) ? (now + g_COSIM_quantum) : until;
+			if(COSIM_window(next) == FALSE)
+			{
+				return FALSE;
+			}
+			now = next;
+			continue;
+		}
+
+		next = until;
+		for(mcu = 0; mcu < COSIM_NUM_OF_MCUS; mcu++)
+		{
+			linePtr = &g_COSIM_lines[mcu];
+			if((linePtr->head != linePtr->tail) && (linePtr->time[linePtr->head] < next))
+			{
+				next = linePtr->time[linePtr->head];
+			}
+		}
+
+		if(COSIM_poll((int)((next - now + 999) / 1000)) == FALSE)
+		{
+			return FALSE;
+		}
+		now = COSIM_now();
+		COSIM_deliver(now);
+	}
+
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_window
+ * [DESCRIPTION]:	This Function is used to run a lockstep window: the bytes that reach an
+ * 					MCU before its end are given with their time, then both MCUs run up to
+ * 					its end. A window is not longer than a frame so a byte sent in it is
+ * 					given before the window of its delivery
+ * [ARGS]:		uint64 end :	This Arg shall indicate the end of the window in us
+ * [RETURNS]:	FALSE when an MCU stopped
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_window(uint64 end)
+{
+	char line[COSIM_LINE_SIZE];
+	int size;
+	uint8 mcu;
+
+	COSIM_deliver(end);
+	size = snprintf(line, sizeof(line), "run %llu\n", (unsigned long long)((end * F_CPU) / 1000000ULL));
+	for(mcu = 0; mcu < COSIM_NUM_OF_MCUS; mcu++)
+	{
+		g_COSIM_mcus[mcu].waiting = FALSE;
+		if(write(g_COSIM_mcus[mcu].control, line, size) < 0)
+		{
+			return FALSE;
+		}
+	}
+
+	for(mcu = 0; mcu < COSIM_NUM_OF_MCUS;)
+	{
+		if(g_COSIM_mcus[mcu].waiting == TRUE)
+		{
+			mcu++;
+		}
+		else if(COSIM_poll(COSIM_WINDOW_TIMEOUT) == FALSE)
+		{
+			return FALSE;
+		}
+	}
+
+	g_COSIM_time = end;
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_poll
+ * [DESCRIPTION]:	This Function is used to wait for the UARTs and the control channels of
+ * 					the MCUs and read them
+ * [ARGS]:		int timeout :	This Arg shall indicate the longest wait in ms
+ * [RETURNS]:	FALSE when an MCU closed its channel, or when nothing came in the
+ * 				lockstep
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_poll(int timeout)
+{
+	struct pollfd fds[2 * COSIM_NUM_OF_MCUS];
+	int count;
+	uint8 mcu;
+
+	for(mcu = 0; mcu < COSIM_NUM_OF_MCUS; mcu++)
+	{
+		fds[2 * mcu].fd = g_COSIM_mcus[mcu].uart;
+		fds[2 * mcu].events = POLLIN;
+		fds[(2 * mcu) + 1].fd = g_COSIM_mcus[mcu].control;
+		fds[(2 * mcu) + 1].events = POLLIN;
+	}
+
+	count = poll(fds, 2 * COSIM_NUM_OF_MCUS, timeout);
+	if((count == 0) && (g_COSIM_wall == FALSE))
+	{
+		return FALSE;
+	}
+	for(mcu = 0; (count > 0) && (mcu < COSIM_NUM_OF_MCUS); mcu++)
+	{
+		if(fds[2 * mcu].revents & POLLIN)
+		{
+			COSIM_readUart(mcu);
+		}
+		if((fds[(2 * mcu) + 1].revents & (POLLIN | POLLHUP)) && (COSIM_readControl(mcu) == FALSE))
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_readUart
+ * [DESCRIPTION]:	This Function is used to put the bytes sent by an MCU on the line
+ * [ARGS]:		uint8 mcu :	This Arg shall indicate the sender
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void COSIM_readUart(uint8 mcu)
+{
+	uint8 input[COSIM_LINE_QUEUE_SIZE];
+	uint64 now = COSIM_now();
+	ssize_t size;
+	ssize_t i;
+
+	size = read(g_COSIM_mcus[mcu].uart, input, sizeof(input));
+	for(i = 0; i < size; i++)
+	{
+		COSIM_send(mcu, input[i], now);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_readControl
+ * [DESCRIPTION]:	This Function is used to read the events of an MCU, the cycle at the
+ * 					start of each line is changed to the time of the harness. In the
+ * 					lockstep the end of a window and the bytes sent are not kept as events
+ * [ARGS]:		uint8 mcu :	This Arg shall indicate the MCU
+ * [RETURNS]:	FALSE when the MCU closed its channel
+ ----------------------------------------------------------------------------------------*/
+static boolean COSIM_readControl(uint8 mcu)
+{
+	COSIM_McuType *mcuPtr = &g_COSIM_mcus[mcu];
+	char input[COSIM_LINE_SIZE];
+	COSIM_EventType *eventPtr;
+	unsigned long long cycles;
+	uint64 time;
+	ssize_t size;
+	ssize_t i;
+	unsigned int data;
+	int used;
+
+	size = read(mcuPtr->control, input, sizeof(input));
+	if(size == 0)
+	{
+		return FALSE;
+	}
+	for(i = 0; i < size; i++)
+	{
+		if(input[i] != '\n')
+		{
+			if(mcuPtr->input_size < (COSIM_LINE_SIZE - 1))
+			{
+				mcuPtr->input[mcuPtr->input_size++] = input[i];
+			}
+			continue;
+		}
+
+		mcuPtr->input[mcuPtr->input_size] = '\0';
+		mcuPtr->input_size = 0;
+		if(sscanf(mcuPtr->input, "%llu %n", &cycles, &used) != 1)
+		{
+			continue;
+		}
+
+		time = (cycles * 1000000ULL) / F_CPU;
+		if(mcuPtr->ready == FALSE)
+		{
+			/* The simulated time of the MCUs is the time of the harness */
+			mcuPtr->offset = (g_COSIM_wall == TRUE) ? ((sint64)COSIM_now() - (sint64)time) : 0;
+			mcuPtr->ready = TRUE;
+		}
+		time = (uint64)(mcuPtr->offset + (sint64)time);
+
+		if(strcmp(mcuPtr->input + used, "wait") == 0)
+		{
+			mcuPtr->waiting = TRUE;
+			continue;
+		}
+		if(sscanf(mcuPtr->input + used, "tx %u", &data) == 1)
+		{
+			COSIM_send(mcu, (uint8)data, time);
+			continue;
+		}
+
+		mcuPtr->events = realloc(mcuPtr->events, (mcuPtr->num_of_events + 1) * sizeof(COSIM_EventType));
+		eventPtr = &mcuPtr->events[mcuPtr->num_of_events++];
+		eventPtr->time = time;
+		eventPtr->text = strdup(mcuPtr->input + used);
+		if((strncmp(eventPtr->text, "key ", 4) == 0) && (strstr(eventPtr->text, " down") != NULL_PTR))
+		{
+			mcuPtr->last_key = time;
+		}
+		if(g_COSIM_verbose == TRUE)
+		{
+			printf("%10.3f %s %s\n", time / 1000.0, mcuPtr->name, eventPtr->text);
+		}
+	}
+
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_send
+ * [DESCRIPTION]:	This Function is used to put a byte sent by an MCU on the line. The byte
+ * 					waits for the end of the last frame, the jitter delays it and each bit
+ * 					of its frame may be flipped
+ * [ARGS]:		uint8 mcu :		This Arg shall indicate the sender
+ * 				uint8 data :	This Arg shall indicate the byte
+ * 				uint64 now :	This Arg shall indicate the time in us it was sent
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void COSIM_send(uint8 mcu, uint8 data, uint64 now)
+{
+	COSIM_LineType *linePtr = &g_COSIM_lines[mcu];
+	uint64 frame = ((uint64)COSIM_FRAME_BITS * 1000000ULL) / g_COSIM_baud;
+	uint64 delivery;
+	boolean lost = FALSE;
+	boolean corrupted = FALSE;
+	uint8 bit;
+
+	linePtr->bytes++;
+	linePtr->free = ((linePtr->free > now) ? linePtr->free : now) + frame;
+	delivery = linePtr->free + (uint64)(COSIM_random() * g_COSIM_jitter);
+	if(delivery < linePtr->last)
+	{
+		delivery = linePtr->last;
+	}
+
+	for(bit = 0; (g_COSIM_ber > 0.0) && (bit < COSIM_FRAME_BITS); bit++)
+	{
+		if(COSIM_random() < g_COSIM_ber)
+		{
+			if((bit == 0) || (bit == (COSIM_FRAME_BITS - 1)))
+			{
+				lost = TRUE;
+			}
+			else
+			{
+				data ^= (uint8)(1 << (bit - 1));
+				corrupted = TRUE;
+			}
+		}
+	}
+	if(lost == TRUE)
+	{
+		linePtr->lost++;
+		return;
+	}
+	if(corrupted == TRUE)
+	{
+		linePtr->corrupted++;
+	}
+
+	if(((linePtr->tail + 1) % COSIM_LINE_QUEUE_SIZE) == linePtr->head)
+	{
+		linePtr->lost++;
+		return;
+	}
+	linePtr->byte[linePtr->tail] = data;
+	linePtr->time[linePtr->tail] = delivery;
+	linePtr->tail = (linePtr->tail + 1) % COSIM_LINE_QUEUE_SIZE;
+	linePtr->last = delivery;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_deliver
+ * [DESCRIPTION]:	This Function is used to give each MCU the bytes that reached it, in
+ * 					the lockstep as "rx <cycle> <byte>" with the cycle of the delivery
+ * [ARGS]:		uint64 now :	This Arg shall indicate the time in us of the harness
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void COSIM_deliver(uint64 now)
+{
+	COSIM_LineType *linePtr;
+	char line[COSIM_LINE_SIZE];
+	int size;
+	uint8 mcu;
+
+	for(mcu = 0; mcu < COSIM_NUM_OF_MCUS; mcu++)
+	{
+		linePtr = &g_COSIM_lines[mcu];
+		while((linePtr->head != linePtr->tail) && (linePtr->time[linePtr->head] <= now))
+		{
+			/* The line of a sender goes to the other MCU */
+			if(g_COSIM_wall == FALSE)
+			{
+				size = snprintf(line, sizeof(line), "rx %llu %u\n",
+						(unsigned long long)(((linePtr->time[linePtr->head] * F_CPU) + 999999ULL) / 1000000ULL), linePtr->byte[linePtr->head]);
+				if(write(g_COSIM_mcus[mcu ^ 1].control, line, size) < 0)
+				{
+					break;
+				}
+			}
+			else if(write(g_COSIM_mcus[mcu ^ 1].uart, &linePtr->byte[linePtr->head], 1) < 0)
+			{
+				break;
+			}
+			linePtr->head = (linePtr->head + 1) % COSIM_LINE_QUEUE_SIZE;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_command
+ * [DESCRIPTION]:	This Function is used to send a command line to an MCU
+ * [ARGS]:		uint8 mcu :				This Arg shall indicate the MCU
+ * 				const char *a_format :	This Arg shall indicate the format of the line
+ * 				const char *a_text :	This Arg shall indicate the text of the step
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void COSIM_command(uint8 mcu, const char *a_format, const char *a_text)
+{
+	char line[COSIM_LINE_SIZE + 8];
+	int size = snprintf(line, sizeof(line), a_format, a_text);
+
+	if(write(g_COSIM_mcus[mcu].control, line, size) < 0)
+	{
+		perror(g_COSIM_names[mcu]);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_report
+ * [DESCRIPTION]:	This Function is used to print the results of a scenario: the passed
+ * 					runs, the distribution of each latency and the bytes of the line
+ * [ARGS]:		const COSIM_ScenarioType *a_scenarioPtr :	This Arg shall indicate the scenario
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void COSIM_report(const COSIM_ScenarioType *a_scenarioPtr)
+{
+	const COSIM_MetricType *metricPtr;
+	double sum;
+	uint32 i;
+	uint8 m;
+
+	printf("%s: %u/%u runs passed (baud %u, jitter %u us, ber %g)\n", a_scenarioPtr->path, a_scenarioPtr->passed,
+			a_scenarioPtr->passed + a_scenarioPtr->failed, g_COSIM_baud, g_COSIM_jitter, g_COSIM_ber);
+	printf("  %s time %.1f s in %.1f s of the host\n", (g_COSIM_wall == TRUE) ? "wall clock" : "simulated",
+			a_scenarioPtr->simulated, a_scenarioPtr->elapsed);
+
+	for(m = 0; m < a_scenarioPtr->num_of_metrics; m++)
+	{
+		metricPtr = &a_scenarioPtr->metrics[m];
+		if(metricPtr->count == 0)
+		{
+			printf("  %-16s no samples\n", metricPtr->name);
+			continue;
+		}
+
+		qsort(metricPtr->samples, metricPtr->count, sizeof(double), COSIM_compare);
+		sum = 0.0;
+		for(i = 0; i < metricPtr->count; i++)
+		{
+			sum += metricPtr->samples[i];
+		}
+		/* The percentiles are of the nearest rank */
+		printf("  %-16s n=%-4u min=%.2f p50=%.2f p90=%.2f p99=%.2f max=%.2f mean=%.2f ms\n", metricPtr->name, metricPtr->count,
+				metricPtr->samples[0],
+				metricPtr->samples[(uint32)ceil(0.50 * metricPtr->count) - 1],
+				metricPtr->samples[(uint32)ceil(0.90 * metricPtr->count) - 1],
+				metricPtr->samples[(uint32)ceil(0.99 * metricPtr->count) - 1],
+				metricPtr->samples[metricPtr->count - 1], sum / metricPtr->count);
+	}
+
+	for(m = 0; m < COSIM_NUM_OF_MCUS; m++)
+	{
+		printf("  line %s->%s   %u bytes, %u corrupted, %u lost\n", g_COSIM_names[m], g_COSIM_names[m ^ 1],
+				a_scenarioPtr->bytes[m], a_scenarioPtr->corrupted[m], a_scenarioPtr->lost[m]);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_compare
+ * [DESCRIPTION]:	This Function is used by qsort to order the latencies
+ * [ARGS]:		const void *a_first :	This Arg shall indicate the first latency
+ * 				const void *a_second :	This Arg shall indicate the second latency
+ * [RETURNS]:	The order of the latencies
+ ----------------------------------------------------------------------------------------*/
+static int COSIM_compare(const void *a_first, const void *a_second)
+{
+	double first = *(const double *)a_first;
+	double second = *(const double *)a_second;
+
+	return (first > second) - (first < second);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_now
+ * [DESCRIPTION]:	This Function is used to read the time of the harness, the simulated
+ * 					time in the lockstep
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The time in us since the start of the run
+ ----------------------------------------------------------------------------------------*/
+static uint64 COSIM_now(void)
+{
+	return (g_COSIM_wall == TRUE) ? COSIM_elapsed() : g_COSIM_time;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_elapsed
+ * [DESCRIPTION]:	This Function is used to read the clock of the host
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The time in us since the start of the run
+ ----------------------------------------------------------------------------------------*/
+static uint64 COSIM_elapsed(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64)(now.tv_sec - g_COSIM_start.tv_sec) * 1000000ULL) + ((now.tv_nsec - g_COSIM_start.tv_nsec) / 1000);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	COSIM_random
+ * [DESCRIPTION]:	This Function is used to get a random number of the seed, a xorshift
+ * 					so a run can be repeated with the same errors
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	A number from 0 up to 1
+ ----------------------------------------------------------------------------------------*/
+static double COSIM_random(void)
+{
+	g_COSIM_seed ^= g_COSIM_seed << 13;
+	g_COSIM_seed ^= g_COSIM_seed >> 7;
+	g_COSIM_seed ^= g_COSIM_seed << 17;
+
+	return (double)(g_COSIM_seed >> 11) / 9007199254740992.0;
+}
@@ -0,0 +1,261 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<hash_timing.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the timing test of HASH_verify of mC2. The candidates
+ * 					of a password are put in classes by the bytes they share with it, and
+ * 					the cost of each call is the number of the instructions it runs. The
+ * 					test fails if the costs of the classes are not all the same>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "std_types.h"
+#include "hash.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define TIMING_SAMPLES			200		/* Calls of each class, each with a new password and salt */
+
+/*
+ * The simulated clock of the host HAL only moves on the accesses to the registers
+ * and the delays, HASH_verify makes none so its calls cost nothing there. Each call
+ * is single stepped instead: the trap flag of the x86 makes a SIGTRAP after every
+ * instruction, which gives the exact number of the instructions of the call
+ */
+#if defined(__x86_64__)
+#define TIMING_SUPPORTED		TRUE
+#define TIMING_TRAP_FLAG_ON()	__asm__ __volatile__("leaq -128(%%rsp),%%rsp\n\tpushfq\n\torq $0x100,(%%rsp)\n\tpopfq\n\tleaq 128(%%rsp),%%rsp" ::: "memory", "cc")
+#define TIMING_TRAP_FLAG_OFF()	__asm__ __volatile__("leaq -128(%%rsp),%%rsp\n\tpushfq\n\tandq $-257,(%%rsp)\n\tpopfq\n\tleaq 128(%%rsp),%%rsp" ::: "memory", "cc")
+#else
+#define TIMING_SUPPORTED		FALSE
+#endif
+
+/*
+ * The password has HASH_VERIFY_SIZE bytes. A candidate of TIMING_PREFIX(n) has its
+ * first n bytes right and the next one wrong, TIMING_SHORT is the password without
+ * its last byte (all the typed bytes are right) and TIMING_CORRECT is the password
+ */
+#define TIMING_PREFIX(n)		(n)
+#define TIMING_SHORT			HASH_VERIFY_SIZE
+#define TIMING_CORRECT			(HASH_VERIFY_SIZE + 1)
+#define TIMING_NUM_OF_CLASSES	(HASH_VERIFY_SIZE + 2)
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef struct
+{
+	uint64 min;
+	uint64 max;
+	uint64 sum;
+	uint32 errors;		/* Calls that gave a wrong verdict */
+}TIMING_ClassType;
+
+#if (TIMING_SUPPORTED == TRUE)
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static volatile uint64 g_TIMING_steps;
+static uint32 g_TIMING_random = 0x2545F491;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void TIMING_trap(int signal, siginfo_t *info, void *context);
+static uint8 TIMING_randomByte(void);
+static uint64 TIMING_measure(const uint8 *a_saltPtr, const uint8 *a_bufferPtr, uint8 size, uint64 hash, boolean *a_resultPtr);
+
+#endif
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	main
+ * [DESCRIPTION]:	This Function is used to verify the candidates of each class against
+ * 					their passwords and print the costs of the classes. The check is a bound
+ * 					on the minimum and the maximum: all the calls shall run the same number
+ * 					of instructions, so no class can be told apart whatever the samples
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	0 if the time does not depend on the candidate, else 1
+ ----------------------------------------------------------------------------------------*/
+int main(void)
+{
+#if (TIMING_SUPPORTED == TRUE)
+	TIMING_ClassType classes[TIMING_NUM_OF_CLASSES];
+	struct sigaction action;
+	uint8 salt[HASH_SALT_SIZE];
+	uint8 password[HASH_VERIFY_SIZE];
+	uint8 candidate[HASH_VERIFY_SIZE];
+	uint64 hash;
+	uint64 steps;
+	uint64 min = (uint64)-1;
+	uint64 max = 0;
+	uint32 errors = 0;
+	uint8 size;
+	boolean result;
+	uint16 sample;
+	uint8 class;
+	uint8 i;
+
+	memset(&action, 0, sizeof(action));
+	action.sa_sigaction = TIMING_trap;
+	action.sa_flags = SA_SIGINFO;
+	sigaction(SIGTRAP, &action, NULL_PTR);
+
+	for(class = 0; class < TIMING_NUM_OF_CLASSES; class++)
+	{
+		classes[class].min = (uint64)-1;
+		classes[class].max = 0;
+		classes[class].sum = 0;
+		classes[class].errors = 0;
+	}
+
+	/* The classes take turns so a drift of the host is shared by all of them */
+	for(sample = 0; sample < TIMING_SAMPLES; sample++)
+	{
+		for(class = 0; class < TIMING_NUM_OF_CLASSES; class++)
+		{
+			for(i = 0; i < HASH_SALT_SIZE; i++)
+			{
+				salt[i] = TIMING_randomByte();
+			}
+			for(i = 0; i < HASH_VERIFY_SIZE; i++)
+			{
+				password[i] = TIMING_randomByte();
+			}
+			hash = HASH_compute(salt, password, HASH_VERIFY_SIZE);
+
+			memcpy(candidate, password, HASH_VERIFY_SIZE);
+			size = HASH_VERIFY_SIZE;
+			if(class == TIMING_SHORT)
+			{
+				candidate[HASH_VERIFY_SIZE - 1] = 0;
+				size = HASH_VERIFY_SIZE - 1;
+			}
+			else if(class != TIMING_CORRECT)
+			{
+				/* The first wrong byte is never the right one, the next are random */
+				candidate[class] ^= (uint8)(TIMING_randomByte() | 0x01);
+				for(i = class + 1; i < HASH_VERIFY_SIZE; i++)
+				{
+					candidate[i] = TIMING_randomByte();
+				}
+			}
+
+			steps = TIMING_measure(salt, candidate, size, hash, &result);
+			if(result != ((class == TIMING_CORRECT) ? TRUE : FALSE))
+			{
+				classes[class].errors++;
+			}
+			if(steps < classes[class].min)
+			{
+				classes[class].min = steps;
+			}
+			if(steps > classes[class].max)
+			{
+				classes[class].max = steps;
+			}
+			classes[class].sum += steps;
+		}
+	}
+
+	printf("HASH_verify instructions per call, %u calls per class\n", TIMING_SAMPLES);
+	for(class = 0; class < TIMING_NUM_OF_CLASSES; class++)
+	{
+		if(class == TIMING_SHORT)
+		{
+			printf("  %-16s", "short by 1 byte");
+		}
+		else if(class == TIMING_CORRECT)
+		{
+			printf("  %-16s", "correct");
+		}
+		else
+		{
+			printf("  prefix %u bytes  ", TIMING_PREFIX(class));
+		}
+		printf(" min=%llu max=%llu mean=%.1f wrong verdicts=%u\n",
+				(unsigned long long)classes[class].min, (unsigned long long)classes[class].max,
+				(double)classes[class].sum / TIMING_SAMPLES, classes[class].errors);
+
+		min = (classes[class].min < min) ? classes[class].min : min;
+		max = (classes[class].max > max) ? classes[class].max : max;
+		errors += classes[class].errors;
+	}
+
+	if((min != max) || (errors != 0))
+	{
+		printf("FAILED: the time of HASH_verify depends on the candidate (%llu..%llu), %u wrong verdicts\n",
+				(unsigned long long)min, (unsigned long long)max, errors);
+		return 1;
+	}
+	printf("passed: every call runs %llu instructions\n", (unsigned long long)min);
+	return 0;
+#else
+	printf("HASH_verify timing test skipped, the single stepping needs an x86-64 host\n");
+	return 0;
+#endif
+}
+
+#if (TIMING_SUPPORTED == TRUE)
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TIMING_trap
+ * [DESCRIPTION]:	This Function is the handler of SIGTRAP, it counts a single step. The
+ * 					kernel clears the trap flag while it runs and restores it after
+ * [ARGS]:		int signal :		This Arg shall indicate the signal
+ * 				siginfo_t *info :	This Arg shall indicate the information of the signal
+ * 				void *context :		This Arg shall indicate the interrupted context
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void TIMING_trap(int signal, siginfo_t *info, void *context)
+{
+	(void)signal;
+	(void)info;
+	(void)context;
+
+	g_TIMING_steps++;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TIMING_randomByte
+ * [DESCRIPTION]:	This Function is used to get a byte of a xorshift generator, the runs
+ * 					are the same from one build to the next
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The random byte
+ ----------------------------------------------------------------------------------------*/
+static uint8 TIMING_randomByte(void)
+{
+	g_TIMING_random ^= g_TIMING_random << 13;
+	g_TIMING_random ^= g_TIMING_random >> 17;
+	g_TIMING_random ^= g_TIMING_random << 5;
+
+	return (uint8)(g_TIMING_random >> 24);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TIMING_measure
+ * [DESCRIPTION]:	This Function is used to run HASH_verify with the trap flag set. The
+ * 					steps of the code around the call are the same for every call
+ * [ARGS]:		const uint8 *a_saltPtr :	This Arg shall indicate the salt
+ * 				const uint8 *a_bufferPtr :	This Arg shall indicate the candidate
+ * 				uint8 size :				This Arg shall indicate the size of the candidate
+ * 				uint64 hash :				This Arg shall indicate the hash of the password
+ * 				boolean *a_resultPtr :		This Arg shall indicate where the verdict is put
+ * [RETURNS]:	The number of the single steps of the call
+ ----------------------------------------------------------------------------------------*/
+static uint64 TIMING_measure(const uint8 *a_saltPtr, const uint8 *a_bufferPtr, uint8 size, uint64 hash, boolean *a_resultPtr)
+{
+	g_TIMING_steps = 0;
+	TIMING_TRAP_FLAG_ON();
+	*a_resultPtr = HASH_verify(a_saltPtr, a_bufferPtr, size, hash);
+	TIMING_TRAP_FLAG_OFF();
+
+	return g_TIMING_steps;
+}
+
+#endif	/* TIMING_SUPPORTED */
@@ -0,0 +1,774 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the core of the host HAL: the registers, the
+ * 					interrupts and the time of the models>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_SREG_I				0x80
+#define HOST_NUM_OF_MODELS		(sizeof(g_HOST_models) / sizeof(g_HOST_models[0]))
+#define HOST_WAIT_SLEEP_TIME	100		/* Longest sleep in us of a delay between two polls */
+
+/* Costs in CPU cycles of the virtual clock, the code between two accesses is not
+ * timed so an access is taken as an IN or OUT with the load and the branch around it */
+#define HOST_ACCESS_CYCLES		4
+#define HOST_ISR_CYCLES			20		/* Response, prologue, epilogue and RETI of an ISR */
+#define HOST_IDLE_ACCESSES		32		/* Accesses without a write that make a polling loop */
+#define HOST_SPIN_TIME			5		/* Time in us of the host to the next tick in a loop on a variable */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* The source of the time of the models, given by HOST_CLOCK */
+typedef enum
+{
+	HOST_CLOCK_WALL,		/* The clock of the host, the delays sleep */
+	HOST_CLOCK_VIRTUAL,		/* Simulated time, it advances with the accesses and the delays */
+	HOST_CLOCK_LOCKSTEP		/* Simulated time granted by the harness on the control channel */
+}HOST_ClockType;
+
+/* An interrupt source, the vector is taken when its flag and its enable bit are set */
+typedef struct
+{
+	uint8 flag_address;
+	uint8 flag_mask;
+	uint8 enable_address;
+	uint8 enable_mask;
+	boolean auto_clear;			/* The flag is cleared when the vector is taken */
+	void (*handler)(void);
+}HOST_VectorType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* The ISRs of the firmware, a vector that the firmware does not define is NULL */
+void INT0_vect(void) __attribute__((weak));
+void INT1_vect(void) __attribute__((weak));
+void TIMER2_COMP_vect(void) __attribute__((weak));
+void TIMER2_OVF_vect(void) __attribute__((weak));
+void TIMER1_CAPT_vect(void) __attribute__((weak));
+void TIMER1_COMPA_vect(void) __attribute__((weak));
+void TIMER1_COMPB_vect(void) __attribute__((weak));
+void TIMER1_OVF_vect(void) __attribute__((weak));
+void TIMER0_OVF_vect(void) __attribute__((weak));
+void USART_RXC_vect(void) __attribute__((weak));
+void USART_UDRE_vect(void) __attribute__((weak));
+void USART_TXC_vect(void) __attribute__((weak));
+void ADC_vect(void) __attribute__((weak));
+void INT2_vect(void) __attribute__((weak));
+void TIMER0_COMP_vect(void) __attribute__((weak));
+
+static const HOST_VectorType g_HOST_vectors[HOST_NUM_OF_VECTORS] =
+{
+	[HOST_INT0_VECT]		= {HOST_GIFR,	0x40,	HOST_GICR,		0x40,	TRUE,	INT0_vect},
+	[HOST_INT1_VECT]		= {HOST_GIFR,	0x80,	HOST_GICR,		0x80,	TRUE,	INT1_vect},
+	[HOST_TIMER2_COMP_VECT]	= {HOST_TIFR,	0x80,	HOST_TIMSK,		0x80,	TRUE,	TIMER2_COMP_vect},
+	[HOST_TIMER2_OVF_VECT]	= {HOST_TIFR,	0x40,	HOST_TIMSK,		0x40,	TRUE,	TIMER2_OVF_vect},
+	[HOST_TIMER1_CAPT_VECT]	= {HOST_TIFR,	0x20,	HOST_TIMSK,		0x20,	TRUE,	TIMER1_CAPT_vect},
+	[HOST_TIMER1_COMPA_VECT]= {HOST_TIFR,	0x10,	HOST_TIMSK,		0x10,	TRUE,	TIMER1_COMPA_vect},
+	[HOST_TIMER1_COMPB_VECT]= {HOST_TIFR,	0x08,	HOST_TIMSK,		0x08,	TRUE,	TIMER1_COMPB_vect},
+	[HOST_TIMER1_OVF_VECT]	= {HOST_TIFR,	0x04,	HOST_TIMSK,		0x04,	TRUE,	TIMER1_OVF_vect},
+	[HOST_TIMER0_OVF_VECT]	= {HOST_TIFR,	0x01,	HOST_TIMSK,		0x01,	TRUE,	TIMER0_OVF_vect},
+	[HOST_USART_RXC_VECT]	= {HOST_UCSRA,	0x80,	HOST_UCSRB,		0x80,	FALSE,	USART_RXC_vect},
+	[HOST_USART_UDRE_VECT]	= {HOST_UCSRA,	0x20,	HOST_UCSRB,		0x20,	FALSE,	USART_UDRE_vect},
+	[HOST_USART_TXC_VECT]	= {HOST_UCSRA,	0x40,	HOST_UCSRB,		0x40,	TRUE,	USART_TXC_vect},
+	[HOST_ADC_VECT]			= {HOST_ADCSRA,	0x10,	HOST_ADCSRA,	0x08,	TRUE,	ADC_vect},
+	[HOST_INT2_VECT]		= {HOST_GIFR,	0x20,	HOST_GICR,		0x20,	TRUE,	INT2_vect},
+	[HOST_TIMER0_COMP_VECT]	= {HOST_TIFR,	0x02,	HOST_TIMSK,		0x02,	TRUE,	TIMER0_COMP_vect}
+};
+
+extern const HOST_ModelType g_HOST_timerModel;
+extern const HOST_ModelType g_HOST_uartModel;
+extern const HOST_ModelType g_HOST_twiModel;
+extern const HOST_ModelType g_HOST_adcModel;
+extern const HOST_ModelType g_HOST_gpioModel;
+extern const HOST_ModelType g_HOST_eepromModel;
+extern const HOST_ModelType g_HOST_lcdModel;
+extern const HOST_ModelType g_HOST_keypadModel;
+extern const HOST_ModelType g_HOST_doorModel;
+extern const HOST_ModelType g_HOST_traceModel;
+extern const HOST_ModelType g_HOST_boardModel;		/* Connects the devices of the target */
+extern const HOST_ModelType g_HOST_controlModel;
+
+static const HOST_ModelType * const g_HOST_models[] =
+{
+	&g_HOST_timerModel, &g_HOST_uartModel, &g_HOST_twiModel,
+	&g_HOST_adcModel, &g_HOST_gpioModel, &g_HOST_eepromModel,
+	&g_HOST_lcdModel, &g_HOST_keypadModel, &g_HOST_doorModel,
+	&g_HOST_traceModel, &g_HOST_boardModel, &g_HOST_controlModel
+};
+
+/* The registers and their values at the last sync, a difference is a write of the firmware */
+static volatile uint8 g_HOST_regs[HOST_REG_SIZE];
+static uint8 g_HOST_shadow[HOST_REG_SIZE];
+static HOST_ReadHookType g_HOST_readHooks[HOST_REG_SIZE];
+static HOST_WriteHookType g_HOST_writeHooks[HOST_REG_SIZE];
+
+/* The models are run by the first access of a statement or by the tick, the
+ * accesses of an ISR or of a model only look for the writes */
+static volatile sig_atomic_t g_HOST_depth = 0;
+static volatile sig_atomic_t g_HOST_inTick = FALSE;
+static uint8 g_HOST_vector = HOST_NO_VECT;
+
+static HOST_ClockType g_HOST_clockType = HOST_CLOCK_WALL;
+static struct timespec g_HOST_start;
+static uint64 g_HOST_clock = 0;					/* Simulated time of the firmware */
+static uint64 g_HOST_cycle = 0;					/* Time of the models */
+static uint64 g_HOST_limit = HOST_NEVER;		/* The process ends at this time */
+
+/* A polling loop reads the same registers without writing them, the simulated time
+ * then jumps to the next event of the models */
+static uint16 g_HOST_idle = 0;
+static volatile sig_atomic_t g_HOST_accesses = 0;	/* Seen by the tick to find a loop on a variable */
+static sig_atomic_t g_HOST_tickAccesses = 0;		/* The accesses at the last tick */
+
+/* In a loop on a variable, the vectors taken since the last tick and the ones that
+ * did not end the loop, a bit for each vector */
+static uint32 g_HOST_dispatched = 0;
+static uint32 g_HOST_spinVectors = 0;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_init(void) __attribute__((constructor));
+static void HOST_run(uint64 target);
+static void HOST_sync(void);
+static uint64 HOST_nextEvent(uint8 *a_modelPtr);
+static void HOST_detectWrites(void);
+static void HOST_dispatch(void);
+static uint64 HOST_clockNow(void);
+static void HOST_tick(int signal);
+static void HOST_wait(uint64 cycles);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_access
+ * [DESCRIPTION]:	This Function is used by the firmware registers of <avr/io.h>. The first
+ * 					access of a statement runs the models up to now, then the read hook of
+ * 					the register may refresh it or give another byte for the access. On the
+ * 					simulated clock each access takes HOST_ACCESS_CYCLES, and a polling loop
+ * 					goes on at the next event of the models
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	The byte the firmware shall read or write
+ ----------------------------------------------------------------------------------------*/
+volatile uint8 *HOST_access(uint8 address)
+{
+	volatile uint8 *access = &g_HOST_regs[address];
+	volatile uint8 *hooked;
+	uint64 target;
+	uint64 next;
+
+	g_HOST_depth++;
+	g_HOST_accesses++;
+	if(g_HOST_depth == 1)
+	{
+		target = g_HOST_clock + HOST_ACCESS_CYCLES;
+		if((g_HOST_clockType != HOST_CLOCK_WALL) && (++g_HOST_idle >= HOST_IDLE_ACCESSES))
+		{
+			next = HOST_nextEvent(NULL_PTR);
+			if((next != HOST_NEVER) && (next > target))
+			{
+				target = next;
+			}
+		}
+		HOST_run(target);
+	}
+	else
+	{
+		HOST_detectWrites();
+	}
+
+	if(g_HOST_readHooks[address] != NULL_PTR)
+	{
+		hooked = (*g_HOST_readHooks[address])(address);
+		if(hooked != NULL_PTR)
+		{
+			access = hooked;
+		}
+		g_HOST_shadow[address] = g_HOST_regs[address];
+	}
+	g_HOST_depth--;
+
+	return access;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_poll
+ * [DESCRIPTION]:	This Function is used to run the models and the interrupts up to now
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_poll(void)
+{
+	g_HOST_depth++;
+	if(g_HOST_depth == 1)
+	{
+		HOST_run(g_HOST_clock);
+	}
+	else
+	{
+		HOST_detectWrites();
+	}
+	g_HOST_depth--;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_busy
+ * [DESCRIPTION]:	This Function is used to count the current access as a progress of the
+ * 					firmware, the clock is not moved up to the next event at the next one
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_busy(void)
+{
+	g_HOST_idle = 0;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_cycles
+ * [DESCRIPTION]:	This Function is used to read the time of the models, during an event
+ * 					it is the time of the event
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The time in CPU cycles since the start
+ ----------------------------------------------------------------------------------------*/
+uint64 HOST_cycles(void)
+{
+	return g_HOST_cycle;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_usToCycles
+ * [DESCRIPTION]:	This Function is used to convert a time in microseconds to CPU cycles
+ * [ARGS]:		uint32 usec :	This Arg shall indicate the time in microseconds
+ * [RETURNS]:	The time in CPU cycles
+ ----------------------------------------------------------------------------------------*/
+uint64 HOST_usToCycles(uint32 usec)
+{
+	return ((uint64)usec * F_CPU) / 1000000ULL;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_getReg
+ * [DESCRIPTION]:	This Function is used by the models to read a register without hooks
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	The value of the register
+ ----------------------------------------------------------------------------------------*/
+uint8 HOST_getReg(uint8 address)
+{
+	return g_HOST_regs[address];
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_setReg
+ * [DESCRIPTION]:	This Function is used by the models to change a register, the shadow
+ * 					is changed too so it is not seen as a write of the firmware
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * 				uint8 value :	This Arg shall indicate the new value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_setReg(uint8 address, uint8 value)
+{
+	g_HOST_regs[address] = value;
+	g_HOST_shadow[address] = value;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_changeBits
+ * [DESCRIPTION]:	This Function is used by the models to set or clear bits of a register
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * 				uint8 mask :	This Arg shall indicate the bits
+ * 				boolean level :	This Arg shall indicate TRUE to set the bits, FALSE to clear them
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_changeBits(uint8 address, uint8 mask, boolean level)
+{
+	uint8 value = g_HOST_regs[address];
+
+	HOST_setReg(address, (level == TRUE) ? (value | mask) : (value & (uint8)~mask));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_setHooks
+ * [DESCRIPTION]:	This Function is used by the models to set the hooks of a register
+ * [ARGS]:		uint8 address :					This Arg shall indicate the address
+ * 				HOST_ReadHookType a_readHook :	This Arg shall indicate the read hook or NULL_PTR
+ * 				HOST_WriteHookType a_writeHook :This Arg shall indicate the write hook or NULL_PTR
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_setHooks(uint8 address, HOST_ReadHookType a_readHook, HOST_WriteHookType a_writeHook)
+{
+	g_HOST_readHooks[address] = a_readHook;
+	g_HOST_writeHooks[address] = a_writeHook;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_currentVector
+ * [DESCRIPTION]:	This Function is used to get the vector of the running ISR
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The vector, HOST_NO_VECT outside of the ISRs
+ ----------------------------------------------------------------------------------------*/
+uint8 HOST_currentVector(void)
+{
+	return g_HOST_vector;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_inTick
+ * [DESCRIPTION]:	This Function is used to get if the models are run from the host tick
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	TRUE in the tick, FALSE when they are run by an access of the firmware
+ ----------------------------------------------------------------------------------------*/
+boolean HOST_inTick(void)
+{
+	return (g_HOST_inTick != FALSE) ? TRUE : FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_getConfig
+ * [DESCRIPTION]:	This Function is used to get a configuration variable of the environment
+ * [ARGS]:		const char *a_name :	This Arg shall indicate the name of the variable
+ * 				const char *a_default :	This Arg shall indicate the value if it is not set
+ * [RETURNS]:	The value of the variable
+ ----------------------------------------------------------------------------------------*/
+const char *HOST_getConfig(const char *a_name, const char *a_default)
+{
+	const char *value = getenv(a_name);
+
+	return ((value != NULL_PTR) && (value[0] != '\0')) ? value : a_default;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	_delay_ms
+ * [DESCRIPTION]:	This Function replaces the delay of <util/delay.h>, the models and the
+ * 					interrupts keep running while it waits
+ * [ARGS]:		double msec :	This Arg shall indicate the time in milliseconds
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void _delay_ms(double msec)
+{
+	HOST_wait((uint64)(msec * (F_CPU / 1000.0)));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	_delay_us
+ * [DESCRIPTION]:	This Function replaces the delay of <util/delay.h>
+ * [ARGS]:		double usec :	This Arg shall indicate the time in microseconds
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void _delay_us(double usec)
+{
+	HOST_wait((uint64)(usec * (F_CPU / 1000000.0)));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_init
+ * [DESCRIPTION]:	This Function is used to reset the registers and the models before the
+ * 					main of the firmware, then start the host tick
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_init(void)
+{
+	struct sigaction action;
+	struct itimerval tick;
+	uint32 limit;
+	uint8 i;
+
+	clock_gettime(CLOCK_MONOTONIC, &g_HOST_start);
+
+	/* HOST_CLOCK is wall, virtual or lockstep */
+	if(strcmp(HOST_getConfig("HOST_CLOCK", "wall"), "virtual") == 0)
+	{
+		g_HOST_clockType = HOST_CLOCK_VIRTUAL;
+	}
+	else if(strcmp(HOST_getConfig("HOST_CLOCK", "wall"), "lockstep") == 0)
+	{
+		g_HOST_clockType = HOST_CLOCK_LOCKSTEP;
+	}
+
+	/* The registers that are not 0 after a reset */
+	g_HOST_regs[HOST_UCSRA] = 0x20;
+	g_HOST_regs[HOST_TWSR] = 0xF8;
+	g_HOST_regs[HOST_TWDR] = 0xFF;
+
+	for(i = 0; i < HOST_NUM_OF_MODELS; i++)
+	{
+		if(g_HOST_models[i]->init != NULL_PTR)
+		{
+			(*g_HOST_models[i]->init)();
+		}
+	}
+	memcpy(g_HOST_shadow, (const uint8 *)g_HOST_regs, HOST_REG_SIZE);
+
+	/* HOST_TIME_LIMIT is the run time of the process in ms, 0 to run forever */
+	limit = (uint32)strtoul(HOST_getConfig("HOST_TIME_LIMIT", "0"), NULL_PTR, 10);
+	if(limit != 0)
+	{
+		g_HOST_limit = HOST_usToCycles(limit) * 1000;
+	}
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = HOST_tick;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGALRM, &action, NULL_PTR);
+
+	tick.it_interval.tv_sec = 0;
+	tick.it_interval.tv_usec = HOST_TICK_TIME;
+	tick.it_value = tick.it_interval;
+	setitimer(ITIMER_REAL, &tick, NULL_PTR);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_run
+ * [DESCRIPTION]:	This Function is used to run the models up to a time of the simulated
+ * 					clock. In the lockstep the time is taken in the windows granted by the
+ * 					harness, the events of a window are run before waiting for the next one.
+ * 					On the wall clock the models are run up to now
+ * [ARGS]:		uint64 target :	This Arg shall indicate the cycle of the simulated clock
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_run(uint64 target)
+{
+	uint64 granted;
+
+	if(g_HOST_clockType == HOST_CLOCK_WALL)
+	{
+		HOST_sync();
+		return;
+	}
+
+	for(;;)
+	{
+		granted = (g_HOST_clockType == HOST_CLOCK_LOCKSTEP) ? HOST_controlGrant(g_HOST_clock) : HOST_NEVER;
+		g_HOST_clock = (target < granted) ? target : granted;
+		HOST_sync();
+		if(g_HOST_clock >= target)
+		{
+			break;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_nextEvent
+ * [DESCRIPTION]:	This Function is used to find the first event of the models
+ * [ARGS]:		uint8 *a_modelPtr :	This Arg shall indicate where to put its model or NULL_PTR
+ * [RETURNS]:	The cycle of the event, HOST_NEVER if there is none
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_nextEvent(uint8 *a_modelPtr)
+{
+	uint64 first = HOST_NEVER;
+	uint64 next;
+	uint8 i;
+
+	for(i = 0; i < HOST_NUM_OF_MODELS; i++)
+	{
+		if(g_HOST_models[i]->next != NULL_PTR)
+		{
+			next = (*g_HOST_models[i]->next)();
+			if(next < first)
+			{
+				first = next;
+				if(a_modelPtr != NULL_PTR)
+				{
+					*a_modelPtr = i;
+				}
+			}
+		}
+	}
+
+	return first;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_sync
+ * [DESCRIPTION]:	This Function is used to run the models up to now. The writes are taken
+ * 					at the time of the last sync as the firmware writes just after an access,
+ * 					then the events of the models are run in the order of their cycles and
+ * 					the interrupts are taken between them
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_sync(void)
+{
+	uint64 now = HOST_clockNow();
+	uint64 first;
+	uint8 model = 0;
+	uint8 i;
+
+	HOST_detectWrites();
+
+	for(;;)
+	{
+		first = HOST_nextEvent(&model);
+		if(first > now)
+		{
+			break;
+		}
+
+		if(first > g_HOST_cycle)
+		{
+			g_HOST_cycle = first;
+		}
+		(*g_HOST_models[model]->event)();
+		HOST_dispatch();
+	}
+
+	if(now > g_HOST_cycle)
+	{
+		g_HOST_cycle = now;
+	}
+	for(i = 0; i < HOST_NUM_OF_MODELS; i++)
+	{
+		if(g_HOST_models[i]->sync != NULL_PTR)
+		{
+			(*g_HOST_models[i]->sync)();
+		}
+	}
+	HOST_dispatch();
+
+	if(g_HOST_cycle >= g_HOST_limit)
+	{
+		if(g_HOST_inTick != FALSE)
+		{
+			_exit(0);
+		}
+		exit(0);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_detectWrites
+ * [DESCRIPTION]:	This Function is used to compare the registers to their shadow and call
+ * 					the write hooks of the registers changed by the firmware
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_detectWrites(void)
+{
+	uint8 address;
+	uint8 old_value;
+	uint8 new_value;
+
+	if(memcmp(g_HOST_shadow, (const uint8 *)g_HOST_regs, HOST_REG_SIZE) == 0)
+	{
+		return;
+	}
+
+	for(address = 0; address < HOST_REG_SIZE; address++)
+	{
+		new_value = g_HOST_regs[address];
+		old_value = g_HOST_shadow[address];
+		if(new_value != old_value)
+		{
+			/* The interrupts are disabled around the reads of the shared variables,
+			 * and the writes of an ISR are not a progress of the polling loop */
+			if((address != HOST_SREG) && (g_HOST_vector == HOST_NO_VECT))
+			{
+				g_HOST_idle = 0;
+			}
+			g_HOST_shadow[address] = new_value;
+			if(g_HOST_writeHooks[address] != NULL_PTR)
+			{
+				(*g_HOST_writeHooks[address])(address, old_value, new_value);
+			}
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_dispatch
+ * [DESCRIPTION]:	This Function is used to take the pending interrupts in the order of
+ * 					their priority. The I bit is cleared during an ISR so they are not nested
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_dispatch(void)
+{
+	const HOST_VectorType *vector;
+	uint8 i = 1;
+
+	if(g_HOST_vector != HOST_NO_VECT)
+	{
+		return;
+	}
+
+	while((i < HOST_NUM_OF_VECTORS) && (g_HOST_regs[HOST_SREG] & HOST_SREG_I))
+	{
+		vector = &g_HOST_vectors[i];
+		if((vector->handler != NULL_PTR) && (g_HOST_regs[vector->flag_address] & vector->flag_mask)
+				&& (g_HOST_regs[vector->enable_address] & vector->enable_mask))
+		{
+			if(vector->auto_clear == TRUE)
+			{
+				HOST_changeBits(vector->flag_address, vector->flag_mask, FALSE);
+			}
+			HOST_changeBits(HOST_SREG, HOST_SREG_I, FALSE);
+			g_HOST_vector = i;
+			g_HOST_dispatched |= (uint32)1 << i;
+			if(g_HOST_clockType != HOST_CLOCK_WALL)
+			{
+				g_HOST_clock += HOST_ISR_CYCLES;
+			}
+			(*vector->handler)();
+			HOST_detectWrites();
+			g_HOST_vector = HOST_NO_VECT;
+			HOST_changeBits(HOST_SREG, HOST_SREG_I, TRUE);
+
+			/* A vector of a higher priority may be pending now */
+			i = 1;
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_clockNow
+ * [DESCRIPTION]:	This Function is used to read the time of the host clock, or of the
+ * 					simulated clock
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The time in CPU cycles since the start
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_clockNow(void)
+{
+	struct timespec now;
+	uint64 nsec;
+
+	if(g_HOST_clockType != HOST_CLOCK_WALL)
+	{
+		return g_HOST_clock;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	nsec = ((uint64)(now.tv_sec - g_HOST_start.tv_sec) * 1000000000ULL) + now.tv_nsec - g_HOST_start.tv_nsec;
+
+	return (nsec * (F_CPU / 1000)) / 1000000ULL;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_tick
+ * [DESCRIPTION]:	This Function is the handler of the host tick signal. It runs the models
+ * 					while the firmware waits in a loop that does not access a register, as
+ * 					a loop on a flag of an ISR. It does nothing if it interrupts the HAL. On
+ * 					the simulated clock such a loop takes no time: when there was no access
+ * 					since the last tick, the clock is moved up to the first ISR that did
+ * 					not run at the last tick, at most a tick, and the next tick comes after
+ * 					HOST_SPIN_TIME
+ * [ARGS]:		int signal :	This Arg shall indicate the signal
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_tick(int signal)
+{
+	int saved_errno = errno;
+
+	struct itimerval spin;
+	uint64 next;
+	uint64 end;
+
+	(void)signal;
+	if(g_HOST_depth == 0)
+	{
+		g_HOST_depth = 1;
+		g_HOST_inTick = TRUE;
+		if((g_HOST_clockType == HOST_CLOCK_WALL) || (g_HOST_accesses != g_HOST_tickAccesses))
+		{
+			HOST_run(g_HOST_clock);
+			g_HOST_dispatched = 0;
+			g_HOST_spinVectors = 0;
+		}
+		else
+		{
+			/* The firmware waits on a variable, the time goes on up to an ISR that may
+			 * end the loop. The ISRs taken at the last tick did not end it */
+			g_HOST_spinVectors |= g_HOST_dispatched;
+			g_HOST_dispatched = 0;
+			end = g_HOST_clock + HOST_usToCycles(HOST_TICK_TIME);
+			do
+			{
+				next = HOST_nextEvent(NULL_PTR);
+				HOST_run(((next > g_HOST_clock) && (next < end)) ? next : end);
+			}while((g_HOST_clock < end) && ((g_HOST_dispatched & ~g_HOST_spinVectors) == 0));
+
+			/* The loop sees the ISRs of the event at once, so the next one comes soon */
+			spin.it_interval.tv_sec = 0;
+			spin.it_interval.tv_usec = HOST_TICK_TIME;
+			spin.it_value.tv_sec = 0;
+			spin.it_value.tv_usec = HOST_SPIN_TIME;
+			setitimer(ITIMER_REAL, &spin, NULL_PTR);
+		}
+		g_HOST_tickAccesses = g_HOST_accesses;
+		g_HOST_inTick = FALSE;
+		g_HOST_depth = 0;
+	}
+	errno = saved_errno;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_wait
+ * [DESCRIPTION]:	This Function is used to wait on the host clock while running the models,
+ * 					the host sleeps between the polls of a long wait. On the simulated clock
+ * 					the models are run up to the end of the wait without sleeping
+ * [ARGS]:		uint64 cycles :	This Arg shall indicate the time in CPU cycles
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_wait(uint64 cycles)
+{
+	uint64 end = HOST_clockNow() + cycles;
+	uint64 now;
+	uint64 left;
+	struct timespec sleep;
+
+	if(g_HOST_clockType != HOST_CLOCK_WALL)
+	{
+		/* In an ISR or a model the time is taken at the next sync */
+		g_HOST_depth++;
+		if(g_HOST_depth == 1)
+		{
+			HOST_run(g_HOST_clock + cycles);
+		}
+		else
+		{
+			g_HOST_clock += cycles;
+		}
+		g_HOST_depth--;
+		return;
+	}
+
+	for(;;)
+	{
+		HOST_poll();
+		now = HOST_clockNow();
+		if(now >= end)
+		{
+			break;
+		}
+
+		left = ((end - now) * 1000000ULL) / F_CPU;
+		if(left > HOST_WAIT_SLEEP_TIME)
+		{
+			left = HOST_WAIT_SLEEP_TIME;
+		}
+		sleep.tv_sec = 0;
+		sleep.tv_nsec = (long)(left * 1000);
+		nanosleep(&sleep, NULL_PTR);
+	}
+}
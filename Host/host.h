@@ -0,0 +1,342 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<host.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the host HAL that runs mC1 and mC2 on Linux>
+ ---------------------------------------------------------------------------*/
+
+#ifndef HOST_H_
+#define HOST_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/*
+ * The registers are kept in an array indexed by their address in the data
+ * space of the ATmega16 (I/O address + 0x20). The <avr/io.h> of the host maps
+ * each register name on HOST_access, which gives the models a hook on every
+ * access of the firmware. A write is seen as a change of the register at the
+ * next access or tick, so a write that leaves a register unchanged is not seen.
+ */
+#define HOST_REG_SIZE			0x60
+
+#define HOST_TWBR				0x20
+#define HOST_TWSR				0x21
+#define HOST_TWAR				0x22
+#define HOST_TWDR				0x23
+#define HOST_ADCL				0x24
+#define HOST_ADCH				0x25
+#define HOST_ADCSRA				0x26
+#define HOST_ADMUX				0x27
+#define HOST_UBRRL				0x29
+#define HOST_UCSRB				0x2A
+#define HOST_UCSRA				0x2B
+#define HOST_UDR				0x2C
+#define HOST_PIND				0x30
+#define HOST_DDRD				0x31
+#define HOST_PORTD				0x32
+#define HOST_PINC				0x33
+#define HOST_DDRC				0x34
+#define HOST_PORTC				0x35
+#define HOST_PINB				0x36
+#define HOST_DDRB				0x37
+#define HOST_PORTB				0x38
+#define HOST_PINA				0x39
+#define HOST_DDRA				0x3A
+#define HOST_PORTA				0x3B
+#define HOST_UBRRH				0x40	/* UCSRC when written with URSEL */
+#define HOST_OCR2				0x43
+#define HOST_TCNT2				0x44
+#define HOST_TCCR2				0x45
+#define HOST_ICR1L				0x46
+#define HOST_ICR1H				0x47
+#define HOST_OCR1BL				0x48
+#define HOST_OCR1BH				0x49
+#define HOST_OCR1AL				0x4A
+#define HOST_OCR1AH				0x4B
+#define HOST_TCNT1L				0x4C
+#define HOST_TCNT1H				0x4D
+#define HOST_TCCR1B				0x4E
+#define HOST_TCCR1A				0x4F
+#define HOST_SFIOR				0x50
+#define HOST_TCNT0				0x52
+#define HOST_TCCR0				0x53
+#define HOST_MCUCSR				0x54
+#define HOST_MCUCR				0x55
+#define HOST_TWCR				0x56
+#define HOST_TIFR				0x58
+#define HOST_TIMSK				0x59
+#define HOST_GIFR				0x5A
+#define HOST_GICR				0x5B
+#define HOST_OCR0				0x5C
+#define HOST_SREG				0x5F
+
+/* Interrupt vectors of the ATmega16, the number is also the priority */
+#define HOST_INT0_VECT			1
+#define HOST_INT1_VECT			2
+#define HOST_TIMER2_COMP_VECT	3
+#define HOST_TIMER2_OVF_VECT	4
+#define HOST_TIMER1_CAPT_VECT	5
+#define HOST_TIMER1_COMPA_VECT	6
+#define HOST_TIMER1_COMPB_VECT	7
+#define HOST_TIMER1_OVF_VECT	8
+#define HOST_TIMER0_OVF_VECT	9
+#define HOST_USART_RXC_VECT		11
+#define HOST_USART_UDRE_VECT	12
+#define HOST_USART_TXC_VECT		13
+#define HOST_ADC_VECT			14
+#define HOST_INT2_VECT			18
+#define HOST_TIMER0_COMP_VECT	19
+#define HOST_NUM_OF_VECTORS		21
+#define HOST_NO_VECT			0
+
+#define HOST_NEVER				0xFFFFFFFFFFFFFFFFULL	/* Cycle of a model without events */
+#define HOST_TICK_TIME			1000	/* Period in us of the host tick that runs the
+										 * models while the firmware is in a loop that
+										 * does not access a register */
+
+/* Ports of the GPIO model */
+#define HOST_PORTA_ID			0
+#define HOST_PORTB_ID			1
+#define HOST_PORTC_ID			2
+#define HOST_PORTD_ID			3
+#define HOST_NO_PIN				0xFF
+
+/*
+ * The control channel is a socket or a pair of FIFOs given by HOST_CONTROL, it
+ * carries text lines. The harness sends commands as "press 1234E" and the models
+ * report events as "<cycles> lcd 0 Enter New Pass:".
+ */
+#define HOST_CONTROL_POLL_TIME	1000	/* Period in us of the reads of the commands */
+
+/*
+ * HOST_CLOCK selects the time of the models. "wall" follows the host clock and
+ * the delays sleep. "virtual" is a simulated clock: the delays, the accesses and
+ * the ISRs advance it, and a polling loop jumps to the next event of the models.
+ * "lockstep" is the simulated clock advanced only in the windows granted by the
+ * "run <cycle>" command, the process reports "wait" at the end of each window.
+ */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* Called at each access of the firmware to a register, before the access. It may
+ * return another byte for the access to use, else NULL_PTR */
+typedef volatile uint8 *(*HOST_ReadHookType)(uint8 address);
+
+/* Called when the firmware changed a register */
+typedef void (*HOST_WriteHookType)(uint8 address, uint8 old_value, uint8 new_value);
+
+/* A peripheral model, the events of all the models are run in the order of their cycles */
+typedef struct
+{
+	void (*init)(void);			/* Sets the hooks and the reset state of the model */
+	void (*sync)(void);			/* Called at each sync before the events, NULL_PTR for none */
+	uint64 (*next)(void);		/* Cycle of the next event, HOST_NEVER for none */
+	void (*event)(void);		/* Runs the event due at HOST_cycles() */
+}HOST_ModelType;
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used by the firmware registers of <avr/io.h>, it runs the
+ * models up to now and returns the byte of the register
+ */
+volatile uint8 *HOST_access(uint8 address);
+
+
+/*
+ * Description:
+ * This Function is used to run the models and the interrupts up to now, it is
+ * called by the delays and may be called by a test between two steps
+ */
+void HOST_poll(void);
+
+
+/*
+ * Description:
+ * This Function is used to read the current time in CPU cycles of F_CPU
+ */
+uint64 HOST_cycles(void);
+
+
+/*
+ * Description:
+ * This Function is used to convert a time in microseconds to CPU cycles
+ */
+uint64 HOST_usToCycles(uint32 usec);
+
+
+/*
+ * Description:
+ * This Function is used by the models to read a register without running any
+ * hook
+ */
+uint8 HOST_getReg(uint8 address);
+
+
+/*
+ * Description:
+ * This Function is used by the models to change a register, the change is not
+ * seen as a write of the firmware
+ */
+void HOST_setReg(uint8 address, uint8 value);
+
+
+/*
+ * Description:
+ * This Function is used by the models to set or clear bits of a register, the
+ * change is not seen as a write of the firmware
+ */
+void HOST_changeBits(uint8 address, uint8 mask, boolean level);
+
+
+/*
+ * Description:
+ * This Function is used by the models to set the hooks of a register
+ */
+void HOST_setHooks(uint8 address, HOST_ReadHookType a_readHook, HOST_WriteHookType a_writeHook);
+
+
+/*
+ * Description:
+ * This Function is used by a read hook of a register that changes with the time,
+ * as a count of a timer. A loop on it waits for a value and not for an event of
+ * the models, so it is not moved up to the next event as a polling loop
+ */
+void HOST_busy(void);
+
+
+/*
+ * Description:
+ * This Function is used to get the vector of the running ISR, HOST_NO_VECT when
+ * the firmware is not in an ISR
+ */
+uint8 HOST_currentVector(void);
+
+
+/*
+ * Description:
+ * This Function is used to get if the models are run from the host tick, the
+ * firmware may then be in the middle of a statement
+ */
+boolean HOST_inTick(void);
+
+
+/*
+ * Description:
+ * This Function is used to get the value of a configuration variable of the
+ * environment, or the default value if it is not set
+ */
+const char *HOST_getConfig(const char *a_name, const char *a_default);
+
+
+/*
+ * Description:
+ * This Function is used to drive a pin from outside of the MCU, the edges of
+ * the external interrupt and input capture pins are detected
+ */
+void HOST_setPin(uint8 port, uint8 pin, uint8 level);
+
+
+/*
+ * Description:
+ * This Function is used to stop driving a pin from outside of the MCU
+ */
+void HOST_releasePin(uint8 port, uint8 pin);
+
+
+/*
+ * Description:
+ * This Function is used to set a function that gives the levels of the input
+ * pins of a port from its DDR and PORT, as a keypad that connects its pins
+ */
+void HOST_setInputHook(uint8 port, uint8 (*a_hook)(uint8 port, uint8 ddr, uint8 levels));
+
+
+/*
+ * Description:
+ * This Function is used to add a function called when the firmware changes the
+ * PORT or DDR register of a port, as an LCD that decodes the pins. Two devices
+ * may share a port
+ */
+void HOST_setOutputHook(uint8 port, void (*a_hook)(uint8 port, uint8 ddr, uint8 levels));
+
+
+/*
+ * Description:
+ * This Function is used to set the 10-bit result of the conversions of an ADC
+ * channel
+ */
+void HOST_setAdc(uint8 channel, uint16 value);
+
+
+/*
+ * Description:
+ * This Function is used by the models to read the count of a timer (0, 1 or 2)
+ * at HOST_cycles(), as the input capture of timer 1
+ */
+uint16 HOST_timerCount(uint8 timer);
+
+
+/*
+ * Description:
+ * This Function is used to send an event line to the harness on the control
+ * channel, the line starts with HOST_cycles()
+ */
+void HOST_report(const char *a_format, ...) __attribute__((format(printf, 1, 2)));
+
+
+/*
+ * Description:
+ * This Function is used to set the handler of a command line received on the
+ * control channel, the handler gets the arguments after the name
+ */
+void HOST_setCommand(const char *a_name, void (*a_handler)(const char *a_args));
+
+
+/*
+ * Description:
+ * This Function is used by the core in the lockstep to get the end of the
+ * window granted by the harness, it waits for a new window at its end
+ */
+uint64 HOST_controlGrant(uint64 now);
+
+
+/*
+ * Description:
+ * This Function is used to connect an HD44780 LCD in the 8-bit mode, its RW pin
+ * may be HOST_NO_PIN
+ */
+void HOST_lcdAttach(uint8 control_port, uint8 rs_pin, uint8 rw_pin, uint8 e_pin, uint8 data_port);
+
+
+/*
+ * Description:
+ * This Function is used to connect a 4x4 keypad, the rows are inputs and the
+ * columns are driven low one at a time
+ */
+void HOST_keypadAttach(uint8 port, uint8 first_row_pin, uint8 first_col_pin);
+
+
+/*
+ * Description:
+ * This Function is used to connect a door driven by the H-bridge inputs of a
+ * motor, its limit switches are pressed low at the ends of the travel
+ */
+void HOST_doorAttach(uint8 motor_port, uint8 in1_pin, uint8 in2_pin, uint8 switch_port, uint8 closed_pin, uint8 open_pin);
+
+
+/*
+ * Description:
+ * This Function is used to connect the receiver of the trace to the TX pin of
+ * the software UART of the firmware, the bytes are written to HOST_TRACE
+ */
+void HOST_traceAttach(uint8 port, uint8 pin, uint32 baud);
+
+#endif /* HOST_H_ */
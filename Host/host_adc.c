@@ -0,0 +1,184 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_adc.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of the ADC of the host HAL>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <stdlib.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+/* The bits of ADCSRA, ADMUX and SFIOR */
+#define HOST_ADEN				0x80
+#define HOST_ADSC				0x40
+#define HOST_ADATE				0x20
+#define HOST_ADIF				0x10
+#define HOST_ADLAR				0x20
+#define HOST_ADTS				0xE0
+
+#define HOST_ADC_CHANNELS		8
+#define HOST_ADC_CLOCKS			13		/* ADC clocks of a conversion */
+#define HOST_ADC_FIRST_CLOCKS	25		/* ADC clocks of the first conversion after ADEN */
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static uint16 g_HOST_adcValues[HOST_ADC_CHANNELS];
+static uint64 g_HOST_adcEnd = HOST_NEVER;		/* End of the running conversion */
+static uint8 g_HOST_adcChannel;					/* Channel latched at the start */
+static boolean g_HOST_adcFirst = TRUE;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_adcInit(void);
+static uint64 HOST_adcNext(void);
+static void HOST_adcEvent(void);
+static void HOST_adcWrite(uint8 address, uint8 old_value, uint8 new_value);
+static void HOST_adcStart(void);
+static void HOST_adcCommand(const char *a_args);
+
+const HOST_ModelType g_HOST_adcModel = {HOST_adcInit, NULL_PTR, HOST_adcNext, HOST_adcEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_setAdc
+ * [DESCRIPTION]:	This Function is used to set the result of the conversions of a channel
+ * [ARGS]:		uint8 channel :	This Arg shall indicate the channel 0 to 7
+ * 				uint16 value :	This Arg shall indicate the 10-bit result
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_setAdc(uint8 channel, uint16 value)
+{
+	if(channel < HOST_ADC_CHANNELS)
+	{
+		g_HOST_adcValues[channel] = value & 0x03FF;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_adcInit
+ * [DESCRIPTION]:	This Function is used to set the hooks and the command of the ADC
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_adcInit(void)
+{
+	HOST_setHooks(HOST_ADCSRA, NULL_PTR, HOST_adcWrite);
+	HOST_setCommand("adc", HOST_adcCommand);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_adcNext
+ * [DESCRIPTION]:	This Function is used to get the cycle of the end of the conversion
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_adcNext(void)
+{
+	return g_HOST_adcEnd;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_adcEvent
+ * [DESCRIPTION]:	This Function is used to end the conversion, the result is loaded and
+ * 					ADIF is set. In the free running mode the next conversion starts at once
+ * 					on the channel of ADMUX
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_adcEvent(void)
+{
+	uint16 result = g_HOST_adcValues[g_HOST_adcChannel];
+
+	if(HOST_getReg(HOST_ADMUX) & HOST_ADLAR)
+	{
+		result <<= 6;
+	}
+	HOST_setReg(HOST_ADCL, (uint8)result);
+	HOST_setReg(HOST_ADCH, (uint8)(result >> 8));
+	HOST_changeBits(HOST_ADCSRA, HOST_ADIF, TRUE);
+
+	g_HOST_adcEnd = HOST_NEVER;
+	if((HOST_getReg(HOST_ADCSRA) & HOST_ADATE) && ((HOST_getReg(HOST_SFIOR) & HOST_ADTS) == 0))
+	{
+		HOST_adcStart();
+	}
+	else
+	{
+		HOST_changeBits(HOST_ADCSRA, HOST_ADSC, FALSE);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_adcWrite
+ * [DESCRIPTION]:	This Function is the write hook of ADCSRA. ADIF is cleared by writing
+ * 					one to it, ADSC starts a conversion and clearing ADEN stops it
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the value before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_adcWrite(uint8 address, uint8 old_value, uint8 new_value)
+{
+	uint8 value = new_value & (uint8)~(HOST_ADIF | HOST_ADSC);
+
+	if((old_value & HOST_ADIF) && ((new_value & HOST_ADIF) == 0))
+	{
+		value |= HOST_ADIF;
+	}
+	HOST_setReg(address, value | (old_value & HOST_ADSC));
+
+	if((new_value & HOST_ADEN) == 0)
+	{
+		g_HOST_adcEnd = HOST_NEVER;
+		g_HOST_adcFirst = TRUE;
+		HOST_changeBits(address, HOST_ADSC, FALSE);
+	}
+	else if((new_value & HOST_ADSC) && (g_HOST_adcEnd == HOST_NEVER))
+	{
+		HOST_adcStart();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_adcStart
+ * [DESCRIPTION]:	This Function is used to start a conversion on the channel of ADMUX,
+ * 					the ADC clock is F_CPU divided by the prescaler of ADPS
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_adcStart(void)
+{
+	uint8 prescaler = (uint8)1 << (HOST_getReg(HOST_ADCSRA) & 0x07);
+
+	if(prescaler == 1)
+	{
+		prescaler = 2;
+	}
+
+	g_HOST_adcChannel = HOST_getReg(HOST_ADMUX) & (HOST_ADC_CHANNELS - 1);
+	g_HOST_adcEnd = HOST_cycles() + ((uint64)prescaler * ((g_HOST_adcFirst == TRUE) ? HOST_ADC_FIRST_CLOCKS : HOST_ADC_CLOCKS));
+	g_HOST_adcFirst = FALSE;
+	HOST_changeBits(HOST_ADCSRA, HOST_ADSC, TRUE);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_adcCommand
+ * [DESCRIPTION]:	This Function is the handler of the "adc <channel> <value>" command
+ * [ARGS]:		const char *a_args :	This Arg shall indicate the channel and the result
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_adcCommand(const char *a_args)
+{
+	char *value;
+	unsigned long channel = strtoul(a_args, &value, 10);
+
+	HOST_setAdc((uint8)channel, (uint16)strtoul(value, NULL_PTR, 10));
+}
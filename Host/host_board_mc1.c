@@ -0,0 +1,39 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_board_mc1.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the board of mC1 in the host HAL: the LCD, the
+ * 					keypad and the receiver of the trace on the pins of the firmware
+ * 					configuration>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+#include "gpio.h"
+#include "lcd.h"
+#include "keypad.h"
+#include "trace.h"
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_boardInit(void);
+
+const HOST_ModelType g_HOST_boardModel = {HOST_boardInit, NULL_PTR, NULL_PTR, NULL_PTR};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_boardInit
+ * [DESCRIPTION]:	This Function is used to connect the devices of mC1
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_boardInit(void)
+{
+	HOST_lcdAttach(LCD_PORT, LCD_RS_PIN, LCD_RW_PIN, LCD_E_PIN, LCD_DB_PORT);
+	HOST_keypadAttach(KEYPAD_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID, KEYPAD_FIRST_COL_PIN_ID);
+	HOST_traceAttach(TRACE_PORT_ID, TRACE_PIN_ID, TRACE_BAUD);
+}
@@ -0,0 +1,39 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_board_mc2.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the board of mC2 in the host HAL: the door moved by
+ * 					the motor between the limit switches and the receiver of the trace on the
+ * 					pins of the firmware configuration>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+#include "gpio.h"
+#include "dcmotor.h"
+#include "position.h"
+#include "trace.h"
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_boardInit(void);
+
+const HOST_ModelType g_HOST_boardModel = {HOST_boardInit, NULL_PTR, NULL_PTR, NULL_PTR};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_boardInit
+ * [DESCRIPTION]:	This Function is used to connect the devices of mC2, the current
+ * 					sense of the motor is set by the "adc" command
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_boardInit(void)
+{
+	HOST_doorAttach(IN1_PORT_ID, IN1_PIN_ID, IN2_PIN_ID, POSITION_CLOSED_PORT_ID, POSITION_CLOSED_PIN_ID, POSITION_OPEN_PIN_ID);
+	HOST_traceAttach(TRACE_PORT_ID, TRACE_PIN_ID, TRACE_BAUD);
+}
@@ -0,0 +1,287 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_control.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the control channel of the host HAL, a harness sends
+ * 					commands to the models and reads their events on it>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_CONTROL_LINE_SIZE	128
+#define HOST_CONTROL_COMMANDS	8
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef struct
+{
+	const char *name;
+	void (*handler)(const char *a_args);
+}HOST_CommandType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static int g_HOST_control = -1;
+static uint64 g_HOST_controlNext = HOST_NEVER;	/* Next read of the commands */
+
+/* In the lockstep the commands are read while waiting for the next window */
+static boolean g_HOST_controlLockstep = FALSE;
+static uint64 g_HOST_controlGranted = 0;		/* End of the window granted by the harness */
+
+static char g_HOST_controlLine[HOST_CONTROL_LINE_SIZE];
+static uint8 g_HOST_controlSize = 0;
+
+static HOST_CommandType g_HOST_commands[HOST_CONTROL_COMMANDS];
+static uint8 g_HOST_numOfCommands = 0;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_controlInit(void);
+static uint64 HOST_controlNext(void);
+static void HOST_controlEvent(void);
+static void HOST_controlRead(void);
+static void HOST_controlRun(char *a_line);
+static void HOST_controlWindow(const char *a_args);
+
+const HOST_ModelType g_HOST_controlModel = {HOST_controlInit, NULL_PTR, HOST_controlNext, HOST_controlEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_report
+ * [DESCRIPTION]:	This Function is used to send an event line to the harness, the line
+ * 					starts with the cycle of the event. Nothing is sent without a channel
+ * [ARGS]:		const char *a_format :	This Arg shall indicate the printf format of the event
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_report(const char *a_format, ...)
+{
+	char line[HOST_CONTROL_LINE_SIZE];
+	va_list args;
+	int size;
+
+	if(g_HOST_control < 0)
+	{
+		return;
+	}
+
+	size = snprintf(line, sizeof(line), "%llu ", (unsigned long long)HOST_cycles());
+	va_start(args, a_format);
+	size += vsnprintf(line + size, sizeof(line) - size - 1, a_format, args);
+	va_end(args);
+	if(size > (int)sizeof(line) - 2)
+	{
+		size = sizeof(line) - 2;
+	}
+	line[size++] = '\n';
+
+	if(write(g_HOST_control, line, size) < 0)
+	{
+		/* The harness is gone, the process goes on without it */
+		g_HOST_control = -1;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_setCommand
+ * [DESCRIPTION]:	This Function is used by the models to set the handler of a command
+ * [ARGS]:		const char *a_name :	This Arg shall indicate the first word of the line
+ * 				a_handler :				This Arg shall indicate the function that gets the
+ * 										rest of the line
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_setCommand(const char *a_name, void (*a_handler)(const char *a_args))
+{
+	if(g_HOST_numOfCommands < HOST_CONTROL_COMMANDS)
+	{
+		g_HOST_commands[g_HOST_numOfCommands].name = a_name;
+		g_HOST_commands[g_HOST_numOfCommands].handler = a_handler;
+		g_HOST_numOfCommands++;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_controlGrant
+ * [DESCRIPTION]:	This Function is used to get the end of the window granted by the
+ * 					harness. At the end of the window "wait" is reported and the commands
+ * 					are run until the "run" command grants a new window
+ * [ARGS]:		uint64 now :	This Arg shall indicate the cycle of the simulated clock
+ * [RETURNS]:	The end of the window, HOST_NEVER without a harness
+ ----------------------------------------------------------------------------------------*/
+uint64 HOST_controlGrant(uint64 now)
+{
+	struct pollfd channel;
+
+	if(g_HOST_control < 0)
+	{
+		return HOST_NEVER;
+	}
+
+	while(g_HOST_controlGranted <= now)
+	{
+		HOST_report("wait");
+		channel.fd = g_HOST_control;
+		channel.events = POLLIN;
+		while((poll(&channel, 1, -1) < 0) && (errno == EINTR))
+		{
+		}
+		HOST_controlRead();
+	}
+
+	return g_HOST_controlGranted;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_controlInit
+ * [DESCRIPTION]:	This Function is used to open the channel of HOST_CONTROL, a file
+ * 					descriptor number or the path of a FIFO, then report that the process
+ * 					is ready. There is no channel when it is not set. The commands are read
+ * 					every HOST_CONTROL_POLL_TIME, or at the end of each window in the lockstep
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_controlInit(void)
+{
+	const char *config = HOST_getConfig("HOST_CONTROL", NULL_PTR);
+	const char *digit = config;
+
+	if(config == NULL_PTR)
+	{
+		return;
+	}
+
+	while(isdigit((unsigned char)*digit))
+	{
+		digit++;
+	}
+	g_HOST_control = (*digit == '\0') ? atoi(config) : open(config, O_RDWR);
+	if(g_HOST_control < 0)
+	{
+		return;
+	}
+
+	fcntl(g_HOST_control, F_SETFL, fcntl(g_HOST_control, F_GETFL) | O_NONBLOCK);
+	if(strcmp(HOST_getConfig("HOST_CLOCK", "wall"), "lockstep") == 0)
+	{
+		g_HOST_controlLockstep = TRUE;
+		HOST_setCommand("run", HOST_controlWindow);
+	}
+	else
+	{
+		g_HOST_controlNext = 0;
+	}
+	HOST_report("ready");
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_controlNext
+ * [DESCRIPTION]:	This Function is used to get the cycle of the next read of the commands
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_controlNext(void)
+{
+	return ((g_HOST_control >= 0) && (g_HOST_controlLockstep == FALSE)) ? g_HOST_controlNext : HOST_NEVER;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_controlEvent
+ * [DESCRIPTION]:	This Function is used to read the commands periodically
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_controlEvent(void)
+{
+	g_HOST_controlNext = HOST_cycles() + HOST_usToCycles(HOST_CONTROL_POLL_TIME);
+	HOST_controlRead();
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_controlRead
+ * [DESCRIPTION]:	This Function is used to read the channel and run each complete line,
+ * 					the process ends when the harness closes the channel
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_controlRead(void)
+{
+	char input[HOST_CONTROL_LINE_SIZE];
+	ssize_t size;
+	ssize_t i;
+
+	size = read(g_HOST_control, input, sizeof(input));
+	if(size == 0)
+	{
+		/* The harness closed the channel */
+		if(HOST_inTick() == TRUE)
+		{
+			_exit(0);
+		}
+		exit(0);
+	}
+
+	for(i = 0; i < size; i++)
+	{
+		if(input[i] == '\n')
+		{
+			g_HOST_controlLine[g_HOST_controlSize] = '\0';
+			g_HOST_controlSize = 0;
+			HOST_controlRun(g_HOST_controlLine);
+		}
+		else if(g_HOST_controlSize < (HOST_CONTROL_LINE_SIZE - 1))
+		{
+			g_HOST_controlLine[g_HOST_controlSize++] = input[i];
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_controlRun
+ * [DESCRIPTION]:	This Function is used to run the handler of a command line, an unknown
+ * 					command is reported back
+ * [ARGS]:		char *a_line :	This Arg shall indicate the line
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_controlRun(char *a_line)
+{
+	size_t length = strcspn(a_line, " ");
+	uint8 i;
+
+	for(i = 0; i < g_HOST_numOfCommands; i++)
+	{
+		if((strlen(g_HOST_commands[i].name) == length) && (strncmp(g_HOST_commands[i].name, a_line, length) == 0))
+		{
+			(*g_HOST_commands[i].handler)(a_line + length + strspn(a_line + length, " "));
+			return;
+		}
+	}
+
+	HOST_report("error %s", a_line);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_controlWindow
+ * [DESCRIPTION]:	This Function is the handler of the "run <cycle>" command of the lockstep
+ * [ARGS]:		const char *a_args :	This Arg shall indicate the end of the window
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_controlWindow(const char *a_args)
+{
+	g_HOST_controlGranted = strtoull(a_args, NULL_PTR, 10);
+}
@@ -0,0 +1,170 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_door.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of the door of the host HAL, the motor moves
+ * 					it between the closed and the open limit switches>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <stdlib.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_DOOR_TRAVEL_TIME	"12000"	/* Default time in ms from closed to open */
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static uint8 g_HOST_doorMotorPort;
+static uint8 g_HOST_doorIn1;
+static uint8 g_HOST_doorIn2;
+static uint8 g_HOST_doorSwitchPort;
+static uint8 g_HOST_doorClosedPin;
+static uint8 g_HOST_doorOpenPin;
+
+/* The position is the time of travel in cycles from the closed end */
+static uint64 g_HOST_doorTravel;
+static uint64 g_HOST_doorPosition = 0;
+static sint8 g_HOST_doorDirection = 0;		/* 1 opening, -1 closing, 0 stopped */
+static uint64 g_HOST_doorSince = 0;			/* Cycle of the last update of the position */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static uint64 HOST_doorNext(void);
+static void HOST_doorEvent(void);
+static void HOST_doorMotor(uint8 port, uint8 ddr, uint8 levels);
+static void HOST_doorUpdate(void);
+static void HOST_doorSwitches(void);
+
+const HOST_ModelType g_HOST_doorModel = {NULL_PTR, NULL_PTR, HOST_doorNext, HOST_doorEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_doorAttach
+ * [DESCRIPTION]:	This Function is used to connect the door to the pins of the firmware,
+ * 					it starts closed. HOST_DOOR_TIME is its travel time in ms
+ * [ARGS]:		uint8 motor_port :	This Arg shall indicate the port of IN1 and IN2
+ * 				uint8 in1_pin :		This Arg shall indicate the pin of IN1, high to open
+ * 				uint8 in2_pin :		This Arg shall indicate the pin of IN2, high to close
+ * 				uint8 switch_port :	This Arg shall indicate the port of the limit switches
+ * 				uint8 closed_pin :	This Arg shall indicate the pin of the closed switch
+ * 				uint8 open_pin :	This Arg shall indicate the pin of the open switch
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_doorAttach(uint8 motor_port, uint8 in1_pin, uint8 in2_pin, uint8 switch_port, uint8 closed_pin, uint8 open_pin)
+{
+	g_HOST_doorMotorPort = motor_port;
+	g_HOST_doorIn1 = in1_pin;
+	g_HOST_doorIn2 = in2_pin;
+	g_HOST_doorSwitchPort = switch_port;
+	g_HOST_doorClosedPin = closed_pin;
+	g_HOST_doorOpenPin = open_pin;
+	g_HOST_doorTravel = HOST_usToCycles(1000) * strtoul(HOST_getConfig("HOST_DOOR_TIME", HOST_DOOR_TRAVEL_TIME), NULL_PTR, 10);
+
+	HOST_setOutputHook(motor_port, HOST_doorMotor);
+	HOST_doorSwitches();
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_doorNext
+ * [DESCRIPTION]:	This Function is used to get the cycle the moving door reaches its end
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_doorNext(void)
+{
+	if((g_HOST_doorDirection > 0) && (g_HOST_doorPosition < g_HOST_doorTravel))
+	{
+		return g_HOST_doorSince + (g_HOST_doorTravel - g_HOST_doorPosition);
+	}
+	if((g_HOST_doorDirection < 0) && (g_HOST_doorPosition > 0))
+	{
+		return g_HOST_doorSince + g_HOST_doorPosition;
+	}
+
+	return HOST_NEVER;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_doorEvent
+ * [DESCRIPTION]:	This Function is used to stop the door at its end and press the switch
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_doorEvent(void)
+{
+	HOST_doorUpdate();
+	HOST_doorSwitches();
+	HOST_report("door %s", (g_HOST_doorPosition == 0) ? "closed" : "open");
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_doorMotor
+ * [DESCRIPTION]:	This Function is the output hook of the port of the motor, IN1 high
+ * 					opens the door, IN2 high closes it and equal levels stop it. The speed
+ * 					does not follow the duty cycle of the PWM
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				uint8 ddr :		This Arg shall indicate its DDR
+ * 				uint8 levels :	This Arg shall indicate its output levels
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_doorMotor(uint8 port, uint8 ddr, uint8 levels)
+{
+	uint8 in1 = ((levels & ddr) >> g_HOST_doorIn1) & 0x01;
+	uint8 in2 = ((levels & ddr) >> g_HOST_doorIn2) & 0x01;
+	sint8 direction = (sint8)in1 - (sint8)in2;
+
+	if(port != g_HOST_doorMotorPort)
+	{
+		return;
+	}
+
+	HOST_doorUpdate();
+	if(direction != g_HOST_doorDirection)
+	{
+		g_HOST_doorDirection = direction;
+		HOST_report("door %s", (direction > 0) ? "opening" : ((direction < 0) ? "closing" : "stopped"));
+		HOST_doorSwitches();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_doorUpdate
+ * [DESCRIPTION]:	This Function is used to move the door up to now
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_doorUpdate(void)
+{
+	uint64 now = HOST_cycles();
+	uint64 moved = now - g_HOST_doorSince;
+
+	if(g_HOST_doorDirection > 0)
+	{
+		g_HOST_doorPosition = ((g_HOST_doorTravel - g_HOST_doorPosition) > moved) ? (g_HOST_doorPosition + moved) : g_HOST_doorTravel;
+	}
+	else if(g_HOST_doorDirection < 0)
+	{
+		g_HOST_doorPosition = (g_HOST_doorPosition > moved) ? (g_HOST_doorPosition - moved) : 0;
+	}
+	g_HOST_doorSince = now;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_doorSwitches
+ * [DESCRIPTION]:	This Function is used to drive the limit switches, a pressed switch
+ * 					connects its pin to ground and a released one leaves it high
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_doorSwitches(void)
+{
+	HOST_setPin(g_HOST_doorSwitchPort, g_HOST_doorClosedPin, (g_HOST_doorPosition == 0) ? LOGIC_LOW : LOGIC_HIGH);
+	HOST_setPin(g_HOST_doorSwitchPort, g_HOST_doorOpenPin, (g_HOST_doorPosition == g_HOST_doorTravel) ? LOGIC_LOW : LOGIC_HIGH);
+}
@@ -0,0 +1,201 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_eeprom.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the internal EEPROM of the host HAL, the EEMEM
+ * 					variables are kept in a file of the host>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <util/delay.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_EEPROM_WRITE_TIME	8500	/* Time in us of the write of a byte, 8448 cycles of the RC */
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* The EEMEM variables are put in the section host_eeprom by <avr/eeprom.h> */
+extern uint8 __start_host_eeprom[] __attribute__((weak));
+extern uint8 __stop_host_eeprom[] __attribute__((weak));
+
+static int g_HOST_avrEepromFile = -1;
+static uint64 g_HOST_eepromBusy = 0;	/* End of the write of the last byte */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_eepromInit(void);
+static void HOST_eepromWrite(uint8 *a_addressPtr, const uint8 *a_dataPtr, uint16 size);
+static void HOST_eepromReady(void);
+
+const HOST_ModelType g_HOST_eepromModel = {HOST_eepromInit, NULL_PTR, NULL_PTR, NULL_PTR};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	eeprom_read_byte
+ * [DESCRIPTION]:	This Function replaces the one of <avr/eeprom.h>
+ * [ARGS]:		const uint8 *a_addressPtr :	This Arg shall indicate the EEMEM byte
+ * [RETURNS]:	The byte
+ ----------------------------------------------------------------------------------------*/
+uint8 eeprom_read_byte(const uint8 *a_addressPtr)
+{
+	HOST_eepromReady();
+
+	return *a_addressPtr;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	eeprom_read_word
+ * [DESCRIPTION]:	This Function replaces the one of <avr/eeprom.h>
+ * [ARGS]:		const uint16 *a_addressPtr :	This Arg shall indicate the EEMEM word
+ * [RETURNS]:	The word
+ ----------------------------------------------------------------------------------------*/
+uint16 eeprom_read_word(const uint16 *a_addressPtr)
+{
+	uint16 word;
+
+	HOST_eepromReady();
+	memcpy(&word, a_addressPtr, sizeof(word));
+
+	return word;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	eeprom_read_block
+ * [DESCRIPTION]:	This Function replaces the one of <avr/eeprom.h>
+ * [ARGS]:		void *a_dataPtr :			This Arg shall indicate where to put the bytes
+ * 				const void *a_addressPtr :	This Arg shall indicate the EEMEM bytes
+ * 				size_t size :				This Arg shall indicate the number of bytes
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void eeprom_read_block(void *a_dataPtr, const void *a_addressPtr, size_t size)
+{
+	HOST_eepromReady();
+	memcpy(a_dataPtr, a_addressPtr, size);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	eeprom_update_byte
+ * [DESCRIPTION]:	This Function replaces the one of <avr/eeprom.h>
+ * [ARGS]:		uint8 *a_addressPtr :	This Arg shall indicate the EEMEM byte
+ * 				uint8 value :			This Arg shall indicate the byte to write
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void eeprom_update_byte(uint8 *a_addressPtr, uint8 value)
+{
+	HOST_eepromWrite(a_addressPtr, &value, sizeof(value));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	eeprom_update_word
+ * [DESCRIPTION]:	This Function replaces the one of <avr/eeprom.h>
+ * [ARGS]:		uint16 *a_addressPtr :	This Arg shall indicate the EEMEM word
+ * 				uint16 value :			This Arg shall indicate the word to write
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void eeprom_update_word(uint16 *a_addressPtr, uint16 value)
+{
+	HOST_eepromWrite((uint8 *)a_addressPtr, (const uint8 *)&value, sizeof(value));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	eeprom_update_block
+ * [DESCRIPTION]:	This Function replaces the one of <avr/eeprom.h>
+ * [ARGS]:		const void *a_dataPtr :	This Arg shall indicate the bytes to write
+ * 				void *a_addressPtr :	This Arg shall indicate the EEMEM bytes
+ * 				size_t size :			This Arg shall indicate the number of bytes
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void eeprom_update_block(const void *a_dataPtr, void *a_addressPtr, size_t size)
+{
+	HOST_eepromWrite((uint8 *)a_addressPtr, (const uint8 *)a_dataPtr, (uint16)size);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_eepromInit
+ * [DESCRIPTION]:	This Function is used to erase the EEMEM variables, then to load them
+ * 					from HOST_AVR_EEPROM when it is set
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_eepromInit(void)
+{
+	const char *path = HOST_getConfig("HOST_AVR_EEPROM", NULL_PTR);
+	size_t size = __stop_host_eeprom - __start_host_eeprom;
+
+	if(size == 0)
+	{
+		return;
+	}
+
+	memset(__start_host_eeprom, 0xFF, size);
+	if(path != NULL_PTR)
+	{
+		g_HOST_avrEepromFile = open(path, O_RDWR | O_CREAT, 0644);
+		if((g_HOST_avrEepromFile >= 0) && (pread(g_HOST_avrEepromFile, __start_host_eeprom, size, 0) < (ssize_t)size))
+		{
+			memset(__start_host_eeprom, 0xFF, size);
+			pwrite(g_HOST_avrEepromFile, __start_host_eeprom, size, 0);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_eepromWrite
+ * [DESCRIPTION]:	This Function is used to write the changed EEMEM bytes and their file.
+ * 					As on the chip each changed byte waits for the write of the one before
+ * 					it, the last write goes on after the return
+ * [ARGS]:		uint8 *a_addressPtr :		This Arg shall indicate the EEMEM bytes
+ * 				const uint8 *a_dataPtr :	This Arg shall indicate the bytes to write
+ * 				uint16 size :				This Arg shall indicate the number of bytes
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_eepromWrite(uint8 *a_addressPtr, const uint8 *a_dataPtr, uint16 size)
+{
+	uint16 i;
+
+	if(memcmp(a_addressPtr, a_dataPtr, size) == 0)
+	{
+		return;
+	}
+
+	for(i = 0; i < size; i++)
+	{
+		if(a_addressPtr[i] != a_dataPtr[i])
+		{
+			HOST_eepromReady();
+			a_addressPtr[i] = a_dataPtr[i];
+			g_HOST_eepromBusy = HOST_cycles() + HOST_usToCycles(HOST_EEPROM_WRITE_TIME);
+		}
+	}
+	if(g_HOST_avrEepromFile >= 0)
+	{
+		pwrite(g_HOST_avrEepromFile, a_addressPtr, size, a_addressPtr - __start_host_eeprom);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_eepromReady
+ * [DESCRIPTION]:	This Function is used to wait for the end of the last write, as the
+ * 					polling of EEWE does
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_eepromReady(void)
+{
+	uint64 now = HOST_cycles();
+
+	if(now < g_HOST_eepromBusy)
+	{
+		_delay_us((double)(g_HOST_eepromBusy - now) * (1000000.0 / F_CPU));
+	}
+}
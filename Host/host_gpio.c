@@ -0,0 +1,306 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_gpio.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of the ports and the external interrupts
+ * 					of the host HAL>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_NUM_OF_PORTS		4
+
+/* The flags of GIFR and TIFR */
+#define HOST_INTF0				0x40
+#define HOST_INTF1				0x80
+#define HOST_INTF2				0x20
+#define HOST_ICF1				0x20
+
+/* The sense bits of MCUCR, MCUCSR and TCCR1B */
+#define HOST_ISC2				0x40
+#define HOST_ICES1				0x40
+
+/* Devices that share a port, as the trace pin and the motor of mC2 */
+#define HOST_OUTPUT_HOOKS		2
+
+/* The edges sensed by an external interrupt */
+#define HOST_EDGE_FALLING		0x01
+#define HOST_EDGE_RISING		0x02
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* PIN, DDR and PORT of each port, their addresses go down from PIN */
+static const uint8 g_HOST_pinAddresses[HOST_NUM_OF_PORTS] = {HOST_PINA, HOST_PINB, HOST_PINC, HOST_PIND};
+
+static uint8 g_HOST_drive[HOST_NUM_OF_PORTS];		/* Levels driven from outside */
+static uint8 g_HOST_driven[HOST_NUM_OF_PORTS];		/* Pins driven from outside */
+static uint8 (*g_HOST_inputHooks[HOST_NUM_OF_PORTS])(uint8 port, uint8 ddr, uint8 levels);
+static void (*g_HOST_outputHooks[HOST_NUM_OF_PORTS][HOST_OUTPUT_HOOKS])(uint8 port, uint8 ddr, uint8 levels);
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_gpioInit(void);
+static volatile uint8 *HOST_gpioRead(uint8 address);
+static void HOST_gpioWrite(uint8 address, uint8 old_value, uint8 new_value);
+static void HOST_gpioClearFlags(uint8 address, uint8 old_value, uint8 new_value);
+static uint8 HOST_gpioLevels(uint8 port);
+static uint8 HOST_gpioSense(uint8 port, uint8 pin);
+static uint8 HOST_gpioPortOf(uint8 address);
+
+const HOST_ModelType g_HOST_gpioModel = {HOST_gpioInit, NULL_PTR, NULL_PTR, NULL_PTR};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_setPin
+ * [DESCRIPTION]:	This Function is used to drive a pin from outside. An edge on INT0,
+ * 					INT1, INT2 or ICP1 sets its flag as the sense bits select, and the
+ * 					input capture loads ICR1 with the count of timer 1
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				uint8 pin :		This Arg shall indicate the pin
+ * 				uint8 level :	This Arg shall indicate LOGIC_HIGH or LOGIC_LOW
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_setPin(uint8 port, uint8 pin, uint8 level)
+{
+	uint8 before = (HOST_gpioLevels(port) >> pin) & 0x01;
+	uint8 after;
+	uint8 edge;
+	uint16 count;
+
+	g_HOST_driven[port] |= (uint8)(1 << pin);
+	if(level == LOGIC_HIGH)
+	{
+		g_HOST_drive[port] |= (uint8)(1 << pin);
+	}
+	else
+	{
+		g_HOST_drive[port] &= (uint8)~(1 << pin);
+	}
+
+	after = (HOST_gpioLevels(port) >> pin) & 0x01;
+	if(before == after)
+	{
+		return;
+	}
+
+	edge = (after == LOGIC_HIGH) ? HOST_EDGE_RISING : HOST_EDGE_FALLING;
+	if(edge & HOST_gpioSense(port, pin))
+	{
+		if(port == HOST_PORTD_ID)
+		{
+			if(pin == 2)
+			{
+				HOST_changeBits(HOST_GIFR, HOST_INTF0, TRUE);
+			}
+			else if(pin == 3)
+			{
+				HOST_changeBits(HOST_GIFR, HOST_INTF1, TRUE);
+			}
+			else
+			{
+				count = HOST_timerCount(1);
+				HOST_setReg(HOST_ICR1L, (uint8)count);
+				HOST_setReg(HOST_ICR1H, (uint8)(count >> 8));
+				HOST_changeBits(HOST_TIFR, HOST_ICF1, TRUE);
+			}
+		}
+		else
+		{
+			HOST_changeBits(HOST_GIFR, HOST_INTF2, TRUE);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_releasePin
+ * [DESCRIPTION]:	This Function is used to stop driving a pin from outside
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				uint8 pin :		This Arg shall indicate the pin
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_releasePin(uint8 port, uint8 pin)
+{
+	g_HOST_driven[port] &= (uint8)~(1 << pin);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_setInputHook
+ * [DESCRIPTION]:	This Function is used to set the function that gives the input levels
+ * 					of a port
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				a_hook :		This Arg shall indicate the function or NULL_PTR
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_setInputHook(uint8 port, uint8 (*a_hook)(uint8 port, uint8 ddr, uint8 levels))
+{
+	g_HOST_inputHooks[port] = a_hook;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_setOutputHook
+ * [DESCRIPTION]:	This Function is used to add a function called when the firmware
+ * 					changes PORT or DDR of a port, up to HOST_OUTPUT_HOOKS on a port
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				a_hook :		This Arg shall indicate the function
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_setOutputHook(uint8 port, void (*a_hook)(uint8 port, uint8 ddr, uint8 levels))
+{
+	uint8 i;
+
+	for(i = 0; i < HOST_OUTPUT_HOOKS; i++)
+	{
+		if((g_HOST_outputHooks[port][i] == NULL_PTR) || (g_HOST_outputHooks[port][i] == a_hook))
+		{
+			g_HOST_outputHooks[port][i] = a_hook;
+			return;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_gpioInit
+ * [DESCRIPTION]:	This Function is used to set the hooks of the ports and of GIFR
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_gpioInit(void)
+{
+	uint8 port;
+
+	for(port = 0; port < HOST_NUM_OF_PORTS; port++)
+	{
+		HOST_setHooks(g_HOST_pinAddresses[port], HOST_gpioRead, NULL_PTR);
+		HOST_setHooks(g_HOST_pinAddresses[port] + 1, NULL_PTR, HOST_gpioWrite);
+		HOST_setHooks(g_HOST_pinAddresses[port] + 2, NULL_PTR, HOST_gpioWrite);
+	}
+	HOST_setHooks(HOST_GIFR, NULL_PTR, HOST_gpioClearFlags);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_gpioRead
+ * [DESCRIPTION]:	This Function is the read hook of PINx, it loads the levels of the pins
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	NULL_PTR, the access uses the register
+ ----------------------------------------------------------------------------------------*/
+static volatile uint8 *HOST_gpioRead(uint8 address)
+{
+	HOST_setReg(address, HOST_gpioLevels(HOST_gpioPortOf(address)));
+
+	return NULL_PTR;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_gpioWrite
+ * [DESCRIPTION]:	This Function is the write hook of DDRx and PORTx, it gives the new
+ * 					output levels to the output hook of the port
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the value before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_gpioWrite(uint8 address, uint8 old_value, uint8 new_value)
+{
+	uint8 port = HOST_gpioPortOf(address);
+	uint8 pin_address = g_HOST_pinAddresses[port];
+	uint8 i;
+
+	(void)old_value;
+	(void)new_value;
+
+	for(i = 0; (i < HOST_OUTPUT_HOOKS) && (g_HOST_outputHooks[port][i] != NULL_PTR); i++)
+	{
+		(*g_HOST_outputHooks[port][i])(port, HOST_getReg(pin_address + 1), HOST_getReg(pin_address + 2));
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_gpioClearFlags
+ * [DESCRIPTION]:	This Function is the write hook of GIFR, a flag is cleared by writing
+ * 					one to it
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the flags before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_gpioClearFlags(uint8 address, uint8 old_value, uint8 new_value)
+{
+	HOST_setReg(address, old_value & (uint8)~new_value);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_gpioLevels
+ * [DESCRIPTION]:	This Function is used to get the levels of the pins of a port. An output
+ * 					pin has the level of PORT, an input pin has the level driven from
+ * 					outside, else of the input hook, else of the pull up
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * [RETURNS]:	The levels of the pins
+ ----------------------------------------------------------------------------------------*/
+static uint8 HOST_gpioLevels(uint8 port)
+{
+	uint8 pin_address = g_HOST_pinAddresses[port];
+	uint8 ddr = HOST_getReg(pin_address + 1);
+	uint8 levels = HOST_getReg(pin_address + 2);
+	uint8 inputs;
+
+	if(g_HOST_inputHooks[port] != NULL_PTR)
+	{
+		inputs = (*g_HOST_inputHooks[port])(port, ddr, levels);
+	}
+	else
+	{
+		inputs = levels;
+	}
+	inputs = (inputs & (uint8)~g_HOST_driven[port]) | (g_HOST_drive[port] & g_HOST_driven[port]);
+
+	return (levels & ddr) | (inputs & (uint8)~ddr);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_gpioSense
+ * [DESCRIPTION]:	This Function is used to get the edges sensed on a pin, the low level
+ * 					sense of INT0 and INT1 is taken as the falling edge
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				uint8 pin :		This Arg shall indicate the pin
+ * [RETURNS]:	The sensed edges, 0 if the pin has no interrupt
+ ----------------------------------------------------------------------------------------*/
+static uint8 HOST_gpioSense(uint8 port, uint8 pin)
+{
+	static const uint8 senses[4] =
+	{
+		HOST_EDGE_FALLING, HOST_EDGE_FALLING | HOST_EDGE_RISING, HOST_EDGE_FALLING, HOST_EDGE_RISING
+	};
+
+	if((port == HOST_PORTD_ID) && ((pin == 2) || (pin == 3)))
+	{
+		return senses[(HOST_getReg(HOST_MCUCR) >> ((pin - 2) * 2)) & 0x03];
+	}
+	else if((port == HOST_PORTD_ID) && (pin == 6))
+	{
+		return (HOST_getReg(HOST_TCCR1B) & HOST_ICES1) ? HOST_EDGE_RISING : HOST_EDGE_FALLING;
+	}
+	else if((port == HOST_PORTB_ID) && (pin == 2))
+	{
+		return (HOST_getReg(HOST_MCUCSR) & HOST_ISC2) ? HOST_EDGE_RISING : HOST_EDGE_FALLING;
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_gpioPortOf
+ * [DESCRIPTION]:	This Function is used to get the port of a PIN, DDR or PORT register
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	The port
+ ----------------------------------------------------------------------------------------*/
+static uint8 HOST_gpioPortOf(uint8 address)
+{
+	return HOST_PORTD_ID - ((address - HOST_PIND) / 3);
+}
@@ -0,0 +1,204 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_keypad.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of a 4x4 keypad of the host HAL, the keys
+ * 					are pressed by the "press" command of the control channel>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <string.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_KEYPAD_ROWS		4
+#define HOST_KEYPAD_COLS		4
+#define HOST_KEYPAD_QUEUE_SIZE	32
+#define HOST_KEYPAD_HOLD_TIME	100000	/* Time in us a key is held after the firmware saw it */
+#define HOST_KEYPAD_GAP_TIME	100000	/* Time in us between the release and the next key */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	HOST_KEYPAD_IDLE, HOST_KEYPAD_DOWN, HOST_KEYPAD_GAP
+}HOST_KeypadStateType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* The labels of the keys as the harness names them, E is the Enter key */
+static const char g_HOST_keypadLabels[HOST_KEYPAD_ROWS][HOST_KEYPAD_COLS] =
+{
+	{'7', '8', '9', '%'},
+	{'4', '5', '6', 'x'},
+	{'1', '2', '3', '-'},
+	{'E', '0', '=', '+'}
+};
+
+static uint8 g_HOST_keypadFirstRow;
+static uint8 g_HOST_keypadFirstCol;
+
+static char g_HOST_keypadQueue[HOST_KEYPAD_QUEUE_SIZE];
+static uint8 g_HOST_keypadHead = 0;
+static uint8 g_HOST_keypadTail = 0;
+
+static HOST_KeypadStateType g_HOST_keypadState = HOST_KEYPAD_IDLE;
+static char g_HOST_keypadKey;
+static uint8 g_HOST_keypadRow;
+static uint8 g_HOST_keypadCol;
+static uint64 g_HOST_keypadEnd = HOST_NEVER;	/* End of the hold or of the gap */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static uint64 HOST_keypadNext(void);
+static void HOST_keypadEvent(void);
+static void HOST_keypadPress(const char *a_args);
+static uint8 HOST_keypadLevels(uint8 port, uint8 ddr, uint8 levels);
+static void HOST_keypadStart(void);
+
+const HOST_ModelType g_HOST_keypadModel = {NULL_PTR, NULL_PTR, HOST_keypadNext, HOST_keypadEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_keypadAttach
+ * [DESCRIPTION]:	This Function is used to connect the keypad to the pins of the firmware
+ * [ARGS]:		uint8 port :			This Arg shall indicate the port
+ * 				uint8 first_row_pin :	This Arg shall indicate the pin of the first row
+ * 				uint8 first_col_pin :	This Arg shall indicate the pin of the first column
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_keypadAttach(uint8 port, uint8 first_row_pin, uint8 first_col_pin)
+{
+	g_HOST_keypadFirstRow = first_row_pin;
+	g_HOST_keypadFirstCol = first_col_pin;
+
+	HOST_setInputHook(port, HOST_keypadLevels);
+	HOST_setCommand("press", HOST_keypadPress);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_keypadNext
+ * [DESCRIPTION]:	This Function is used to get the cycle of the release of the key or of
+ * 					the end of the gap after it
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_keypadNext(void)
+{
+	return g_HOST_keypadEnd;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_keypadEvent
+ * [DESCRIPTION]:	This Function is used to release the key, or to press the next key of
+ * 					the queue at the end of the gap
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_keypadEvent(void)
+{
+	if(g_HOST_keypadState == HOST_KEYPAD_DOWN)
+	{
+		HOST_report("key %c up", g_HOST_keypadKey);
+		g_HOST_keypadState = HOST_KEYPAD_GAP;
+		g_HOST_keypadEnd = HOST_cycles() + HOST_usToCycles(HOST_KEYPAD_GAP_TIME);
+	}
+	else
+	{
+		HOST_keypadStart();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_keypadPress
+ * [DESCRIPTION]:	This Function is the handler of the "press" command, its keys are
+ * 					pressed one after the other. An unknown key is reported back
+ * [ARGS]:		const char *a_args :	This Arg shall indicate the labels of the keys
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_keypadPress(const char *a_args)
+{
+	uint8 next;
+
+	for(; *a_args != '\0'; a_args++)
+	{
+		next = (g_HOST_keypadTail + 1) % HOST_KEYPAD_QUEUE_SIZE;
+		if((*a_args == ' ') || (next == g_HOST_keypadHead))
+		{
+			continue;
+		}
+		if(memchr(g_HOST_keypadLabels, *a_args, sizeof(g_HOST_keypadLabels)) == NULL_PTR)
+		{
+			HOST_report("error key %c", *a_args);
+			continue;
+		}
+		g_HOST_keypadQueue[g_HOST_keypadTail] = *a_args;
+		g_HOST_keypadTail = next;
+	}
+
+	if(g_HOST_keypadState == HOST_KEYPAD_IDLE)
+	{
+		HOST_keypadStart();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_keypadLevels
+ * [DESCRIPTION]:	This Function is the input hook of the port, the row of the pressed key
+ * 					is pulled low when the firmware drives its column low. The hold starts
+ * 					when the firmware first sees the key
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				uint8 ddr :		This Arg shall indicate its DDR
+ * 				uint8 levels :	This Arg shall indicate its PORT, the pull-ups of the rows
+ * [RETURNS]:	The levels of the input pins
+ ----------------------------------------------------------------------------------------*/
+static uint8 HOST_keypadLevels(uint8 port, uint8 ddr, uint8 levels)
+{
+	uint8 col_pin = g_HOST_keypadFirstCol + g_HOST_keypadCol;
+	uint8 row_pin = g_HOST_keypadFirstRow + g_HOST_keypadRow;
+
+	if((g_HOST_keypadState != HOST_KEYPAD_DOWN) || !((ddr >> col_pin) & 0x01) || ((levels >> col_pin) & 0x01))
+	{
+		return levels;
+	}
+
+	if(g_HOST_keypadEnd == HOST_NEVER)
+	{
+		HOST_report("key %c down", g_HOST_keypadKey);
+		g_HOST_keypadEnd = HOST_cycles() + HOST_usToCycles(HOST_KEYPAD_HOLD_TIME);
+	}
+
+	return levels & (uint8)~(1 << row_pin);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_keypadStart
+ * [DESCRIPTION]:	This Function is used to press the next key of the queue, it is held
+ * 					until the firmware scans its column
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_keypadStart(void)
+{
+	uint8 index;
+
+	g_HOST_keypadEnd = HOST_NEVER;
+	if(g_HOST_keypadHead == g_HOST_keypadTail)
+	{
+		g_HOST_keypadState = HOST_KEYPAD_IDLE;
+		return;
+	}
+
+	g_HOST_keypadKey = g_HOST_keypadQueue[g_HOST_keypadHead];
+	g_HOST_keypadHead = (g_HOST_keypadHead + 1) % HOST_KEYPAD_QUEUE_SIZE;
+	index = (uint8)((const char *)memchr(g_HOST_keypadLabels, g_HOST_keypadKey, sizeof(g_HOST_keypadLabels)) - &g_HOST_keypadLabels[0][0]);
+	g_HOST_keypadRow = index / HOST_KEYPAD_COLS;
+	g_HOST_keypadCol = index % HOST_KEYPAD_COLS;
+	g_HOST_keypadState = HOST_KEYPAD_DOWN;
+}
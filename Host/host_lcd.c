@@ -0,0 +1,235 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_lcd.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of a 2x16 HD44780 LCD of the host HAL, each
+ * 					change of a row is reported on the control channel>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <string.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_LCD_ROWS			2
+#define HOST_LCD_COLS			16
+#define HOST_LCD_LINE_SIZE		0x28	/* DDRAM bytes of a row */
+#define HOST_LCD_ROW1_ADDRESS	0x40
+
+/* The commands, tested from the highest bit down */
+#define HOST_LCD_SET_DDRAM		0x80
+#define HOST_LCD_SET_CGRAM		0x40
+#define HOST_LCD_ENTRY_MODE		0x04
+#define HOST_LCD_INCREMENT		0x02
+#define HOST_LCD_HOME			0x02
+#define HOST_LCD_CLEAR			0x01
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static uint8 g_HOST_lcdControlPort;
+static uint8 g_HOST_lcdDataPort;
+static uint8 g_HOST_lcdRs;
+static uint8 g_HOST_lcdRw;
+static uint8 g_HOST_lcdE;
+
+static uint8 g_HOST_lcdControl;			/* Output levels of the control port */
+static uint8 g_HOST_lcdData;			/* Output levels of the data port */
+
+static char g_HOST_lcdDdram[HOST_LCD_ROWS][HOST_LCD_LINE_SIZE];
+static char g_HOST_lcdShown[HOST_LCD_ROWS][HOST_LCD_COLS];	/* Rows at the last report */
+static uint8 g_HOST_lcdAddress = 0;
+static boolean g_HOST_lcdCgram = FALSE;
+static boolean g_HOST_lcdIncrement = TRUE;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_lcdInit(void);
+static void HOST_lcdPins(uint8 port, uint8 ddr, uint8 levels);
+static void HOST_lcdCommand(uint8 command);
+static void HOST_lcdCharacter(uint8 character);
+static void HOST_lcdReport(void);
+
+const HOST_ModelType g_HOST_lcdModel = {HOST_lcdInit, NULL_PTR, NULL_PTR, NULL_PTR};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_lcdAttach
+ * [DESCRIPTION]:	This Function is used to connect the LCD to the pins of the firmware
+ * [ARGS]:		uint8 control_port :	This Arg shall indicate the port of RS, RW and E
+ * 				uint8 rs_pin :			This Arg shall indicate the pin of RS
+ * 				uint8 rw_pin :			This Arg shall indicate the pin of RW or HOST_NO_PIN
+ * 				uint8 e_pin :			This Arg shall indicate the pin of E
+ * 				uint8 data_port :		This Arg shall indicate the port of D0 to D7
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_lcdAttach(uint8 control_port, uint8 rs_pin, uint8 rw_pin, uint8 e_pin, uint8 data_port)
+{
+	g_HOST_lcdControlPort = control_port;
+	g_HOST_lcdDataPort = data_port;
+	g_HOST_lcdRs = rs_pin;
+	g_HOST_lcdRw = rw_pin;
+	g_HOST_lcdE = e_pin;
+
+	HOST_setOutputHook(control_port, HOST_lcdPins);
+	HOST_setOutputHook(data_port, HOST_lcdPins);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_lcdInit
+ * [DESCRIPTION]:	This Function is used to clear the display
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_lcdInit(void)
+{
+	memset(g_HOST_lcdDdram, ' ', sizeof(g_HOST_lcdDdram));
+	memset(g_HOST_lcdShown, ' ', sizeof(g_HOST_lcdShown));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_lcdPins
+ * [DESCRIPTION]:	This Function is the output hook of the ports of the LCD. A falling
+ * 					edge of E with RW low latches the data port as a command or, with RS
+ * 					high, as a character. The reads of the busy flag are not modelled
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				uint8 ddr :		This Arg shall indicate its DDR
+ * 				uint8 levels :	This Arg shall indicate its output levels
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_lcdPins(uint8 port, uint8 ddr, uint8 levels)
+{
+	uint8 previous = g_HOST_lcdControl;
+
+	if(port == g_HOST_lcdDataPort)
+	{
+		g_HOST_lcdData = levels & ddr;
+	}
+	if(port != g_HOST_lcdControlPort)
+	{
+		return;
+	}
+
+	g_HOST_lcdControl = levels & ddr;
+	if(!((previous >> g_HOST_lcdE) & 0x01) || ((g_HOST_lcdControl >> g_HOST_lcdE) & 0x01))
+	{
+		return;
+	}
+	if((g_HOST_lcdRw != HOST_NO_PIN) && ((g_HOST_lcdControl >> g_HOST_lcdRw) & 0x01))
+	{
+		return;
+	}
+
+	if((g_HOST_lcdControl >> g_HOST_lcdRs) & 0x01)
+	{
+		HOST_lcdCharacter(g_HOST_lcdData);
+	}
+	else
+	{
+		HOST_lcdCommand(g_HOST_lcdData);
+	}
+	HOST_lcdReport();
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_lcdCommand
+ * [DESCRIPTION]:	This Function is used to run a command, only the commands that move the
+ * 					cursor or change the text are modelled
+ * [ARGS]:		uint8 command :	This Arg shall indicate the command
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_lcdCommand(uint8 command)
+{
+	if(command & HOST_LCD_SET_DDRAM)
+	{
+		g_HOST_lcdAddress = command & 0x7F;
+		g_HOST_lcdCgram = FALSE;
+	}
+	else if(command & HOST_LCD_SET_CGRAM)
+	{
+		g_HOST_lcdCgram = TRUE;
+	}
+	else if((command & 0xFC) == HOST_LCD_ENTRY_MODE)
+	{
+		g_HOST_lcdIncrement = (command & HOST_LCD_INCREMENT) ? TRUE : FALSE;
+	}
+	else if((command & 0xFE) == HOST_LCD_HOME)
+	{
+		g_HOST_lcdAddress = 0;
+		g_HOST_lcdCgram = FALSE;
+	}
+	else if(command == HOST_LCD_CLEAR)
+	{
+		memset(g_HOST_lcdDdram, ' ', sizeof(g_HOST_lcdDdram));
+		g_HOST_lcdAddress = 0;
+		g_HOST_lcdCgram = FALSE;
+		g_HOST_lcdIncrement = TRUE;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_lcdCharacter
+ * [DESCRIPTION]:	This Function is used to write a character at the cursor, the cursor
+ * 					wraps from the end of a row to the start of the other one
+ * [ARGS]:		uint8 character :	This Arg shall indicate the character
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_lcdCharacter(uint8 character)
+{
+	uint8 row = (g_HOST_lcdAddress >= HOST_LCD_ROW1_ADDRESS) ? 1 : 0;
+	uint8 col = g_HOST_lcdAddress - (row * HOST_LCD_ROW1_ADDRESS);
+
+	if(g_HOST_lcdCgram == TRUE)
+	{
+		return;
+	}
+
+	if(col < HOST_LCD_LINE_SIZE)
+	{
+		g_HOST_lcdDdram[row][col] = ((character >= ' ') && (character < 0x7F)) ? (char)character : '?';
+	}
+
+	if(g_HOST_lcdIncrement == TRUE)
+	{
+		col = (col + 1) % HOST_LCD_LINE_SIZE;
+		row = (col == 0) ? (row ^ 1) : row;
+	}
+	else
+	{
+		row = (col == 0) ? (row ^ 1) : row;
+		col = (col + HOST_LCD_LINE_SIZE - 1) % HOST_LCD_LINE_SIZE;
+	}
+	g_HOST_lcdAddress = (row * HOST_LCD_ROW1_ADDRESS) + col;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_lcdReport
+ * [DESCRIPTION]:	This Function is used to report the visible rows that changed, as
+ * 					"lcd <row> <text>" without the spaces at the end
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_lcdReport(void)
+{
+	uint8 row;
+	uint8 length;
+
+	for(row = 0; row < HOST_LCD_ROWS; row++)
+	{
+		if(memcmp(g_HOST_lcdShown[row], g_HOST_lcdDdram[row], HOST_LCD_COLS) != 0)
+		{
+			memcpy(g_HOST_lcdShown[row], g_HOST_lcdDdram[row], HOST_LCD_COLS);
+			length = HOST_LCD_COLS;
+			while((length > 0) && (g_HOST_lcdShown[row][length - 1] == ' '))
+			{
+				length--;
+			}
+			HOST_report("lcd %u %.*s", row, length, g_HOST_lcdShown[row]);
+		}
+	}
+}
@@ -0,0 +1,467 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_timer.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of the timers 0, 1 and 2 of the host HAL>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_NUM_OF_TIMERS		3
+#define HOST_MAX_TIMER_EVENTS	5
+
+/* The flags of TIFR */
+#define HOST_TOV0				0x01
+#define HOST_OCF0				0x02
+#define HOST_TOV1				0x04
+#define HOST_OCF1B				0x08
+#define HOST_OCF1A				0x10
+#define HOST_TOV2				0x40
+#define HOST_OCF2				0x80
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	HOST_TIMER_NORMAL, HOST_TIMER_PHASE_CORRECT, HOST_TIMER_CTC, HOST_TIMER_FAST
+}HOST_TimerModeType;
+
+/* A flag set when the count reaches a position of the period */
+typedef struct
+{
+	uint32 position;
+	uint8 flag;
+}HOST_TimerEventType;
+
+/*
+ * The count of a timer is kept as an absolute number of timer ticks since its
+ * base, the position in the period gives TCNT. In the phase correct mode the
+ * period is 2 * TOP, counting up then down.
+ */
+typedef struct
+{
+	uint64 base;				/* Cycle of the tick base_count */
+	uint64 base_count;
+	uint64 done;				/* Last tick whose flags are set */
+	uint16 prescaler;			/* 0 when the timer is stopped */
+	uint16 top;
+	uint32 period;
+	HOST_TimerModeType mode;
+	HOST_TimerEventType events[HOST_MAX_TIMER_EVENTS];
+	uint8 num_of_events;
+}HOST_TimerType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static const uint16 g_HOST_prescalers[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+static const uint16 g_HOST_timer2Prescalers[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+
+static HOST_TimerType g_HOST_timers[HOST_NUM_OF_TIMERS];
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_timerInit(void);
+static uint64 HOST_timerNext(void);
+static void HOST_timerEvent(void);
+static volatile uint8 *HOST_timerRead(uint8 address);
+static void HOST_timerWrite(uint8 address, uint8 old_value, uint8 new_value);
+static void HOST_timerClearFlags(uint8 address, uint8 old_value, uint8 new_value);
+static uint8 HOST_timerOf(uint8 address);
+static uint64 HOST_timerTicks(const HOST_TimerType *a_timerPtr, uint64 cycle);
+static uint16 HOST_timerValue(const HOST_TimerType *a_timerPtr, uint64 ticks);
+static uint64 HOST_timerNextTick(const HOST_TimerType *a_timerPtr, uint8 *a_flagsPtr);
+static void HOST_timerConfigure(uint8 timer);
+static void HOST_timerAddEvent(HOST_TimerType *a_timerPtr, uint16 compare, uint8 flag);
+
+const HOST_ModelType g_HOST_timerModel = {HOST_timerInit, NULL_PTR, HOST_timerNext, HOST_timerEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerCount
+ * [DESCRIPTION]:	This Function is used to read the count of a timer at HOST_cycles()
+ * [ARGS]:		uint8 timer :	This Arg shall indicate the timer 0, 1 or 2
+ * [RETURNS]:	The count of the timer
+ ----------------------------------------------------------------------------------------*/
+uint16 HOST_timerCount(uint8 timer)
+{
+	const HOST_TimerType *timer_ptr = &g_HOST_timers[timer];
+
+	return HOST_timerValue(timer_ptr, HOST_timerTicks(timer_ptr, HOST_cycles()));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerInit
+ * [DESCRIPTION]:	This Function is used to set the hooks of the timer registers
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_timerInit(void)
+{
+	static const uint8 registers[] =
+	{
+		HOST_TCCR0, HOST_OCR0, HOST_TCCR1A, HOST_TCCR1B, HOST_OCR1AL, HOST_OCR1AH,
+		HOST_OCR1BL, HOST_OCR1BH, HOST_ICR1L, HOST_ICR1H, HOST_TCCR2, HOST_OCR2
+	};
+	uint8 i;
+
+	for(i = 0; i < sizeof(registers); i++)
+	{
+		HOST_setHooks(registers[i], NULL_PTR, HOST_timerWrite);
+	}
+	HOST_setHooks(HOST_TCNT0, HOST_timerRead, HOST_timerWrite);
+	HOST_setHooks(HOST_TCNT1L, HOST_timerRead, HOST_timerWrite);
+	HOST_setHooks(HOST_TCNT1H, HOST_timerRead, HOST_timerWrite);
+	HOST_setHooks(HOST_TCNT2, HOST_timerRead, HOST_timerWrite);
+	HOST_setHooks(HOST_TIFR, NULL_PTR, HOST_timerClearFlags);
+
+	for(i = 0; i < HOST_NUM_OF_TIMERS; i++)
+	{
+		HOST_timerConfigure(i);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerNext
+ * [DESCRIPTION]:	This Function is used to get the cycle of the next flag of the timers
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_timerNext(void)
+{
+	const HOST_TimerType *timer_ptr;
+	uint64 next = HOST_NEVER;
+	uint64 tick;
+	uint64 cycle;
+	uint8 flags;
+	uint8 i;
+
+	for(i = 0; i < HOST_NUM_OF_TIMERS; i++)
+	{
+		timer_ptr = &g_HOST_timers[i];
+		tick = HOST_timerNextTick(timer_ptr, &flags);
+		if(tick != HOST_NEVER)
+		{
+			cycle = timer_ptr->base + ((tick - timer_ptr->base_count) * timer_ptr->prescaler);
+			if(cycle < next)
+			{
+				next = cycle;
+			}
+		}
+	}
+
+	return next;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerEvent
+ * [DESCRIPTION]:	This Function is used to set the flags of the timers that are due
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_timerEvent(void)
+{
+	HOST_TimerType *timer_ptr;
+	uint64 now = HOST_cycles();
+	uint64 tick;
+	uint8 flags;
+	uint8 i;
+
+	for(i = 0; i < HOST_NUM_OF_TIMERS; i++)
+	{
+		timer_ptr = &g_HOST_timers[i];
+		tick = HOST_timerNextTick(timer_ptr, &flags);
+		if((tick != HOST_NEVER) && (tick <= HOST_timerTicks(timer_ptr, now)))
+		{
+			timer_ptr->done = tick;
+			HOST_changeBits(HOST_TIFR, flags, TRUE);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerRead
+ * [DESCRIPTION]:	This Function is the read hook of TCNT0, TCNT1 and TCNT2, it loads the
+ * 					count of the timer
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	NULL_PTR, the access uses the register
+ ----------------------------------------------------------------------------------------*/
+static volatile uint8 *HOST_timerRead(uint8 address)
+{
+	uint8 timer = HOST_timerOf(address);
+	uint16 count = HOST_timerCount(timer);
+
+	/* A loop on the count, as the bits of the trace, ends at a count and not at a flag */
+	HOST_busy();
+	if(timer == 1)
+	{
+		HOST_setReg(HOST_TCNT1L, (uint8)count);
+		HOST_setReg(HOST_TCNT1H, (uint8)(count >> 8));
+	}
+	else
+	{
+		HOST_setReg(address, (uint8)count);
+	}
+
+	return NULL_PTR;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerWrite
+ * [DESCRIPTION]:	This Function is the write hook of the timer registers, the timer goes
+ * 					on from its count, or from the written count, with its new configuration
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the value before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_timerWrite(uint8 address, uint8 old_value, uint8 new_value)
+{
+	uint8 timer = HOST_timerOf(address);
+	HOST_TimerType *timer_ptr = &g_HOST_timers[timer];
+	uint64 now = HOST_cycles();
+	uint16 count;
+
+	(void)old_value;
+	(void)new_value;
+
+	if((address == HOST_TCNT0) || (address == HOST_TCNT2))
+	{
+		count = HOST_getReg(address);
+	}
+	else if((address == HOST_TCNT1L) || (address == HOST_TCNT1H))
+	{
+		count = HOST_getReg(HOST_TCNT1L) | ((uint16)HOST_getReg(HOST_TCNT1H) << 8);
+	}
+	else
+	{
+		count = HOST_timerCount(timer);
+	}
+
+	HOST_timerConfigure(timer);
+	timer_ptr->base = now;
+	timer_ptr->base_count = (timer_ptr->period != 0) ? (count % timer_ptr->period) : 0;
+	timer_ptr->done = timer_ptr->base_count;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerClearFlags
+ * [DESCRIPTION]:	This Function is the write hook of TIFR, a flag is cleared by writing
+ * 					one to it and writing zero leaves it
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the flags before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_timerClearFlags(uint8 address, uint8 old_value, uint8 new_value)
+{
+	HOST_setReg(address, old_value & (uint8)~new_value);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerOf
+ * [DESCRIPTION]:	This Function is used to get the timer of a register
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	The timer 0, 1 or 2
+ ----------------------------------------------------------------------------------------*/
+static uint8 HOST_timerOf(uint8 address)
+{
+	if((address == HOST_TCCR0) || (address == HOST_TCNT0) || (address == HOST_OCR0))
+	{
+		return 0;
+	}
+	else if((address == HOST_TCCR2) || (address == HOST_TCNT2) || (address == HOST_OCR2))
+	{
+		return 2;
+	}
+
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerTicks
+ * [DESCRIPTION]:	This Function is used to get the absolute tick of a timer at a cycle
+ * [ARGS]:		const HOST_TimerType *a_timerPtr :	This Arg shall indicate the timer
+ * 				uint64 cycle :						This Arg shall indicate the cycle
+ * [RETURNS]:	The tick of the timer
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_timerTicks(const HOST_TimerType *a_timerPtr, uint64 cycle)
+{
+	if((a_timerPtr->prescaler == 0) || (cycle < a_timerPtr->base))
+	{
+		return a_timerPtr->base_count;
+	}
+
+	return a_timerPtr->base_count + ((cycle - a_timerPtr->base) / a_timerPtr->prescaler);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerValue
+ * [DESCRIPTION]:	This Function is used to get the count of a timer at an absolute tick
+ * [ARGS]:		const HOST_TimerType *a_timerPtr :	This Arg shall indicate the timer
+ * 				uint64 ticks :						This Arg shall indicate the tick
+ * [RETURNS]:	The count of the timer
+ ----------------------------------------------------------------------------------------*/
+static uint16 HOST_timerValue(const HOST_TimerType *a_timerPtr, uint64 ticks)
+{
+	uint32 position;
+
+	if(a_timerPtr->period == 0)
+	{
+		return 0;
+	}
+
+	position = (uint32)(ticks % a_timerPtr->period);
+	if((a_timerPtr->mode == HOST_TIMER_PHASE_CORRECT) && (position > a_timerPtr->top))
+	{
+		position = a_timerPtr->period - position;
+	}
+
+	return (uint16)position;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerNextTick
+ * [DESCRIPTION]:	This Function is used to get the first tick after the last done tick
+ * 					that sets a flag
+ * [ARGS]:		const HOST_TimerType *a_timerPtr :	This Arg shall indicate the timer
+ * 				uint8 *a_flagsPtr :					This Arg shall indicate where to put
+ * 													the flags of the tick
+ * [RETURNS]:	The tick, HOST_NEVER if the timer has no events
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_timerNextTick(const HOST_TimerType *a_timerPtr, uint8 *a_flagsPtr)
+{
+	uint64 first = HOST_NEVER;
+	uint64 tick;
+	uint32 from;
+	uint8 i;
+
+	*a_flagsPtr = 0;
+	if((a_timerPtr->prescaler == 0) || (a_timerPtr->period == 0))
+	{
+		return HOST_NEVER;
+	}
+
+	from = (uint32)((a_timerPtr->done + 1) % a_timerPtr->period);
+	for(i = 0; i < a_timerPtr->num_of_events; i++)
+	{
+		tick = a_timerPtr->done + 1 + ((a_timerPtr->events[i].position + a_timerPtr->period - from) % a_timerPtr->period);
+		if(tick < first)
+		{
+			first = tick;
+			*a_flagsPtr = a_timerPtr->events[i].flag;
+		}
+		else if(tick == first)
+		{
+			*a_flagsPtr |= a_timerPtr->events[i].flag;
+		}
+	}
+
+	return first;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerConfigure
+ * [DESCRIPTION]:	This Function is used to decode the registers of a timer in its clock,
+ * 					its mode, its TOP and the positions of its flags
+ * [ARGS]:		uint8 timer :	This Arg shall indicate the timer 0, 1 or 2
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_timerConfigure(uint8 timer)
+{
+	static const HOST_TimerModeType modes8[4] =
+	{
+		HOST_TIMER_NORMAL, HOST_TIMER_PHASE_CORRECT, HOST_TIMER_CTC, HOST_TIMER_FAST
+	};
+	static const HOST_TimerModeType modes16[16] =
+	{
+		HOST_TIMER_NORMAL, HOST_TIMER_PHASE_CORRECT, HOST_TIMER_PHASE_CORRECT, HOST_TIMER_PHASE_CORRECT,
+		HOST_TIMER_CTC, HOST_TIMER_FAST, HOST_TIMER_FAST, HOST_TIMER_FAST,
+		HOST_TIMER_PHASE_CORRECT, HOST_TIMER_PHASE_CORRECT, HOST_TIMER_PHASE_CORRECT, HOST_TIMER_PHASE_CORRECT,
+		HOST_TIMER_CTC, HOST_TIMER_NORMAL, HOST_TIMER_FAST, HOST_TIMER_FAST
+	};
+	static const uint16 tops16[16] =
+	{
+		0xFFFF, 0x00FF, 0x01FF, 0x03FF, 0, 0x00FF, 0x01FF, 0x03FF, 0, 0, 0, 0, 0, 0xFFFF, 0, 0
+	};
+	HOST_TimerType *timer_ptr = &g_HOST_timers[timer];
+	uint16 ocr1a = HOST_getReg(HOST_OCR1AL) | ((uint16)HOST_getReg(HOST_OCR1AH) << 8);
+	uint16 ocr1b = HOST_getReg(HOST_OCR1BL) | ((uint16)HOST_getReg(HOST_OCR1BH) << 8);
+	uint16 icr1 = HOST_getReg(HOST_ICR1L) | ((uint16)HOST_getReg(HOST_ICR1H) << 8);
+	uint8 control;
+	uint8 wgm;
+
+	timer_ptr->num_of_events = 0;
+
+	if(timer == 1)
+	{
+		wgm = ((HOST_getReg(HOST_TCCR1B) >> 1) & 0x0C) | (HOST_getReg(HOST_TCCR1A) & 0x03);
+		timer_ptr->prescaler = g_HOST_prescalers[HOST_getReg(HOST_TCCR1B) & 0x07];
+		timer_ptr->mode = modes16[wgm];
+		timer_ptr->top = tops16[wgm];
+		if((wgm == 4) || (wgm == 9) || (wgm == 11) || (wgm == 15))
+		{
+			timer_ptr->top = ocr1a;
+		}
+		else if((wgm == 8) || (wgm == 10) || (wgm == 12) || (wgm == 14))
+		{
+			timer_ptr->top = icr1;
+		}
+		HOST_timerAddEvent(timer_ptr, ocr1a, HOST_OCF1A);
+		HOST_timerAddEvent(timer_ptr, ocr1b, HOST_OCF1B);
+	}
+	else
+	{
+		control = HOST_getReg((timer == 0) ? HOST_TCCR0 : HOST_TCCR2);
+		wgm = ((control >> 2) & 0x02) | ((control >> 6) & 0x01);
+		timer_ptr->prescaler = (timer == 0) ? g_HOST_prescalers[control & 0x07] : g_HOST_timer2Prescalers[control & 0x07];
+		timer_ptr->mode = modes8[wgm];
+		timer_ptr->top = (timer_ptr->mode == HOST_TIMER_CTC) ? HOST_getReg((timer == 0) ? HOST_OCR0 : HOST_OCR2) : 0xFF;
+		HOST_timerAddEvent(timer_ptr, HOST_getReg((timer == 0) ? HOST_OCR0 : HOST_OCR2),
+				(timer == 0) ? HOST_OCF0 : HOST_OCF2);
+	}
+
+	timer_ptr->period = (timer_ptr->mode == HOST_TIMER_PHASE_CORRECT) ? (2 * (uint32)timer_ptr->top) : ((uint32)timer_ptr->top + 1);
+
+	/* TOV is set at BOTTOM, in the CTC mode only when TOP is MAX */
+	if((timer_ptr->mode != HOST_TIMER_CTC) || (timer_ptr->top == ((timer == 1) ? 0xFFFF : 0xFF)))
+	{
+		timer_ptr->events[timer_ptr->num_of_events].position = 0;
+		timer_ptr->events[timer_ptr->num_of_events].flag = (timer == 0) ? HOST_TOV0 : ((timer == 1) ? HOST_TOV1 : HOST_TOV2);
+		timer_ptr->num_of_events++;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_timerAddEvent
+ * [DESCRIPTION]:	This Function is used to add the positions of a compare flag, counting
+ * 					up and, in the phase correct mode, counting down
+ * [ARGS]:		HOST_TimerType *a_timerPtr :	This Arg shall indicate the timer
+ * 				uint16 compare :				This Arg shall indicate the compare value
+ * 				uint8 flag :					This Arg shall indicate the flag of TIFR
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_timerAddEvent(HOST_TimerType *a_timerPtr, uint16 compare, uint8 flag)
+{
+	if(compare > a_timerPtr->top)
+	{
+		return;
+	}
+
+	a_timerPtr->events[a_timerPtr->num_of_events].position = compare;
+	a_timerPtr->events[a_timerPtr->num_of_events].flag = flag;
+	a_timerPtr->num_of_events++;
+
+	if((a_timerPtr->mode == HOST_TIMER_PHASE_CORRECT) && (compare != 0) && (compare != a_timerPtr->top))
+	{
+		a_timerPtr->events[a_timerPtr->num_of_events].position = (2 * (uint32)a_timerPtr->top) - compare;
+		a_timerPtr->events[a_timerPtr->num_of_events].flag = flag;
+		a_timerPtr->num_of_events++;
+	}
+}
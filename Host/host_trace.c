@@ -0,0 +1,156 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_trace.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the receiver of the trace of the host HAL, it decodes
+ * 					the frames of the software UART of the firmware and writes their bytes
+ * 					to a file for the decoder of the trace>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HOST_TRACE_STOP_BIT		9		/* The start bit is 0 and the data bits 1 to 8 */
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static int g_HOST_trace = -1;
+static uint8 g_HOST_tracePort;
+static uint8 g_HOST_tracePin;
+static uint32 g_HOST_traceBaud;
+
+static uint8 g_HOST_traceLevel = LOGIC_HIGH;
+static boolean g_HOST_traceReceiving = FALSE;
+static uint64 g_HOST_traceStart;				/* Cycle of the falling edge of the start bit */
+static uint8 g_HOST_traceBit;					/* Next bit to sample */
+static uint8 g_HOST_traceByte;
+static uint32 g_HOST_traceErrors = 0;			/* Frames without their stop bit */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static uint64 HOST_traceNext(void);
+static void HOST_traceEvent(void);
+static void HOST_tracePins(uint8 port, uint8 ddr, uint8 levels);
+
+const HOST_ModelType g_HOST_traceModel = {NULL_PTR, NULL_PTR, HOST_traceNext, HOST_traceEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_traceAttach
+ * [DESCRIPTION]:	This Function is used to connect the receiver to the TX pin of the trace.
+ * 					The bytes are written to the file of HOST_TRACE, there is no receiver
+ * 					when it is not set. The bit times need the simulated clock
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port of the pin
+ * 				uint8 pin :		This Arg shall indicate the pin
+ * 				uint32 baud :	This Arg shall indicate the baud rate of the software UART
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void HOST_traceAttach(uint8 port, uint8 pin, uint32 baud)
+{
+	const char *config = HOST_getConfig("HOST_TRACE", NULL_PTR);
+
+	if(config == NULL_PTR)
+	{
+		return;
+	}
+
+	g_HOST_trace = open(config, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(g_HOST_trace < 0)
+	{
+		return;
+	}
+
+	g_HOST_tracePort = port;
+	g_HOST_tracePin = pin;
+	g_HOST_traceBaud = baud;
+	HOST_setOutputHook(port, HOST_tracePins);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_traceNext
+ * [DESCRIPTION]:	This Function is used to get the cycle of the middle of the next bit
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_traceNext(void)
+{
+	if(g_HOST_traceReceiving == FALSE)
+	{
+		return HOST_NEVER;
+	}
+
+	return g_HOST_traceStart + (((2 * g_HOST_traceBit + 1) * HOST_usToCycles(1000000)) / (2 * g_HOST_traceBaud));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_traceEvent
+ * [DESCRIPTION]:	This Function is used to sample a bit. A start bit that is not low any
+ * 					more is a glitch, and a frame without its stop bit is dropped
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_traceEvent(void)
+{
+	if(g_HOST_traceBit == 0)
+	{
+		g_HOST_traceReceiving = (g_HOST_traceLevel == LOGIC_LOW) ? TRUE : FALSE;
+	}
+	else if(g_HOST_traceBit < HOST_TRACE_STOP_BIT)
+	{
+		g_HOST_traceByte = (uint8)((g_HOST_traceByte >> 1) | (g_HOST_traceLevel << 7));
+	}
+	else
+	{
+		g_HOST_traceReceiving = FALSE;
+		if(g_HOST_traceLevel == LOGIC_HIGH)
+		{
+			if(write(g_HOST_trace, &g_HOST_traceByte, 1) < 0)
+			{
+				g_HOST_trace = -1;
+			}
+		}
+		else
+		{
+			g_HOST_traceErrors++;
+			HOST_report("trace framing error %u", g_HOST_traceErrors);
+		}
+	}
+	g_HOST_traceBit++;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_tracePins
+ * [DESCRIPTION]:	This Function is the output hook of the port of the pin, a falling edge
+ * 					on the idle line starts a frame. A pin that is not an output is high
+ * [ARGS]:		uint8 port :	This Arg shall indicate the port
+ * 				uint8 ddr :		This Arg shall indicate its DDR
+ * 				uint8 levels :	This Arg shall indicate its output levels
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_tracePins(uint8 port, uint8 ddr, uint8 levels)
+{
+	uint8 level = ((((ddr >> g_HOST_tracePin) & 0x01) == 0) || (((levels >> g_HOST_tracePin) & 0x01) != 0)) ? LOGIC_HIGH : LOGIC_LOW;
+
+	if((port != g_HOST_tracePort) || (g_HOST_trace < 0))
+	{
+		return;
+	}
+
+	if((level == LOGIC_LOW) && (g_HOST_traceLevel == LOGIC_HIGH) && (g_HOST_traceReceiving == FALSE))
+	{
+		g_HOST_traceReceiving = TRUE;
+		g_HOST_traceStart = HOST_cycles();
+		g_HOST_traceBit = 0;
+		g_HOST_traceByte = 0;
+	}
+	g_HOST_traceLevel = level;
+}
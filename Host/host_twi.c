@@ -0,0 +1,281 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_twi.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of the TWI of the host HAL with a 24C16
+ * 					EEPROM on the bus, kept in a file of the host>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+/* The bits of TWCR */
+#define HOST_TWINT				0x80
+#define HOST_TWEA				0x40
+#define HOST_TWSTA				0x20
+#define HOST_TWSTO				0x10
+#define HOST_TWEN				0x04
+
+/* The status codes of TWSR */
+#define HOST_TWI_START			0x08
+#define HOST_TWI_REP_START		0x10
+#define HOST_TWI_SLA_W_ACK		0x18
+#define HOST_TWI_SLA_W_NACK		0x20
+#define HOST_TWI_DATA_ACK		0x28
+#define HOST_TWI_SLA_R_ACK		0x40
+#define HOST_TWI_SLA_R_NACK		0x48
+#define HOST_TWI_RX_ACK			0x50
+#define HOST_TWI_RX_NACK		0x58
+
+#define HOST_EEPROM_SIZE		2048
+#define HOST_EEPROM_PAGE_SIZE	16
+#define HOST_EEPROM_SLA			0xA0	/* The block of 256 bytes is in bits 3:1 */
+#define HOST_EEPROM_WRITE_TIME	5000	/* Write cycle in us, the SLA is not acknowledged */
+#define HOST_TWI_BITS			9		/* SCL periods of a byte and its ACK */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	HOST_TWI_IDLE, HOST_TWI_SLA, HOST_TWI_ADDRESS, HOST_TWI_WRITE, HOST_TWI_READ, HOST_TWI_NACKED
+}HOST_TwiStateType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static uint8 g_HOST_eeprom[HOST_EEPROM_SIZE];
+static int g_HOST_eepromFile = -1;
+
+static HOST_TwiStateType g_HOST_twiState = HOST_TWI_IDLE;
+static uint16 g_HOST_twiPointer = 0;			/* Address counter of the 24C16 */
+static uint8 g_HOST_twiPage[HOST_EEPROM_PAGE_SIZE];
+static uint16 g_HOST_twiPageMask = 0;			/* Bytes of the page written before the STOP */
+static uint16 g_HOST_twiPageAddress = 0;
+static uint64 g_HOST_twiBusyEnd = 0;			/* End of the write cycle */
+
+static uint64 g_HOST_twiEnd = HOST_NEVER;		/* End of the operation on the bus */
+static uint8 g_HOST_twiStatus;
+static boolean g_HOST_twiDone = FALSE;			/* TWINT to show at the next read of TWCR */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_twiInit(void);
+static uint64 HOST_twiNext(void);
+static void HOST_twiEvent(void);
+static volatile uint8 *HOST_twiReadControl(uint8 address);
+static void HOST_twiWriteControl(uint8 address, uint8 old_value, uint8 new_value);
+static void HOST_twiOperation(uint8 control);
+static void HOST_twiProgram(void);
+static void HOST_twiFinish(uint8 status, uint8 bits);
+
+const HOST_ModelType g_HOST_twiModel = {HOST_twiInit, NULL_PTR, HOST_twiNext, HOST_twiEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiInit
+ * [DESCRIPTION]:	This Function is used to load the image of the 24C16 from HOST_EEPROM,
+ * 					the memory is erased when it is not set
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_twiInit(void)
+{
+	const char *path = HOST_getConfig("HOST_EEPROM", NULL_PTR);
+	ssize_t size = 0;
+
+	memset(g_HOST_eeprom, 0xFF, HOST_EEPROM_SIZE);
+	if(path != NULL_PTR)
+	{
+		g_HOST_eepromFile = open(path, O_RDWR | O_CREAT, 0644);
+		if(g_HOST_eepromFile >= 0)
+		{
+			size = pread(g_HOST_eepromFile, g_HOST_eeprom, HOST_EEPROM_SIZE, 0);
+			if(size < HOST_EEPROM_SIZE)
+			{
+				memset(&g_HOST_eeprom[(size > 0) ? size : 0], 0xFF, HOST_EEPROM_SIZE - ((size > 0) ? size : 0));
+				pwrite(g_HOST_eepromFile, g_HOST_eeprom, HOST_EEPROM_SIZE, 0);
+			}
+		}
+	}
+
+	HOST_setHooks(HOST_TWCR, HOST_twiReadControl, HOST_twiWriteControl);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiNext
+ * [DESCRIPTION]:	This Function is used to get the cycle of the end of the operation
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_twiNext(void)
+{
+	return g_HOST_twiEnd;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiEvent
+ * [DESCRIPTION]:	This Function is used to end the operation, the status is loaded and
+ * 					TWINT is set
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_twiEvent(void)
+{
+	g_HOST_twiEnd = HOST_NEVER;
+	HOST_setReg(HOST_TWSR, g_HOST_twiStatus | (HOST_getReg(HOST_TWSR) & 0x03));
+	g_HOST_twiDone = TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiReadControl
+ * [DESCRIPTION]:	This Function is the read hook of TWCR. TWINT is shown once at the end
+ * 					of an operation and cleared at the other accesses, so the firmware
+ * 					writing the same TWCR for each byte is always a change
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	NULL_PTR, the access uses the register
+ ----------------------------------------------------------------------------------------*/
+static volatile uint8 *HOST_twiReadControl(uint8 address)
+{
+	HOST_changeBits(address, HOST_TWINT, g_HOST_twiDone);
+	g_HOST_twiDone = FALSE;
+
+	return NULL_PTR;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiWriteControl
+ * [DESCRIPTION]:	This Function is the write hook of TWCR, writing one to TWINT starts an
+ * 					operation on the bus
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the value before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_twiWriteControl(uint8 address, uint8 old_value, uint8 new_value)
+{
+	(void)old_value;
+
+	HOST_changeBits(address, HOST_TWINT, FALSE);
+	if((new_value & HOST_TWINT) && (new_value & HOST_TWEN))
+	{
+		HOST_twiOperation(new_value);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiOperation
+ * [DESCRIPTION]:	This Function is used to run an operation of the master on the 24C16:
+ * 					a START, a STOP that programs the written bytes, or a byte
+ * [ARGS]:		uint8 control :	This Arg shall indicate the written TWCR
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_twiOperation(uint8 control)
+{
+	uint8 data = HOST_getReg(HOST_TWDR);
+
+	if(control & HOST_TWSTA)
+	{
+		HOST_twiFinish((g_HOST_twiState == HOST_TWI_IDLE) ? HOST_TWI_START : HOST_TWI_REP_START, 1);
+		g_HOST_twiPageMask = 0;
+		g_HOST_twiState = HOST_TWI_SLA;
+	}
+	else if(control & HOST_TWSTO)
+	{
+		HOST_twiProgram();
+		g_HOST_twiState = HOST_TWI_IDLE;
+		HOST_changeBits(HOST_TWCR, HOST_TWSTO, FALSE);
+	}
+	else if(g_HOST_twiState == HOST_TWI_SLA)
+	{
+		if(((data & 0xF0) != HOST_EEPROM_SLA) || (HOST_cycles() < g_HOST_twiBusyEnd))
+		{
+			HOST_twiFinish((data & 0x01) ? HOST_TWI_SLA_R_NACK : HOST_TWI_SLA_W_NACK, HOST_TWI_BITS);
+			g_HOST_twiState = HOST_TWI_NACKED;
+		}
+		else
+		{
+			g_HOST_twiPointer = ((uint16)(data & 0x0E) << 7) | (g_HOST_twiPointer & 0xFF);
+			HOST_twiFinish((data & 0x01) ? HOST_TWI_SLA_R_ACK : HOST_TWI_SLA_W_ACK, HOST_TWI_BITS);
+			g_HOST_twiState = (data & 0x01) ? HOST_TWI_READ : HOST_TWI_ADDRESS;
+		}
+	}
+	else if(g_HOST_twiState == HOST_TWI_ADDRESS)
+	{
+		g_HOST_twiPointer = (g_HOST_twiPointer & 0x700) | data;
+		HOST_twiFinish(HOST_TWI_DATA_ACK, HOST_TWI_BITS);
+		g_HOST_twiState = HOST_TWI_WRITE;
+	}
+	else if(g_HOST_twiState == HOST_TWI_WRITE)
+	{
+		/* The address rolls over in the page */
+		g_HOST_twiPageAddress = g_HOST_twiPointer & (uint16)~(HOST_EEPROM_PAGE_SIZE - 1);
+		g_HOST_twiPage[g_HOST_twiPointer % HOST_EEPROM_PAGE_SIZE] = data;
+		g_HOST_twiPageMask |= (uint16)1 << (g_HOST_twiPointer % HOST_EEPROM_PAGE_SIZE);
+		g_HOST_twiPointer = g_HOST_twiPageAddress | ((g_HOST_twiPointer + 1) % HOST_EEPROM_PAGE_SIZE);
+		HOST_twiFinish(HOST_TWI_DATA_ACK, HOST_TWI_BITS);
+	}
+	else if(g_HOST_twiState == HOST_TWI_READ)
+	{
+		HOST_setReg(HOST_TWDR, g_HOST_eeprom[g_HOST_twiPointer]);
+		g_HOST_twiPointer = (g_HOST_twiPointer + 1) % HOST_EEPROM_SIZE;
+		HOST_twiFinish((control & HOST_TWEA) ? HOST_TWI_RX_ACK : HOST_TWI_RX_NACK, HOST_TWI_BITS);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiProgram
+ * [DESCRIPTION]:	This Function is used to program the bytes of the page written before
+ * 					the STOP, then the 24C16 is busy for its write cycle
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_twiProgram(void)
+{
+	uint8 i;
+
+	if((g_HOST_twiState != HOST_TWI_WRITE) || (g_HOST_twiPageMask == 0))
+	{
+		return;
+	}
+
+	for(i = 0; i < HOST_EEPROM_PAGE_SIZE; i++)
+	{
+		if(g_HOST_twiPageMask & ((uint16)1 << i))
+		{
+			g_HOST_eeprom[g_HOST_twiPageAddress + i] = g_HOST_twiPage[i];
+		}
+	}
+	if(g_HOST_eepromFile >= 0)
+	{
+		pwrite(g_HOST_eepromFile, &g_HOST_eeprom[g_HOST_twiPageAddress], HOST_EEPROM_PAGE_SIZE, g_HOST_twiPageAddress);
+	}
+
+	g_HOST_twiPageMask = 0;
+	g_HOST_twiBusyEnd = HOST_cycles() + HOST_usToCycles(HOST_EEPROM_WRITE_TIME);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_twiFinish
+ * [DESCRIPTION]:	This Function is used to end an operation after its SCL periods, the
+ * 					rate is F_CPU / (16 + 2 * TWBR * 4^TWPS)
+ * [ARGS]:		uint8 status :	This Arg shall indicate the status of the operation
+ * 				uint8 bits :	This Arg shall indicate the SCL periods of the operation
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_twiFinish(uint8 status, uint8 bits)
+{
+	uint64 period = 16 + (2 * (uint64)HOST_getReg(HOST_TWBR) * ((uint64)1 << (2 * (HOST_getReg(HOST_TWSR) & 0x03))));
+
+	g_HOST_twiStatus = status;
+	g_HOST_twiDone = FALSE;
+	g_HOST_twiEnd = HOST_cycles() + (bits * period);
+}
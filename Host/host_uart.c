@@ -0,0 +1,531 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<host_uart.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the model of the UART of the host HAL, the line is
+ * 					a file descriptor or a file of the host>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "host.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+/* The flags of UCSRA */
+#define HOST_RXC				0x80
+#define HOST_TXC				0x40
+#define HOST_UDRE				0x20
+#define HOST_U2X				0x02
+#define HOST_MPCM				0x01
+
+/* The bits of UCSRB and UCSRC */
+#define HOST_RXCIE				0x80
+#define HOST_RXEN				0x10
+#define HOST_TXEN				0x08
+#define HOST_UCSZ2				0x04
+#define HOST_URSEL				0x80
+#define HOST_UPM1				0x20
+#define HOST_USBS				0x08
+#define HOST_UCSZ				0x06
+
+#define HOST_UART_BUFFER_SIZE	64
+
+/* A byte written by the ISR of a tick is committed by a later tick */
+#define HOST_UART_COMMIT_TIME	(2 * HOST_TICK_TIME)
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* The flag of UCSRA last shown to a polling firmware */
+typedef enum
+{
+	HOST_UART_VIEW_RX, HOST_UART_VIEW_TX
+}HOST_UartViewType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static int g_HOST_uartIn = -1;
+static int g_HOST_uartOut = -1;
+static boolean g_HOST_uartOutControl = FALSE;	/* The bytes sent are events of the control channel */
+
+/* Receiver */
+static uint8 g_HOST_uartInput[HOST_UART_BUFFER_SIZE];
+static uint64 g_HOST_uartInputTime[HOST_UART_BUFFER_SIZE];	/* End of the frame of each byte */
+static uint8 g_HOST_uartInputSize = 0;
+static uint8 g_HOST_uartInputIndex = 0;
+static uint64 g_HOST_uartRxNext = 0;			/* The line is free for the next frame */
+static uint64 g_HOST_uartPollNext = 0;			/* Next read of the input */
+static volatile uint8 g_HOST_uartRxData;		/* UDR of the receiver */
+static uint8 g_HOST_uartFlags = HOST_UDRE;		/* RXC, TXC and UDRE */
+static HOST_UartViewType g_HOST_uartView = HOST_UART_VIEW_TX;
+
+/* Transmitter, a write of UDR goes to the slot and is committed at the next sync */
+static volatile uint8 g_HOST_uartTxSlot;
+static boolean g_HOST_uartTxPending = FALSE;
+static uint64 g_HOST_uartTxAccess;
+static uint8 g_HOST_uartTxBuffer;
+static boolean g_HOST_uartTxFull = FALSE;
+static uint64 g_HOST_uartShiftEnd = 0;			/* The shift register is free */
+
+static uint8 g_HOST_uartUbrrh = 0;
+static uint8 g_HOST_uartUcsrc = 0x06;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HOST_uartInit(void);
+static void HOST_uartSync(void);
+static uint64 HOST_uartNext(void);
+static void HOST_uartEvent(void);
+static volatile uint8 *HOST_uartData(uint8 address);
+static volatile uint8 *HOST_uartStatus(uint8 address);
+static void HOST_uartWriteStatus(uint8 address, uint8 old_value, uint8 new_value);
+static volatile uint8 *HOST_uartReadUbrrh(uint8 address);
+static void HOST_uartWriteUbrrh(uint8 address, uint8 old_value, uint8 new_value);
+static int HOST_uartOpen(const char *a_config, int flags, int standard);
+static uint64 HOST_uartFrameTime(void);
+static void HOST_uartShow(void);
+static void HOST_uartCommit(void);
+static void HOST_uartSend(uint8 data);
+static void HOST_uartReceive(const char *a_args);
+
+const HOST_ModelType g_HOST_uartModel = {HOST_uartInit, HOST_uartSync, HOST_uartNext, HOST_uartEvent};
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartInit
+ * [DESCRIPTION]:	This Function is used to open the line and set the hooks of the UART.
+ * 					HOST_UART_IN and HOST_UART_OUT are a file descriptor number or a path,
+ * 					the standard input and output by default. With "control" the line is
+ * 					the control channel: the bytes sent are reported as "tx <byte>" and the
+ * 					bytes are received by the "rx <cycle> <byte>" command, where the cycle
+ * 					is the end of the frame
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartInit(void)
+{
+	if(strcmp(HOST_getConfig("HOST_UART_IN", "0"), "control") == 0)
+	{
+		HOST_setCommand("rx", HOST_uartReceive);
+	}
+	else
+	{
+		g_HOST_uartIn = HOST_uartOpen(HOST_getConfig("HOST_UART_IN", "0"), O_RDONLY, STDIN_FILENO);
+	}
+	if(strcmp(HOST_getConfig("HOST_UART_OUT", "1"), "control") == 0)
+	{
+		g_HOST_uartOutControl = TRUE;
+	}
+	else
+	{
+		g_HOST_uartOut = HOST_uartOpen(HOST_getConfig("HOST_UART_OUT", "1"), O_WRONLY, STDOUT_FILENO);
+	}
+	if(g_HOST_uartIn >= 0)
+	{
+		fcntl(g_HOST_uartIn, F_SETFL, fcntl(g_HOST_uartIn, F_GETFL) | O_NONBLOCK);
+	}
+
+	HOST_setHooks(HOST_UDR, HOST_uartData, NULL_PTR);
+	HOST_setHooks(HOST_UCSRA, HOST_uartStatus, HOST_uartWriteStatus);
+	HOST_setHooks(HOST_UBRRH, HOST_uartReadUbrrh, HOST_uartWriteUbrrh);
+	HOST_uartShow();
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartSync
+ * [DESCRIPTION]:	This Function is used to commit the byte written to UDR, in the tick
+ * 					only once the firmware is done with the statement that wrote it
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartSync(void)
+{
+	if((g_HOST_uartTxPending == TRUE) &&
+			((HOST_inTick() == FALSE) || ((HOST_cycles() - g_HOST_uartTxAccess) >= HOST_usToCycles(HOST_UART_COMMIT_TIME))))
+	{
+		HOST_uartCommit();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartNext
+ * [DESCRIPTION]:	This Function is used to get the cycle of the next event of the UART:
+ * 					the end of a frame of the transmitter, a frame of the receiver or a
+ * 					read of the input
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The cycle of the next event
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_uartNext(void)
+{
+	uint64 next = HOST_NEVER;
+
+	if(g_HOST_uartTxFull == TRUE)
+	{
+		next = g_HOST_uartShiftEnd;
+	}
+
+	if(HOST_getReg(HOST_UCSRB) & HOST_RXEN)
+	{
+		if(g_HOST_uartInputIndex < g_HOST_uartInputSize)
+		{
+			/* The next frame waits for the firmware to read the last one */
+			if(((g_HOST_uartFlags & HOST_RXC) == 0) && (g_HOST_uartRxNext < next))
+			{
+				next = g_HOST_uartRxNext;
+				if(g_HOST_uartInputTime[g_HOST_uartInputIndex] > next)
+				{
+					next = g_HOST_uartInputTime[g_HOST_uartInputIndex];
+				}
+			}
+		}
+		else if((g_HOST_uartIn >= 0) && (g_HOST_uartPollNext < next))
+		{
+			next = g_HOST_uartPollNext;
+		}
+	}
+
+	return next;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartEvent
+ * [DESCRIPTION]:	This Function is used to run the due events of the UART. The input is
+ * 					not lost when the host delays the firmware, a frame is received only
+ * 					once the last one is read so DOR is never set
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartEvent(void)
+{
+	uint64 now = HOST_cycles();
+	ssize_t size;
+
+	if((g_HOST_uartTxFull == TRUE) && (now >= g_HOST_uartShiftEnd))
+	{
+		g_HOST_uartTxFull = FALSE;
+		HOST_uartSend(g_HOST_uartTxBuffer);
+		g_HOST_uartShiftEnd += HOST_uartFrameTime();
+		g_HOST_uartFlags |= HOST_UDRE;
+	}
+
+	if(g_HOST_uartInputIndex < g_HOST_uartInputSize)
+	{
+		if((now >= g_HOST_uartRxNext) && (now >= g_HOST_uartInputTime[g_HOST_uartInputIndex]) && ((g_HOST_uartFlags & HOST_RXC) == 0))
+		{
+			g_HOST_uartRxData = g_HOST_uartInput[g_HOST_uartInputIndex];
+			g_HOST_uartFlags |= HOST_RXC;
+			g_HOST_uartInputIndex++;
+			g_HOST_uartRxNext = now + HOST_uartFrameTime();
+		}
+	}
+	else if((g_HOST_uartIn >= 0) && (now >= g_HOST_uartPollNext))
+	{
+		g_HOST_uartPollNext = now + HOST_uartFrameTime();
+		size = read(g_HOST_uartIn, g_HOST_uartInput, HOST_UART_BUFFER_SIZE);
+		if(size > 0)
+		{
+			g_HOST_uartInputSize = (uint8)size;
+			g_HOST_uartInputIndex = 0;
+			memset(g_HOST_uartInputTime, 0, sizeof(g_HOST_uartInputTime));
+			if(g_HOST_uartRxNext < now)
+			{
+				g_HOST_uartRxNext = now;
+			}
+		}
+		else if((size < 0) && (errno != EAGAIN) && (errno != EINTR))
+		{
+			g_HOST_uartIn = -1;
+		}
+	}
+
+	/* A polling firmware sees the flags only through the view of UCSRA */
+	if(HOST_getReg(HOST_UCSRB) & HOST_RXCIE)
+	{
+		HOST_uartShow();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartData
+ * [DESCRIPTION]:	This Function is the read hook of UDR. The same address is the receive
+ * 					and the transmit buffer, an access is a read in the ISR of RXC or, when
+ * 					polling, after UCSRA showed RXC, else it is a write
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	The receive data or the transmit slot
+ ----------------------------------------------------------------------------------------*/
+static volatile uint8 *HOST_uartData(uint8 address)
+{
+	(void)address;
+
+	if((HOST_currentVector() == HOST_USART_RXC_VECT) ||
+			(((HOST_getReg(HOST_UCSRB) & HOST_RXCIE) == 0) && (g_HOST_uartView == HOST_UART_VIEW_RX)))
+	{
+		g_HOST_uartFlags &= (uint8)~HOST_RXC;
+		g_HOST_uartView = HOST_UART_VIEW_TX;
+		HOST_uartShow();
+		return &g_HOST_uartRxData;
+	}
+
+	if(g_HOST_uartTxPending == TRUE)
+	{
+		HOST_uartCommit();
+	}
+	g_HOST_uartTxPending = TRUE;
+	g_HOST_uartTxAccess = HOST_cycles();
+
+	return &g_HOST_uartTxSlot;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartStatus
+ * [DESCRIPTION]:	This Function is the read hook of UCSRA. When polling with both RXC and
+ * 					UDRE set, it shows them in turns so the next access of UDR is known
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	NULL_PTR, the access uses the register
+ ----------------------------------------------------------------------------------------*/
+static volatile uint8 *HOST_uartStatus(uint8 address)
+{
+	uint8 flags = g_HOST_uartFlags;
+
+	(void)address;
+
+	if(HOST_getReg(HOST_UCSRB) & HOST_RXCIE)
+	{
+		HOST_uartShow();
+		return NULL_PTR;
+	}
+
+	if((flags & HOST_RXC) && ((flags & HOST_UDRE) == 0))
+	{
+		g_HOST_uartView = HOST_UART_VIEW_RX;
+	}
+	else if((flags & HOST_RXC) && (g_HOST_uartView == HOST_UART_VIEW_TX))
+	{
+		g_HOST_uartView = HOST_UART_VIEW_RX;
+		flags &= (uint8)~HOST_UDRE;
+	}
+	else
+	{
+		g_HOST_uartView = HOST_UART_VIEW_TX;
+		flags &= (uint8)~HOST_RXC;
+	}
+	HOST_setReg(HOST_UCSRA, flags | (HOST_getReg(HOST_UCSRA) & (HOST_U2X | HOST_MPCM)));
+
+	return NULL_PTR;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartWriteStatus
+ * [DESCRIPTION]:	This Function is the write hook of UCSRA, U2X and MPCM are written and
+ * 					TXC is cleared by writing one to it
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the value before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartWriteStatus(uint8 address, uint8 old_value, uint8 new_value)
+{
+	(void)address;
+
+	if((new_value & HOST_TXC) && ((old_value & HOST_TXC) == 0))
+	{
+		g_HOST_uartFlags &= (uint8)~HOST_TXC;
+	}
+	HOST_setReg(HOST_UCSRA, (old_value & (uint8)~(HOST_U2X | HOST_MPCM)) | (new_value & (HOST_U2X | HOST_MPCM)));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartReadUbrrh
+ * [DESCRIPTION]:	This Function is the read hook of UBRRH, a single read gives UBRRH and
+ * 					not UCSRC as on the ATmega16
+ * [ARGS]:		uint8 address :	This Arg shall indicate the address of the register
+ * [RETURNS]:	NULL_PTR, the access uses the register
+ ----------------------------------------------------------------------------------------*/
+static volatile uint8 *HOST_uartReadUbrrh(uint8 address)
+{
+	HOST_setReg(address, g_HOST_uartUbrrh);
+
+	return NULL_PTR;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartWriteUbrrh
+ * [DESCRIPTION]:	This Function is the write hook of UBRRH, a write with URSEL set goes
+ * 					to UCSRC
+ * [ARGS]:		uint8 address :		This Arg shall indicate the address of the register
+ * 				uint8 old_value :	This Arg shall indicate the value before the write
+ * 				uint8 new_value :	This Arg shall indicate the written value
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartWriteUbrrh(uint8 address, uint8 old_value, uint8 new_value)
+{
+	(void)address;
+	(void)old_value;
+
+	if(new_value & HOST_URSEL)
+	{
+		g_HOST_uartUcsrc = new_value & (uint8)~HOST_URSEL;
+	}
+	else
+	{
+		g_HOST_uartUbrrh = new_value & 0x0F;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartOpen
+ * [DESCRIPTION]:	This Function is used to open a side of the line
+ * [ARGS]:		const char *a_config :	This Arg shall indicate a descriptor number or a path
+ * 				int flags :				This Arg shall indicate the flags to open the path
+ * 				int standard :			This Arg shall indicate the standard descriptor
+ * [RETURNS]:	The file descriptor, -1 if it can not be opened
+ ----------------------------------------------------------------------------------------*/
+static int HOST_uartOpen(const char *a_config, int flags, int standard)
+{
+	const char *digit = a_config;
+
+	while(isdigit((unsigned char)*digit))
+	{
+		digit++;
+	}
+	if(*digit == '\0')
+	{
+		return atoi(a_config);
+	}
+	if((a_config[0] == '-') && (a_config[1] == '\0'))
+	{
+		return standard;
+	}
+
+	/* A FIFO is opened for reading without waiting for its writer */
+	return open(a_config, (flags == O_RDONLY) ? (O_RDONLY | O_NONBLOCK) : (flags | O_CREAT), 0644);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartFrameTime
+ * [DESCRIPTION]:	This Function is used to get the time of a frame from UBRR, U2X and the
+ * 					frame format of UCSRC
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The time of a frame in CPU cycles
+ ----------------------------------------------------------------------------------------*/
+static uint64 HOST_uartFrameTime(void)
+{
+	uint16 ubrr = ((uint16)g_HOST_uartUbrrh << 8) | HOST_getReg(HOST_UBRRL);
+	uint8 bits = 1 + 5 + ((g_HOST_uartUcsrc & HOST_UCSZ) >> 1);
+
+	if(HOST_getReg(HOST_UCSRB) & HOST_UCSZ2)
+	{
+		bits = 1 + 9;
+	}
+	bits += (g_HOST_uartUcsrc & HOST_UPM1) ? 1 : 0;
+	bits += (g_HOST_uartUcsrc & HOST_USBS) ? 2 : 1;
+
+	return (uint64)bits * ((HOST_getReg(HOST_UCSRA) & HOST_U2X) ? 8 : 16) * (ubrr + 1);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartShow
+ * [DESCRIPTION]:	This Function is used to show all the flags in UCSRA
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartShow(void)
+{
+	if((g_HOST_uartTxFull == FALSE) && (HOST_cycles() >= g_HOST_uartShiftEnd) && (g_HOST_uartShiftEnd != 0))
+	{
+		g_HOST_uartFlags |= HOST_TXC;
+		g_HOST_uartShiftEnd = 0;
+	}
+	HOST_setReg(HOST_UCSRA, g_HOST_uartFlags | (HOST_getReg(HOST_UCSRA) & (HOST_U2X | HOST_MPCM)));
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartCommit
+ * [DESCRIPTION]:	This Function is used to give the byte of the transmit slot to the
+ * 					transmitter, it is lost when the transmitter is disabled
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartCommit(void)
+{
+	uint64 now = HOST_cycles();
+
+	g_HOST_uartTxPending = FALSE;
+	if((HOST_getReg(HOST_UCSRB) & HOST_TXEN) == 0)
+	{
+		return;
+	}
+
+	if(now >= g_HOST_uartShiftEnd)
+	{
+		HOST_uartSend(g_HOST_uartTxSlot);
+		g_HOST_uartShiftEnd = now + HOST_uartFrameTime();
+	}
+	else
+	{
+		g_HOST_uartTxBuffer = g_HOST_uartTxSlot;
+		g_HOST_uartTxFull = TRUE;
+		g_HOST_uartFlags &= (uint8)~HOST_UDRE;
+	}
+	g_HOST_uartFlags &= (uint8)~HOST_TXC;
+	if(HOST_getReg(HOST_UCSRB) & HOST_RXCIE)
+	{
+		HOST_uartShow();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartSend
+ * [DESCRIPTION]:	This Function is used to put a byte on the line
+ * [ARGS]:		uint8 data :	This Arg shall indicate the byte
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartSend(uint8 data)
+{
+	if(g_HOST_uartOutControl == TRUE)
+	{
+		HOST_report("tx %u", data);
+	}
+	else if(g_HOST_uartOut >= 0)
+	{
+		while((write(g_HOST_uartOut, &data, 1) < 0) && ((errno == EINTR) || (errno == EAGAIN)))
+		{
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HOST_uartReceive
+ * [DESCRIPTION]:	This Function is the handler of the "rx <cycle> <byte>" command, the byte
+ * 					is received at the end of its frame on the line or, if the receiver is
+ * 					still busy, after the bytes before it
+ * [ARGS]:		const char *a_args :	This Arg shall indicate the cycle and the byte
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HOST_uartReceive(const char *a_args)
+{
+	char *data;
+	uint64 cycle = strtoull(a_args, &data, 10);
+
+	if(g_HOST_uartInputIndex == g_HOST_uartInputSize)
+	{
+		g_HOST_uartInputIndex = 0;
+		g_HOST_uartInputSize = 0;
+	}
+	if(g_HOST_uartInputSize < HOST_UART_BUFFER_SIZE)
+	{
+		g_HOST_uartInput[g_HOST_uartInputSize] = (uint8)strtoul(data, NULL_PTR, 10);
+		g_HOST_uartInputTime[g_HOST_uartInputSize] = cycle;
+		g_HOST_uartInputSize++;
+	}
+}
@@ -0,0 +1,142 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<trace_decode.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the decoder of the binary trace of an MCU, it turns
+ * 					the bytes of the TX pin of the trace into a timeline. It is built once
+ * 					for each MCU with the events of its trace.h>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "std_types.h"
+#include "trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define DECODE_TEXT_SIZE		128
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+#define TRACE_NAME(id, text)	[id] = #id,
+#define TRACE_TEXT(id, text)	[id] = text,
+
+static const char * const g_DECODE_names[TRACE_NUM_OF_EVENTS] = {TRACE_EVENTS(TRACE_NAME)};
+static const char * const g_DECODE_texts[TRACE_NUM_OF_EVENTS] = {TRACE_EVENTS(TRACE_TEXT)};
+
+#undef TRACE_NAME
+#undef TRACE_TEXT
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void DECODE_print(uint64 time, const uint8 *a_framePtr);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	main
+ * [DESCRIPTION]:	This Function is used to read the trace from a file or the standard input
+ * 					and print its events. The frames are found by their sync byte and check,
+ * 					so a dump that starts in the middle of a frame or lost bytes only skip
+ * 					the broken frames. The 16-bit time is unwrapped, which needs an event at
+ * 					least every 65 s
+ * [ARGS]:		int argc :		This Arg shall indicate the number of arguments
+ * 				char **argv :	This Arg shall indicate the file of the trace, "-" or none for
+ * 								the standard input
+ * [RETURNS]:	0 if the trace is read, else 1
+ ----------------------------------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+	FILE *input = stdin;
+	uint8 frame[TRACE_FRAME_SIZE];
+	uint8 size = 0;
+	uint8 check;
+	uint16 last = 0;
+	uint64 time = 0;
+	uint32 skipped = 0;
+	uint32 events = 0;
+	uint8 i;
+	int byte;
+
+	if(argc > 2)
+	{
+		fprintf(stderr, "usage: %s [trace]\n", argv[0]);
+		return 1;
+	}
+	if((argc == 2) && (strcmp(argv[1], "-") != 0))
+	{
+		input = fopen(argv[1], "rb");
+		if(input == NULL_PTR)
+		{
+			perror(argv[1]);
+			return 1;
+		}
+	}
+
+	while((byte = fgetc(input)) != EOF)
+	{
+		if((size == 0) && (byte != TRACE_SYNC))
+		{
+			skipped++;
+			continue;
+		}
+		frame[size++] = (uint8)byte;
+		if(size < TRACE_FRAME_SIZE)
+		{
+			continue;
+		}
+
+		check = 0;
+		for(i = 1; i < (TRACE_FRAME_SIZE - 1); i++)
+		{
+			check ^= frame[i];
+		}
+		if((check != frame[TRACE_FRAME_SIZE - 1]) || (frame[1] >= TRACE_NUM_OF_EVENTS))
+		{
+			/* The sync was a byte of a broken frame, the search goes on after it */
+			for(i = 1; (i < TRACE_FRAME_SIZE) && (frame[i] != TRACE_SYNC); i++)
+			{
+			}
+			skipped += i;
+			size = TRACE_FRAME_SIZE - i;
+			memmove(frame, &frame[i], size);
+			continue;
+		}
+
+		time += (uint16)((frame[2] | (frame[3] << 8)) - last);
+		last = (uint16)(frame[2] | (frame[3] << 8));
+		DECODE_print(time, frame);
+		events++;
+		size = 0;
+	}
+
+	skipped += size;
+	printf("%u events, %u bytes skipped\n", events, skipped);
+	if(input != stdin)
+	{
+		fclose(input);
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DECODE_print
+ * [DESCRIPTION]:	This Function is used to print a line of the timeline
+ * [ARGS]:		uint64 time :				This Arg shall indicate the unwrapped time in ms
+ * 				const uint8 *a_framePtr :	This Arg shall indicate the checked frame
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void DECODE_print(uint64 time, const uint8 *a_framePtr)
+{
+	char text[DECODE_TEXT_SIZE];
+	uint8 id = a_framePtr[1];
+
+	snprintf(text, sizeof(text), g_DECODE_texts[id], a_framePtr[4], a_framePtr[5]);
+	printf("%6llu.%03u  %-22s %s\n", (unsigned long long)(time / 1000), (unsigned)(time % 1000), g_DECODE_names[id], text);
+}
@@ -0,0 +1,21 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<delay.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<The <util/delay.h> of the host HAL, the delays wait on the
+ * 					clock of the HAL while its models and interrupts run>
+ ---------------------------------------------------------------------------*/
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+
+/* Defined in host.c */
+void _delay_ms(double msec);
+void _delay_us(double usec);
+
+#endif /* HOST_UTIL_DELAY_H_ */
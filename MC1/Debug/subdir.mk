@@ -5,29 +5,44 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../app1.c \
+../cipher.c \
 ../gpio.c \
 ../keypad.c \
 ../lcd.c \
+../link.c \
 ../mc1.c \
+../prof.c \
+../systick.c \
 ../timer.c \
+../trace.c \
 ../uart.c 
 
 OBJS += \
 ./app1.o \
+./cipher.o \
 ./gpio.o \
 ./keypad.o \
 ./lcd.o \
+./link.o \
 ./mc1.o \
+./prof.o \
+./systick.o \
 ./timer.o \
+./trace.o \
 ./uart.o 
 
 C_DEPS += \
 ./app1.d \
+./cipher.d \
 ./gpio.d \
 ./keypad.d \
 ./lcd.d \
+./link.d \
 ./mc1.d \
+./prof.d \
+./systick.d \
 ./timer.d \
+./trace.d \
 ./uart.d 
 
 
@@ -35,7 +50,7 @@ C_DEPS += \
 %.o: ../%.c subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
-	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=1000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	avr-gcc -Wall -g2 -gstabs -Os -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=1000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -14,17 +14,100 @@
 
 #include "uart.h"
 #include <util/delay.h>
-#include "timer.h"
+#include <avr/pgmspace.h>
+#include <avr/eeprom.h>
+#include "systick.h"
+#include "prof.h"
+#include "trace.h"
+#include "cipher.h"
+#include "link.h"
 
 #include "keypad.h"
 #include "lcd.h"
 
 #include "uart_commands.h"
 
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* A row of a transition table, when the key is received the command is sent to
+ * mC2 (if any) then the action is run */
+typedef struct
+{
+	uint8 key;					/* State received from mC2 or key pressed by the user */
+	uint8 command;				/* Command sent to mC2, APP1_NO_COMMAND to send nothing */
+	void (*action)(void);		/* Function that handles the key, NULL_PTR for nothing */
+}APP1_TransitionType;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void APP1_openMainMenu(void);
+static void APP1_doorProgress(void);
+static void APP1_lockoutTime(void);
+static void APP1_profileDump(void);
+static uint8 APP1_getKey(void);
+static void APP1_readPassword(void);
+static void APP1_connect(void);
+static void APP1_recover(void);
+static void APP1_respond(void);
+static void APP1_sendRequest(uint8 command, const uint8 *a_payloadPtr, uint8 size);
+static void APP1_repeatRequest(void);
+static uint32 APP1_takeNonce(void);
+static void APP1_reserveNonces(void);
+static void APP1_runTransition(const APP1_TransitionType *a_table, uint8 size, uint8 key);
+
 /*------------------------------------GLOBAL VARIABLES----------------------------------*/
 
-/* A flag used for the Timer1 */
-uint8 TIMER1_flagComplete = 0;
+/* Boots of mC1, each boot reserves the 65536 nonces that start with its count so a
+ * nonce is never used twice with the key after a reset */
+static uint16 g_APP1_bootCount EEMEM;
+static uint32 g_APP1_nonce;
+
+/* The message being received from mC2 */
+static LINK_FrameType g_APP1_frame;
+
+/* The command sent before a password, the password frame repeats it */
+static uint8 g_APP1_command;
+
+/* The last message that waits for an answer of mC2, it is sent again in a new
+ * session as it may be lost with the old one */
+static LINK_FrameType g_APP1_request;
+
+/* The states sent from mC2, the number of password attempts is counted by mC2 so
+ * one row is enough for each password flow */
+static const APP1_TransitionType g_APP1_states[] PROGMEM =
+{
+	{ASK_FOR_NEW_PASSWORD,				RECEIVE_NEWEST_PASSWORD,		APP1_enterNewPassword},
+	{NEWEST_PASSWORD_RECEIVED,			RECEIVE_RE_ENTERED_PASSWORD,	APP1_re_enterPassword},
+	{RE_ENTER_PASSWORD,					RECEIVE_RE_ENTERED_PASSWORD,	APP1_re_enterPassword},
+	{ENTER_PASSWORD_AGAIN,				RECEIVE_RE_ENTERED_PASSWORD,	APP1_re_enterPassword},
+	{ENTER_PASSWORD_AGAIN_MAIN_MENU,	RECEIVE_PASSWORD_IN_MAIN_MENU,	APP1_re_enterPassword},
+	{OPEN_MAIN_MENU,					APP1_NO_COMMAND,				APP1_openMainMenu},
+	{OPEN_DOOR,							APP1_NO_COMMAND,				APP1_openDoor},
+	{DOOR_IS_OPENED,					APP1_NO_COMMAND,				APP1_doorIsOpened},
+	{CLOSE_DOOR,						APP1_NO_COMMAND,				APP1_closeDoor},
+	{DOOR_PROGRESS,						APP1_NO_COMMAND,				APP1_doorProgress},
+	{DOOR_STALLED,						APP1_NO_COMMAND,				APP1_doorStalled},
+	{ALARM_ON,							APP1_NO_COMMAND,				APP1_setAlarmON},
+	{LOCKOUT_TIME,						APP1_NO_COMMAND,				APP1_lockoutTime},
+	{SEND_CORRECT,						APP1_NO_COMMAND,				APP1_displayCorrect},
+	{SEND_WRONG,						APP1_NO_COMMAND,				APP1_displayWrong},
+	{PROFILE_DUMP,						APP1_NO_COMMAND,				APP1_profileDump}
+};
+
+/* The options of the main menu */
+static const APP1_TransitionType g_APP1_menu[] PROGMEM =
+{
+	/* If the user chose '+', start the password enter and check process again */
+	{'+',	RECEIVE_PASSWORD_IN_MAIN_MENU,	APP1_re_enterPassword},
+	/* If the user chose '-', we will repeat the process from the very beginning */
+	{'-',	RECEIVE_NEWEST_PASSWORD,		APP1_enterNewPassword}
+};
+
+/* TRUE while the door is moving, the keypad is scanned for the re-open and abort keys */
+static boolean g_APP1_doorActive = FALSE;
+
+/* The last state shown from mC2, the progress of the door is not kept */
+static uint8 g_APP1_state;
 
 /*---------------------------------FUNCTIONS DEFINITIONS--------------------------------*/
 /*---------------------------------------------------------------------------------------
@@ -36,12 +119,8 @@ uint8 TIMER1_flagComplete = 0;
  ----------------------------------------------------------------------------------------*/
 void APP1_init(void)
 {
-	/* As we're using a prescalar of 64, then every count takes 8 u.sec,
-	 * so we need 125 counts to get 1 millisecond */
-
-	TIMER_ConfigType TIMER1_config = {TIMER1,0,0,CTC_T1,CHANNEL_A,FCPU_64_T1,0,0,0,125};
-	TIMER_init(&TIMER1_config);
-	TIMER1_setCallBack(TIMER1_countProcessing);
+	/* Timer1 is the 1 kHz system tick shared by all the timeouts of the application */
+	SYSTICK_init();
 
 	/*
 	 * UART configuration :
@@ -53,8 +132,20 @@ void APP1_init(void)
 	UART_configType UART_config = {OFF, EIGHT, ONE, 19200};
 	UART_init(&UART_config);
 
+	/* The trace has its own pin, the UART carries the link */
+	TRACE_INIT();
+
 	/* Initializing the LCD driver */
 	LCD_init();
+
+	/* The round keys of the link cipher are expanded once */
+	CIPHER_init();
+	APP1_reserveNonces();
+
+	/* No state of mC2 is taken before the session is opened */
+	LINK_init(LINK_MC1);
+	APP1_connect();
+	APP1_sendRequest(STATE_REQUEST, NULL_PTR, 0);
 }
 
 
@@ -70,44 +161,89 @@ void APP1_enterNewPassword(void)
 	LCD_clearScreen();
 	LCD_displayString("Enter New Pass:");
 	LCD_moveCursor(1,0);
+	APP1_readPassword();
+}
 
-	/*
-	 * Get the password entered until the user press Enter key
-	 * if Enter key is pressed, set a # symbol at the end the
-	 * send it by UART
-	 */
-	uint8 password[PASSWORD_SIZE];
-	for(uint8 i=0; i<PASSWORD_SIZE; i++)
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_stateCheck
+ * [DESCRIPTION]:	This Function is used to check for the state received from mC2. When
+ * 					no state comes for APP1_REPLY_TIME or the session is lost, a new
+ * 					session is opened and the last request is sent again
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+uint8 APP1_stateCheck(void)
+{
+	LINK_StatusType status;
+	uint32 start = SYSTICK_millis();
+	uint8 key;
+
+	do
 	{
-		_delay_ms(KEYPAD_DELAY);
-		if(KEYPAD_getPressedKey() != ENTER_KEY)
+		while(UART_isDataAvailable() == FALSE)
 		{
-			password[i] = KEYPAD_getPressedKey();
-			/* delay function for the keypad */
-			_delay_ms(KEYPAD_DELAY);
-			LCD_displayCharacter('*');
+			/* While the door is moving the user can open it again or stop it */
+			if(g_APP1_doorActive == TRUE)
+			{
+				key = KEYPAD_scanKey();
+				if((key == APP1_REOPEN_KEY) || (key == APP1_ABORT_KEY))
+				{
+					APP1_sendCommand((key == APP1_REOPEN_KEY) ? DOOR_REOPEN : DOOR_ABORT);
+
+					/* Wait for the key to be released to send the command once */
+					while(KEYPAD_scanKey() != KEYPAD_NO_KEY){}
+				}
+			}
+
+			/* mC2 is never silent that long while mC1 waits for a state */
+			if((SYSTICK_millis() - start) >= APP1_REPLY_TIME)
+			{
+				APP1_recover();
+				start = SYSTICK_millis();
+			}
+			TRACE_DRAIN();
 		}
-		else if(KEYPAD_getPressedKey() == ENTER_KEY)
+
+		/* Receive states from mC2, forged and replayed frames are dropped */
+		status = LINK_receive(UART_receiveByte(), &g_APP1_frame);
+
+		/* mC2 starts a new session after its reset or after rejected frames */
+		if((status == LINK_PLAIN) && (g_APP1_frame.command == LINK_CHALLENGE))
 		{
-			password[i] = '#';
-			UART_sendString(password);
-			break;
+			APP1_respond();
+			APP1_repeatRequest();
+			status = LINK_BUSY;
 		}
-	}
-	UART_sendString(password);
+		else if(status == LINK_LOST)
+		{
+			APP1_recover();
+			start = SYSTICK_millis();
+		}
+	}while((status != LINK_FRAME) && (status != LINK_PLAIN));
+	PROF_END(PROF_UART_ROUND_TRIP);
+	TRACE(TRACE_APP1_STATE, g_APP1_frame.command, 0);
+
+	return g_APP1_frame.command;
 }
 
 
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP1_stateCheck
- * [DESCRIPTION]:	This Function is used to check for the state received from mC2
- * [ARGS]:		No Arguments
+ * [FUNCTION NAME]:	APP1_handleState
+ * [DESCRIPTION]:	This Function is used to handle a state received from mC2 using the
+ * 					states table
+ * [ARGS]:		uint8 state :	This Arg shall indicate the state received from mC2
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-uint8 APP1_stateCheck(void)
+void APP1_handleState(uint8 state)
 {
-	/* Receive states from mC2 */
-	return UART_receiveByte();
+	/* The door actions set it again while the door is moving */
+	g_APP1_doorActive = FALSE;
+	if(state != DOOR_PROGRESS)
+	{
+		g_APP1_state = state;
+	}
+	APP1_runTransition(g_APP1_states, sizeof(g_APP1_states) / sizeof(g_APP1_states[0]), state);
 }
 
 
@@ -120,7 +256,8 @@ uint8 APP1_stateCheck(void)
 void APP1_sendCommand(uint8 command)
 {
 	/* Send Commands to mC2 */
-	UART_sendByte(command);
+	g_APP1_command = command;
+	LINK_send(command, NULL_PTR, 0);
 }
 
 /*---------------------------------------------------------------------------------------
@@ -135,30 +272,7 @@ void APP1_re_enterPassword(void)
 	LCD_clearScreen();
 	LCD_displayString("Re-enter Pass:");
 	LCD_moveCursor(1,0);
-
-	/*
-	 * Get the re-entered password entered until the user press Enter key
-	 * if Enter key is pressed, set a # symbol at the end the
-	 * send it by UART
-	 */
-	uint8 re_password[PASSWORD_SIZE];
-	for(uint8 i=0; i<PASSWORD_SIZE; i++)
-	{
-		_delay_ms(KEYPAD_DELAY);
-		if(KEYPAD_getPressedKey() != ENTER_KEY)
-		{
-			re_password[i] = KEYPAD_getPressedKey();
-			_delay_ms(KEYPAD_DELAY);
-			LCD_displayCharacter('*');
-		}
-		else if(KEYPAD_getPressedKey() == ENTER_KEY)
-		{
-			re_password[i] = '#';
-			UART_sendString(re_password);
-			break;
-		}
-	}
-	UART_sendString(re_password);
+	APP1_readPassword();
 }
 
 /*---------------------------------------------------------------------------------------
@@ -174,9 +288,9 @@ uint8 APP1_mainOptionMenu(void)
 	LCD_clearScreen();
 	LCD_displayStringRowColumn("+: Open Door",0 ,0);
 	LCD_displayStringRowColumn("-: Change Pass",1 ,0);
-	_delay_ms(KEYPAD_DELAY);
-	choice = KEYPAD_getPressedKey();
-	_delay_ms(KEYPAD_DELAY);
+	SYSTICK_delay_ms(KEYPAD_DELAY);
+	choice = APP1_getKey();
+	SYSTICK_delay_ms(KEYPAD_DELAY);
 	return choice;
 }
 
@@ -190,6 +304,7 @@ void APP1_openDoor(void)
 {
 	LCD_clearScreen();
 	LCD_displayString("Door OPENING...");
+	g_APP1_doorActive = TRUE;
 }
 
 /*---------------------------------------------------------------------------------------
@@ -202,6 +317,7 @@ void APP1_doorIsOpened(void)
 {
 	LCD_clearScreen();
 	LCD_displayString(" Door is OPENED");
+	g_APP1_doorActive = TRUE;
 }
 
 /*---------------------------------------------------------------------------------------
@@ -214,6 +330,22 @@ void APP1_closeDoor(void)
 {
 	LCD_clearScreen();
 	LCD_displayString("Door CLOSING...");
+	g_APP1_doorActive = TRUE;
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_doorStalled
+ * [DESCRIPTION]:	This Function is used to display that the Door stopped before the end
+ * 					of its travel
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void APP1_doorStalled(void)
+{
+	LCD_clearScreen();
+	LCD_displayString("Door STALLED!");
+	SYSTICK_delay_ms(APP1_MESSAGE_DISPLAY_TIME);
 }
 
 
@@ -240,8 +372,8 @@ void APP1_displayCorrect(void)
 {
 	LCD_clearScreen();
 	LCD_displayString("Password Correct");
-	_delay_ms(5000);
-	UART_sendByte(SEND_CORRECT);
+	SYSTICK_delay_ms(APP1_MESSAGE_DISPLAY_TIME);
+	APP1_sendRequest(SEND_CORRECT, NULL_PTR, 0);
 }
 
 
@@ -255,39 +387,306 @@ void APP1_displayWrong(void)
 {
 	LCD_clearScreen();
 	LCD_displayString("Password Wrong!");
-	_delay_ms(5000);
-	UART_sendByte(SEND_WRONG);
+	SYSTICK_delay_ms(APP1_MESSAGE_DISPLAY_TIME);
+	APP1_sendRequest(SEND_WRONG, NULL_PTR, 0);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_openMainMenu
+ * [DESCRIPTION]:	This Function is used to display the main menu and handle the choice
+ * 					of the user using the menu table
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_openMainMenu(void)
+{
+	uint8 choice = APP1_mainOptionMenu();
+
+	APP1_runTransition(g_APP1_menu, sizeof(g_APP1_menu) / sizeof(g_APP1_menu[0]), choice);
 }
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_doorProgress
+ * [DESCRIPTION]:	This Function is used to take the position of the door from the frame of
+ * 					mC2 and display it in percent under the door message, the door phase
+ * 					is shown again first when mC1 missed it
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_doorProgress(void)
+{
+	uint8 percent = g_APP1_frame.payload[0];
+	uint8 state = g_APP1_frame.payload[1];
+
+	if(g_APP1_frame.size < 2)
+	{
+		return;
+	}
+
+	/* The frame that started the door phase was lost, the phase is shown first */
+	if((state != g_APP1_state) && (state != DOOR_PROGRESS))
+	{
+		APP1_handleState(state);
+	}
+
+	LCD_moveCursor(1,0);
+	LCD_displayNumber(percent, 3, LCD_ALIGN_RIGHT, ' ');
+	LCD_displayCharacter('%');
+	g_APP1_doorActive = TRUE;
+}
+
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	TIMER1_countProcessing
- * [DESCRIPTION]:	This Function is used to count ticks for Timer1 driver, the function
- * 					will set the Timer1 flag to 1 if the ticks are equal to the input
- * 					milliseconds
+ * [FUNCTION NAME]:	APP1_lockoutTime
+ * [DESCRIPTION]:	This Function is used to take the seconds left of the lockout from the
+ * 					frame of mC2 and display them under the alarm message
  * [ARGS]:		No Arguments
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void TIMER1_countProcessing(uint16 g_msec1)
+static void APP1_lockoutTime(void)
 {
-	g_tick1++;
-	if(g_tick1 == g_msec1)
+	uint16 seconds = g_APP1_frame.payload[0] | ((uint16)g_APP1_frame.payload[1] << 8);
+
+	if(g_APP1_frame.size < 2)
+	{
+		return;
+	}
+
+	LCD_moveCursor(1,0);
+	LCD_displayString("Wait ");
+	LCD_displayNumber(seconds, 5, LCD_ALIGN_RIGHT, ' ');
+	LCD_displayString(" s");
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_profileDump
+ * [DESCRIPTION]:	This Function is used to send the profiling records, PROF_DUMP is a
+ * 					macro so it can not be put in the states table directly
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_profileDump(void)
+{
+	PROF_DUMP();
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_runTransition
+ * [DESCRIPTION]:	This Function is used to search a transition table saved in the flash
+ * 					for a key then send its command and run its action. Unknown keys
+ * 					are ignored
+ * [ARGS]:		const APP1_TransitionType *a_table :	This Arg shall indicate the table
+ * 				uint8 size :	This Arg shall indicate the number of rows of the table
+ * 				uint8 key :		This Arg shall indicate the key to search for
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_runTransition(const APP1_TransitionType *a_table, uint8 size, uint8 key)
+{
+	uint8 i;
+	uint8 command;
+	void (*action)(void);
+
+	for(i = 0; i < size; i++)
+	{
+		if(pgm_read_byte(&a_table[i].key) == key)
+		{
+			command = pgm_read_byte(&a_table[i].command);
+			action = (void (*)(void))pgm_read_ptr(&a_table[i].action);
+
+			if(command != APP1_NO_COMMAND)
+			{
+				APP1_sendCommand(command);
+			}
+			if(action != NULL_PTR)
+			{
+				(*action)();
+			}
+			return;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_getKey
+ * [DESCRIPTION]:	This Function is used to wait for a key press then tell mC2 to beep,
+ * 					the beep is played by mC2 without delaying the keypad
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The pressed key
+ ----------------------------------------------------------------------------------------*/
+static uint8 APP1_getKey(void)
+{
+	uint8 key = KEYPAD_getPressedKey();
+
+	LINK_send(KEY_PRESSED, NULL_PTR, 0);
+	return key;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_readPassword
+ * [DESCRIPTION]:	This Function is used to get the password entered until the user press
+ * 					Enter key then send it to mC2. The keys after the maximum size are not
+ * 					taken. The payload of the frame is the size of the password, the nonce
+ * 					(least significant byte first) and the password encrypted in the CTR
+ * 					mode, its command is the command sent before the password
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_readPassword(void)
+{
+	uint8 frame[CIPHER_NONCE_SIZE + PASSWORD_SIZE];
+	uint8 *password = &frame[CIPHER_NONCE_SIZE + 1];
+	uint8 size = 0;
+	uint8 key;
+	uint32 nonce;
+	uint8 i;
+
+	do
+	{
+		SYSTICK_delay_ms(KEYPAD_DELAY);
+		key = APP1_getKey();
+		if((key != ENTER_KEY) && (size < (PASSWORD_SIZE - 1)))
+		{
+			password[size] = key;
+			size++;
+			PROF_BEGIN(PROF_KEY_ECHO);
+			LCD_displayCharacter('*');
+			PROF_END(PROF_KEY_ECHO);
+			/* delay function for the keypad */
+			SYSTICK_delay_ms(KEYPAD_DELAY);
+		}
+	}while(key != ENTER_KEY);
+
+	nonce = APP1_takeNonce();
+	PROF_BEGIN(PROF_PASSWORD_ENCRYPT);
+	CIPHER_ctr(nonce, password, size);
+	PROF_END(PROF_PASSWORD_ENCRYPT);
+
+	frame[0] = size;
+	for(i = 0; i < CIPHER_NONCE_SIZE; i++)
+	{
+		frame[i + 1] = (uint8)(nonce >> (8 * i));
+	}
+	APP1_sendRequest(g_APP1_command, frame, CIPHER_NONCE_SIZE + 1 + size);
+	PROF_BEGIN(PROF_UART_ROUND_TRIP);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_connect
+ * [DESCRIPTION]:	This Function is used to close the session and ask mC2 for a new one
+ * 					until it answers with a challenge, mC2 may start after mC1
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_connect(void)
+{
+	uint32 start;
+
+	TRACE(TRACE_APP1_CONNECT, 0, 0);
+	do
+	{
+		LINK_hello();
+		start = SYSTICK_millis();
+		while((LINK_isOpen() == FALSE) && ((SYSTICK_millis() - start) < APP1_HELLO_TIME))
+		{
+			if((UART_isDataAvailable() == TRUE) &&
+					(LINK_receive(UART_receiveByte(), &g_APP1_frame) == LINK_PLAIN) &&
+					(g_APP1_frame.command == LINK_CHALLENGE))
+			{
+				APP1_respond();
+			}
+			TRACE_DRAIN();
+		}
+	}while(LINK_isOpen() == FALSE);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_recover
+ * [DESCRIPTION]:	This Function is used to open a new session when the link is lost and
+ * 					send the last request again in it
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_recover(void)
+{
+	APP1_connect();
+	APP1_repeatRequest();
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_respond
+ * [DESCRIPTION]:	This Function is used to open the session of the received challenge
+ * 					with a fresh nonce
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_respond(void)
+{
+	LINK_respond(APP1_takeNonce(), &g_APP1_frame);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_sendRequest
+ * [DESCRIPTION]:	This Function is used to send a message that waits for an answer of
+ * 					mC2 and keep it to be sent again in a new session
+ * [ARGS]:		uint8 command :				This Arg shall indicate the command
+ * 				const uint8 *a_payloadPtr :	This Arg shall indicate the payload
+ * 				uint8 size :				This Arg shall indicate the size of the payload
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_sendRequest(uint8 command, const uint8 *a_payloadPtr, uint8 size)
+{
+	uint8 i;
+
+	g_APP1_request.command = command;
+	g_APP1_request.size = size;
+	for(i = 0; i < size; i++)
+	{
+		g_APP1_request.payload[i] = a_payloadPtr[i];
+	}
+	LINK_send(command, a_payloadPtr, size);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_repeatRequest
+ * [DESCRIPTION]:	This Function is used to send the last request again, mC2 answers a
+ * 					request it already took with its state
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP1_repeatRequest(void)
+{
+	LINK_send(g_APP1_request.command, g_APP1_request.payload, g_APP1_request.size);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP1_takeNonce
+ * [DESCRIPTION]:	This Function is used to take the next nonce, a new boot count is
+ * 					reserved when the nonces of this one are used up
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The nonce
+ ----------------------------------------------------------------------------------------*/
+static uint32 APP1_takeNonce(void)
+{
+	uint32 nonce = g_APP1_nonce;
+
+	g_APP1_nonce++;
+	if((uint16)g_APP1_nonce == 0)
 	{
-		TIMER1_flagComplete = 1;
-		g_tick1 = 0;
+		APP1_reserveNonces();
 	}
+	return nonce;
 }
 
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	TIMER1_delay_ms
- * [DESCRIPTION]:	This Function is used to give a delay process according to the give
- * 					milliseconds
+ * [FUNCTION NAME]:	APP1_reserveNonces
+ * [DESCRIPTION]:	This Function is used to count a new boot in the internal EEPROM and
+ * 					start the nonces from it
  * [ARGS]:		No Arguments
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void TIMER1_delay_ms(uint16 seconds)
+static void APP1_reserveNonces(void)
 {
-	g_tick1 = 0;
-	g_msec1 = seconds;
+	uint16 boot_count = eeprom_read_word(&g_APP1_bootCount) + 1;
 
-	while(TIMER1_flagComplete != 1){}
-	TIMER1_flagComplete = 0;
+	eeprom_update_word(&g_APP1_bootCount, boot_count);
+	g_APP1_nonce = (uint32)boot_count << 16;
 }
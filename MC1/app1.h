@@ -15,14 +15,21 @@
 
 #include "std_types.h"
 
-/*------------------------------------EXTERNS---------------------------------*/
-
-extern uint8 TIMER1_flagComplete;
-
 /*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
 
 #define PASSWORD_SIZE		7
 
+#define APP1_MESSAGE_DISPLAY_TIME	5000	/* Time in ms a result message stays on the LCD */
+
+#define APP1_REOPEN_KEY		'+'		/* Opens the door again while it is closing */
+#define APP1_ABORT_KEY		'-'		/* Stops the door where it is */
+
+#define APP1_NO_COMMAND		0x00	/* A transition that sends no command to mC2 */
+
+#define APP1_HELLO_TIME		500		/* Time in ms between two session requests to mC2 */
+#define APP1_REPLY_TIME		2000	/* Time in ms without a state of mC2 before the link is
+											 * repaired, longer than the periods of its reports */
+
 /*----------------------------FUNCTIONS PROTOTYPES----------------------------*/
 /*
  * Description:
@@ -47,6 +54,14 @@ void APP1_enterNewPassword(void);
 uint8 APP1_stateCheck(void);
 
 
+/*
+ * Description:
+ * This Function is used to handle a state received from mC2 using the
+ * states table
+ */
+void APP1_handleState(uint8 state);
+
+
 /*
  * Description:
  * This Function is used to send commands to mC2 from mC1
@@ -91,6 +106,14 @@ void APP1_doorIsOpened(void);
 void APP1_closeDoor(void);
 
 
+/*
+ * Description:
+ * This Function is used to display that the Door stopped before the end of
+ * its travel
+ */
+void APP1_doorStalled(void);
+
+
 /*
  * Description:
  * This Function is used to display that the Alarm is sent off
@@ -111,21 +134,4 @@ void APP1_displayCorrect(void);
  */
 void APP1_displayWrong(void);
 
-
-/*
- * Description:
- * This Function is used to count ticks for Timer1 driver, the function
- * will set the Timer1 flag to 1 if the ticks are equal to the input
- * milliseconds
- */
-void TIMER1_countProcessing(uint16 g_seconds1);
-
-
-/*
- * Description:
- * This Function is used to give a delay process according to the give
- * milliseconds
- */
-void TIMER1_delay_ms(uint16 seconds);
-
 #endif /* APP_H_ */
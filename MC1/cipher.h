@@ -0,0 +1,66 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<cipher.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the Speck64/128 cipher of the UART link>
+ ---------------------------------------------------------------------------*/
+
+#ifndef CIPHER_H_
+#define CIPHER_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/*
+ * Speck64/128: 64-bit blocks of two 32-bit words, 128-bit key and 27 rounds of
+ * add, rotate and xor only, which suits an 8-bit core without a barrel shifter.
+ * The key is shared by mC1 and mC2 and shall be changed for each installation,
+ * it is given as its four 32-bit words k0 to k3.
+ */
+#define CIPHER_KEY				{0x03020100UL, 0x0B0A0908UL, 0x13121110UL, 0x1B1A1918UL}
+#define CIPHER_KEY_WORDS		4
+#define CIPHER_ROUNDS			27
+#define CIPHER_BLOCK_SIZE		8
+
+/* In the CTR mode the block of a message is its 32-bit nonce and a 32-bit block
+ * counter. A nonce shall never be used twice with the same key */
+#define CIPHER_NONCE_SIZE		4
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to expand the key in the round keys, it is called
+ * once before any message is encrypted or decrypted
+ */
+void CIPHER_init(void);
+
+
+/*
+ * Description:
+ * This Function is used to encrypt one block of two words in place
+ */
+void CIPHER_encryptBlock(uint32 *a_xPtr, uint32 *a_yPtr);
+
+
+/*
+ * Description:
+ * This Function is used to encrypt or decrypt a message in place in the CTR
+ * mode, the same call with the same nonce gives back the plain message
+ */
+void CIPHER_ctr(uint32 nonce, uint8 *a_dataPtr, uint8 size);
+
+
+/*
+ * Description:
+ * This Function is used to compute the 32-bit CBC-MAC of a message from a
+ * secret initial state, the size of the message shall be in its first block
+ */
+uint32 CIPHER_mac(const uint32 *a_ivPtr, const uint8 *a_dataPtr, uint8 size);
+
+#endif /* CIPHER_H_ */
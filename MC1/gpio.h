@@ -14,6 +14,8 @@
 /*-----------------------------------INCLUDES---------------------------------*/
 
 #include "std_types.h"
+#include "common_macros.h"
+#include <avr/io.h>
 
 /*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
 
@@ -34,6 +36,49 @@
 #define PIN6_ID					6
 #define PIN7_ID					7
 
+/*
+ * Pin descriptors: a pin whose port and number are constants (PORTx_ID and
+ * PINx_ID) is accessed on its registers by these macros, the register is chosen
+ * by the preprocessor so there is no call, no check and no switch on the port.
+ * At -Os, the optimization of both AVR builds, a pin access is a single SBI,
+ * CBI or SBIS/SBIC instruction of about 2 cycles, where a call of GPIO_writePin
+ * or GPIO_readPin costs about 110 to 160 cycles in the old -O0 listing. A port
+ * or pin known only at run time shall use the functions of the driver, anything
+ * else is a compile error.
+ */
+#define GPIO_PIN_OUTPUT(port_num,pin_num)		SET_BIT(GPIO_DDR_REG(port_num),pin_num)
+#define GPIO_PIN_INPUT(port_num,pin_num)		CLEAR_BIT(GPIO_DDR_REG(port_num),pin_num)
+#define GPIO_PIN_HIGH(port_num,pin_num)			SET_BIT(GPIO_PORT_REG(port_num),pin_num)
+#define GPIO_PIN_LOW(port_num,pin_num)			CLEAR_BIT(GPIO_PORT_REG(port_num),pin_num)
+#define GPIO_PIN_WRITE(port_num,pin_num,value)	\
+	(((value) == LOGIC_HIGH) ? GPIO_PIN_HIGH(port_num,pin_num) : GPIO_PIN_LOW(port_num,pin_num))
+#define GPIO_PIN_READ(port_num,pin_num)			\
+	(BIT_IS_SET(GPIO_PIN_REG(port_num),pin_num) ? LOGIC_HIGH : LOGIC_LOW)
+
+#define GPIO_PORT_DIRECTION(port_num,direction)	(GPIO_DDR_REG(port_num) = (direction))
+#define GPIO_PORT_WRITE(port_num,value)			(GPIO_PORT_REG(port_num) = (value))
+#define GPIO_PORT_READ(port_num)				(GPIO_PIN_REG(port_num))
+
+/* The registers of a port, the ID is pasted to the name of its register */
+#define GPIO_DDR_REG(port_num)					GPIO_CONCAT(GPIO_DDR_REG_,port_num)
+#define GPIO_PORT_REG(port_num)					GPIO_CONCAT(GPIO_PORT_REG_,port_num)
+#define GPIO_PIN_REG(port_num)					GPIO_CONCAT(GPIO_PIN_REG_,port_num)
+#define GPIO_CONCAT(prefix,port_num)			GPIO_CONCAT_EXPANDED(prefix,port_num)
+#define GPIO_CONCAT_EXPANDED(prefix,port_num)	prefix##port_num
+
+#define GPIO_DDR_REG_0							DDRA
+#define GPIO_DDR_REG_1							DDRB
+#define GPIO_DDR_REG_2							DDRC
+#define GPIO_DDR_REG_3							DDRD
+#define GPIO_PORT_REG_0							PORTA
+#define GPIO_PORT_REG_1							PORTB
+#define GPIO_PORT_REG_2							PORTC
+#define GPIO_PORT_REG_3							PORTD
+#define GPIO_PIN_REG_0							PINA
+#define GPIO_PIN_REG_1							PINB
+#define GPIO_PIN_REG_2							PINC
+#define GPIO_PIN_REG_3							PIND
+
 /*-----------------------------TYPES DECLEARATION-----------------------------*/
 
 typedef enum
@@ -12,6 +12,7 @@
 #include "keypad.h"
 #include "gpio.h"
 #include "common_macros.h"
+#include "trace.h"
 
 /*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
 /* This function is used for declaration whether the used keypad is 4x3 or 4x4 */
@@ -30,51 +31,79 @@ static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
 /*---------------------------------------------------------------------------------------
  * [FUNCTION NAME]:	KEYPAD_getPressedKey
  * [DESCRIPTION]:	This Function is used to get the button number of the pressed button.
- * 					at first, it set all columns as input the change each tick only one column
- * 					as an output and read its value, if the button is pressed then the
- * 					function will return the number order of this pressed button
+ * 					it keeps scanning the keypad until a button is pressed
  * [ARGS]:			No Arguments
  *	[RETURNS]:		The function return the value of the pressed button
  ----------------------------------------------------------------------------------------*/
 uint8 KEYPAD_getPressedKey(void)
 {
-	uint8 row, col, value = 0;
-	while(1)
+	uint8 key;
+
+	do
 	{
-		for(col=0; col<KEYPAD_NUM_OF_COLS; col++)
+		key = KEYPAD_scanKey();
+		if(key == KEYPAD_NO_KEY)
 		{
-			/* First, set all the port as an Input port */
-			GPIO_setPortDirection(KEYPAD_PORT_ID, PORT_INPUT);
+			/* The trace is sent while the user does not press */
+			TRACE_DRAIN();
+		}
+	}while(key == KEYPAD_NO_KEY);
+
+	return key;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	KEYPAD_scanKey
+ * [DESCRIPTION]:	This Function is used to scan the keypad once without waiting.
+ * 					at first, it set all columns as input the change each tick only one column
+ * 					as an output and read its value, if the button is pressed then the
+ * 					function will return the number order of this pressed button
+ * [ARGS]:			No Arguments
+ *	[RETURNS]:		The value of the pressed button, or KEYPAD_NO_KEY if no button is pressed
+ ----------------------------------------------------------------------------------------*/
+uint8 KEYPAD_scanKey(void)
+{
+	uint8 row, col, rows;
+	uint8 colMask = (1<<KEYPAD_FIRST_COL_PIN_ID);
+	uint8 rowMask;
 
-			/* Then, begin to set each pin in the port as an output */
-			GPIO_setPinDirection(KEYPAD_PORT_ID, (col+KEYPAD_FIRST_COL_PIN_ID), PIN_OUTPUT);
+	for(col=0; col<KEYPAD_NUM_OF_COLS; col++)
+	{
+		/* Set the pin of this column as the only output pin in the port */
+		GPIO_PORT_DIRECTION(KEYPAD_PORT_ID, colMask);
 
 #if (KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
-			/* Put the value of the PORT in a variable as all 1 and the only pressed one is 0 */
-			value = ~(1<<(col+KEYPAD_FIRST_COL_PIN_ID));
+		/* Put the value of the PORT as all 1 and the only pressed one is 0 */
+		GPIO_PORT_WRITE(KEYPAD_PORT_ID, (uint8)~colMask);
 #elif (KEYPAD_BUTTON_PRESSED == LOGIC_HIGH)
-			/* Put the value of the PORT in a variable as all 0 and the only pressed one is 1 */
-			value = 1<<(col+KEYPAD_FIRST_COL_PIN_ID);
+		/* Put the value of the PORT as all 0 and the only pressed one is 1 */
+		GPIO_PORT_WRITE(KEYPAD_PORT_ID, colMask);
 #endif
 
-			/*  */
-			GPIO_writePort(KEYPAD_PORT_ID, value);
+		/* The synchronizer of the input pins delays a changed level by a cycle, a
+		 * first read of the pins takes that cycle then all the rows are read at once */
+		(void)GPIO_PORT_READ(KEYPAD_PORT_ID);
+		rows = GPIO_PORT_READ(KEYPAD_PORT_ID);
 
-			for(row=0; row<KEYPAD_NUM_OF_ROWS; row++)
+		rowMask = (1<<KEYPAD_FIRST_ROW_PIN_ID);
+		for(row=0; row<KEYPAD_NUM_OF_ROWS; row++)
+		{
+			if(((rows & rowMask) ? LOGIC_HIGH : LOGIC_LOW) == KEYPAD_BUTTON_PRESSED)
 			{
-				if((GPIO_readPin(KEYPAD_PORT_ID,row)) == KEYPAD_BUTTON_PRESSED)
-				{
 #if (KEYPAD_NUM_OF_COLS == 3)
-					return KEYPAD_4x3_adjustKeyNumber((row * KEYPAD_NUM_OF_COLS) + col + 1);
-					/* An empirical equation used to get the button number */
+				return KEYPAD_4x3_adjustKeyNumber((row * KEYPAD_NUM_OF_COLS) + col + 1);
+				/* An empirical equation used to get the button number */
 #elif (KEYPAD_NUM_OF_COLS == 4)
-					return KEYPAD_4x4_adjustKeyNumber((row * KEYPAD_NUM_OF_COLS) + col + 1);
+				return KEYPAD_4x4_adjustKeyNumber((row * KEYPAD_NUM_OF_COLS) + col + 1);
 #endif
-				}
 			}
+			rowMask <<= 1;
 		}
+		colMask <<= 1;
 	}
+	return KEYPAD_NO_KEY;
 }
+
 #if (KEYPAD_NUM_OF_COLS == 3)
 
 static uint8 KEYPAD_4x3_adjustKeyNumber(uint8 button_number)
@@ -29,6 +29,7 @@
 #define KEYPAD_BUTTON_RELEASED		LOGIC_HIGH
 
 #define ENTER_KEY					13
+#define KEYPAD_NO_KEY				0xFF	/* Returned by the scan when no key is pressed */
 #define KEYPAD_DELAY				2000	//was 300 in 1MHz
 /*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
 /*
@@ -37,4 +38,12 @@
  */
 uint8 KEYPAD_getPressedKey(void);
 
+
+/*
+ * Description:
+ * This function is used to scan the KEYPAD once without waiting for a key
+ * to be pressed
+ */
+uint8 KEYPAD_scanKey(void);
+
 #endif /* KEYPAD_H_ */
@@ -0,0 +1,486 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<link.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the authenticated frames of the UART link>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "link.h"
+#include "cipher.h"
+#include "uart.h"
+#include "systick.h"
+#include "trace.h"
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+/* Sequence, sender, command and size are the start of the data of a MAC */
+#define LINK_MAC_HEADER_SIZE	7
+
+/*-----------------------------------TYPES DECLEARATION--------------------------------*/
+
+typedef enum
+{
+	LINK_CLOSED,
+	LINK_CHALLENGED,		/* mC2 waits for the response to its challenge */
+	LINK_OPENED
+}LINK_SessionType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static uint8 g_LINK_device;
+static LINK_SessionType g_LINK_session = LINK_CLOSED;
+static uint32 g_LINK_challenge;				/* The nonce of mC2 of the session */
+static uint32 g_LINK_iv[2];					/* Secret initial state of the MACs */
+static uint32 g_LINK_txSequence;
+static uint32 g_LINK_rxSequence;			/* Sequence of the next expected frame */
+static uint8 g_LINK_rejects;				/* Frames rejected in a row in the session */
+
+/* The last frame asked to be sent, it is sent again in a new session */
+static LINK_FrameType g_LINK_last;
+static boolean g_LINK_hasLast = FALSE;
+
+/* The message being received */
+static uint8 g_LINK_index = 0;				/* Bytes of the message received */
+static uint8 g_LINK_sequence;				/* Low byte of the sequence of the frame */
+static uint8 g_LINK_mac[LINK_MAC_SIZE];
+static uint8 g_LINK_skip = 0;				/* Bytes of a report left to skip */
+static uint32 g_LINK_byteTime;				/* Tick of the last received byte */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void LINK_open(uint32 mc1_nonce, uint32 mc2_nonce);
+static void LINK_transmit(const LINK_FrameType *a_framePtr);
+static uint32 LINK_mac(uint32 sequence, uint8 sender, const LINK_FrameType *a_framePtr);
+static LINK_StatusType LINK_verify(LINK_FrameType *a_framePtr);
+static LINK_StatusType LINK_reject(void);
+static uint32 LINK_word(const uint8 *a_bytesPtr);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_init
+ * [DESCRIPTION]:	This Function is used to initialize the link for one of the devices
+ * [ARGS]:		uint8 device :	This Arg shall indicate LINK_MC1 or LINK_MC2
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void LINK_init(uint8 device)
+{
+	g_LINK_device = device;
+	g_LINK_session = LINK_CLOSED;
+	g_LINK_index = 0;
+	g_LINK_skip = 0;
+	g_LINK_hasLast = FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_hello
+ * [DESCRIPTION]:	This Function is used by mC1 to close its session and ask mC2 for a
+ * 					new one
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void LINK_hello(void)
+{
+	g_LINK_session = LINK_CLOSED;
+	UART_sendByte(LINK_HELLO);
+	TRACE(TRACE_LINK_HELLO, 0, 0);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_challenge
+ * [DESCRIPTION]:	This Function is used by mC2 to close its session and send a challenge,
+ * 					the nonce shall never be used again with the key
+ * [ARGS]:		uint32 nonce :	This Arg shall indicate the fresh nonce of mC2
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void LINK_challenge(uint32 nonce)
+{
+	uint8 i;
+
+	g_LINK_challenge = nonce;
+	g_LINK_session = LINK_CHALLENGED;
+
+	UART_sendByte(LINK_CHALLENGE);
+	for(i = 0; i < CIPHER_NONCE_SIZE; i++)
+	{
+		UART_sendByte((uint8)(nonce >> (8 * i)));
+	}
+	TRACE(TRACE_LINK_CHALLENGE, 0, 0);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_respond
+ * [DESCRIPTION]:	This Function is used by mC1 to open the session of a challenge and send
+ * 					the response frame that holds its nonce. mC2 opens the same session from
+ * 					the nonce and takes the frame only if the MAC is right
+ * [ARGS]:		uint32 nonce :	This Arg shall indicate the fresh nonce of mC1
+ * 				const LINK_FrameType *a_challengePtr :	This Arg shall indicate the
+ * 											received challenge
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void LINK_respond(uint32 nonce, const LINK_FrameType *a_challengePtr)
+{
+	LINK_FrameType frame;
+	uint8 i;
+
+	frame.command = LINK_RESPONSE;
+	frame.size = CIPHER_NONCE_SIZE;
+	for(i = 0; i < CIPHER_NONCE_SIZE; i++)
+	{
+		frame.payload[i] = (uint8)(nonce >> (8 * i));
+	}
+
+	LINK_open(nonce, LINK_word(a_challengePtr->payload));
+	TRACE(TRACE_LINK_RESPOND, 0, 0);
+	LINK_transmit(&frame);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_isOpen
+ * [DESCRIPTION]:	This Function is used to check if a session is opened
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	TRUE if a session is opened, else FALSE
+ ----------------------------------------------------------------------------------------*/
+boolean LINK_isOpen(void)
+{
+	return (g_LINK_session == LINK_OPENED) ? TRUE : FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_send
+ * [DESCRIPTION]:	This Function is used to send a frame with the next sequence of the
+ * 					device and its MAC. The frame is kept even if no session is opened so
+ * 					it can be sent again in the next one
+ * [ARGS]:		uint8 command :				This Arg shall indicate the command
+ * 				const uint8 *a_payloadPtr :	This Arg shall indicate the payload
+ * 				uint8 size :				This Arg shall indicate the size of the payload
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void LINK_send(uint8 command, const uint8 *a_payloadPtr, uint8 size)
+{
+	uint8 i;
+
+	if(size > LINK_MAX_PAYLOAD)
+	{
+		return;
+	}
+
+	g_LINK_last.command = command;
+	g_LINK_last.size = size;
+	for(i = 0; i < size; i++)
+	{
+		g_LINK_last.payload[i] = a_payloadPtr[i];
+	}
+	g_LINK_hasLast = TRUE;
+	LINK_transmit(&g_LINK_last);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_resend
+ * [DESCRIPTION]:	This Function is used to send the last frame again with the next
+ * 					sequence of the session
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	FALSE if no frame was sent since the init, else TRUE
+ ----------------------------------------------------------------------------------------*/
+boolean LINK_resend(void)
+{
+	if(g_LINK_hasLast == FALSE)
+	{
+		return FALSE;
+	}
+	LINK_transmit(&g_LINK_last);
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_sendReport
+ * [DESCRIPTION]:	This Function is used to send the header of a report, it is sent with
+ * 					or without a session
+ * [ARGS]:		uint8 command :	This Arg shall indicate the command that is answered
+ * 				uint8 size :	This Arg shall indicate the size of the answer
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void LINK_sendReport(uint8 command, uint8 size)
+{
+	UART_sendByte(LINK_REPORT);
+	UART_sendByte(size + 1);
+	UART_sendByte(command);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_receive
+ * [DESCRIPTION]:	This Function is used to take a received byte. A size larger than the
+ * 					payload rejects the frame at once, so the next byte is taken as the
+ * 					command of a new message. A report is skipped whole and a message is
+ * 					dropped when its next byte is late
+ * [ARGS]:		uint8 byte :					This Arg shall indicate the received byte
+ * 				LINK_FrameType *a_framePtr :	This Arg shall indicate where the message
+ * 												is collected
+ * [RETURNS]:	The status of the message
+ ----------------------------------------------------------------------------------------*/
+LINK_StatusType LINK_receive(uint8 byte, LINK_FrameType *a_framePtr)
+{
+	uint32 now = SYSTICK_millis();
+	uint8 index;
+
+	/* The rest of a message cut by a lost byte never comes */
+	if(((g_LINK_index != 0) || (g_LINK_skip != 0)) && ((now - g_LINK_byteTime) > LINK_BYTE_TIMEOUT))
+	{
+		TRACE(TRACE_LINK_REJECT, a_framePtr->command, 0);
+		g_LINK_index = 0;
+		g_LINK_skip = 0;
+	}
+	g_LINK_byteTime = now;
+	index = g_LINK_index;
+
+	if(g_LINK_skip > 0)
+	{
+		g_LINK_skip--;
+		return LINK_BUSY;
+	}
+
+	g_LINK_index++;
+	if(index == 0)
+	{
+		a_framePtr->command = byte;
+		a_framePtr->size = 0;
+		if(byte == LINK_CHALLENGE)
+		{
+			/* The nonce follows the command directly */
+			a_framePtr->size = CIPHER_NONCE_SIZE;
+			g_LINK_index = LINK_HEADER_SIZE;
+		}
+		else if((byte == LINK_HELLO) || (byte == PROFILE_DUMP) || (byte == DIAGNOSTICS))
+		{
+			g_LINK_index = 0;
+			TRACE(TRACE_LINK_PLAIN, byte, 0);
+			return LINK_PLAIN;
+		}
+	}
+	else if((index == 1) && (a_framePtr->command == LINK_REPORT))
+	{
+		g_LINK_skip = byte;
+		g_LINK_index = 0;
+		return LINK_BUSY;
+	}
+	else if(index == 1)
+	{
+		if(byte > LINK_MAX_PAYLOAD)
+		{
+			g_LINK_index = 0;
+			TRACE(TRACE_LINK_REJECT, a_framePtr->command, 0);
+			/* Not counted, the bytes after a lost byte are taken as frames too */
+			return LINK_REJECTED;
+		}
+		a_framePtr->size = byte;
+	}
+	else if(index == 2)
+	{
+		g_LINK_sequence = byte;
+	}
+	else if(index < (LINK_HEADER_SIZE + a_framePtr->size))
+	{
+		a_framePtr->payload[index - LINK_HEADER_SIZE] = byte;
+	}
+	else
+	{
+		g_LINK_mac[index - (LINK_HEADER_SIZE + a_framePtr->size)] = byte;
+	}
+
+	if((a_framePtr->command == LINK_CHALLENGE) &&
+			(g_LINK_index == (LINK_HEADER_SIZE + CIPHER_NONCE_SIZE)))
+	{
+		g_LINK_index = 0;
+		TRACE(TRACE_LINK_PLAIN, LINK_CHALLENGE, 0);
+		return LINK_PLAIN;
+	}
+	if(g_LINK_index < (LINK_HEADER_SIZE + a_framePtr->size + LINK_MAC_SIZE))
+	{
+		return LINK_BUSY;
+	}
+
+	g_LINK_index = 0;
+	return LINK_verify(a_framePtr);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_open
+ * [DESCRIPTION]:	This Function is used to open a session, its MACs start from the
+ * 					encrypted block of the two nonces and the sequences start from 0
+ * [ARGS]:		uint32 mc1_nonce :	This Arg shall indicate the nonce of mC1
+ * 				uint32 mc2_nonce :	This Arg shall indicate the nonce of mC2
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void LINK_open(uint32 mc1_nonce, uint32 mc2_nonce)
+{
+	g_LINK_iv[0] = mc1_nonce;
+	g_LINK_iv[1] = mc2_nonce;
+	CIPHER_encryptBlock(&g_LINK_iv[0], &g_LINK_iv[1]);
+
+	g_LINK_txSequence = 0;
+	g_LINK_rxSequence = 0;
+	g_LINK_rejects = 0;
+	g_LINK_session = LINK_OPENED;
+	TRACE(TRACE_LINK_OPEN, 0, 0);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_transmit
+ * [DESCRIPTION]:	This Function is used to send a frame with the next sequence of the
+ * 					device and its MAC, nothing is sent while no session is opened
+ * [ARGS]:		const LINK_FrameType *a_framePtr :	This Arg shall indicate the frame
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void LINK_transmit(const LINK_FrameType *a_framePtr)
+{
+	uint32 mac;
+	uint8 i;
+
+	if(g_LINK_session != LINK_OPENED)
+	{
+		return;
+	}
+
+	mac = LINK_mac(g_LINK_txSequence, g_LINK_device, a_framePtr);
+
+	UART_sendByte(a_framePtr->command);
+	UART_sendByte(a_framePtr->size);
+	UART_sendByte((uint8)g_LINK_txSequence);
+	for(i = 0; i < a_framePtr->size; i++)
+	{
+		UART_sendByte(a_framePtr->payload[i]);
+	}
+	for(i = 0; i < LINK_MAC_SIZE; i++)
+	{
+		UART_sendByte((uint8)mac);
+		mac >>= 8;
+	}
+	TRACE(TRACE_LINK_SEND, a_framePtr->command, g_LINK_txSequence);
+	g_LINK_txSequence++;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_mac
+ * [DESCRIPTION]:	This Function is used to compute the MAC of a frame
+ * [ARGS]:		uint32 sequence :	This Arg shall indicate the full sequence of the frame
+ * 				uint8 sender :		This Arg shall indicate the device that sent the frame
+ * 				const LINK_FrameType *a_framePtr :	This Arg shall indicate the frame
+ * [RETURNS]:	The MAC
+ ----------------------------------------------------------------------------------------*/
+static uint32 LINK_mac(uint32 sequence, uint8 sender, const LINK_FrameType *a_framePtr)
+{
+	uint8 data[LINK_MAC_HEADER_SIZE + LINK_MAX_PAYLOAD];
+	uint8 i;
+
+	for(i = 0; i < 4; i++)
+	{
+		data[i] = (uint8)(sequence >> (8 * i));
+	}
+	data[4] = sender;
+	data[5] = a_framePtr->command;
+	data[6] = a_framePtr->size;
+	for(i = 0; i < a_framePtr->size; i++)
+	{
+		data[LINK_MAC_HEADER_SIZE + i] = a_framePtr->payload[i];
+	}
+
+	return CIPHER_mac(g_LINK_iv, data, LINK_MAC_HEADER_SIZE + a_framePtr->size);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_verify
+ * [DESCRIPTION]:	This Function is used to check a complete frame. The response to the
+ * 					challenge opens the session before its check. The MAC is always
+ * 					computed and the checks are combined without a branch on the MAC, so
+ * 					the time of a rejected frame only depends on its size
+ * [ARGS]:		LINK_FrameType *a_framePtr :	This Arg shall indicate the frame
+ * [RETURNS]:	LINK_FRAME if the frame is taken, else LINK_REJECTED
+ ----------------------------------------------------------------------------------------*/
+static LINK_StatusType LINK_verify(LINK_FrameType *a_framePtr)
+{
+	boolean response = FALSE;
+	uint32 sequence;
+	uint32 mac;
+	uint8 delta;
+	uint8 valid;
+	uint8 i;
+
+	if((g_LINK_session == LINK_CHALLENGED) && (a_framePtr->command == LINK_RESPONSE) &&
+			(a_framePtr->size == CIPHER_NONCE_SIZE))
+	{
+		LINK_open(LINK_word(a_framePtr->payload), g_LINK_challenge);
+		response = TRUE;
+	}
+
+	delta = (uint8)(g_LINK_sequence - (uint8)g_LINK_rxSequence);
+	sequence = g_LINK_rxSequence + delta;
+	mac = LINK_mac(sequence, g_LINK_device ^ 1, a_framePtr);
+	for(i = 0; i < LINK_MAC_SIZE; i++)
+	{
+		mac ^= (uint32)g_LINK_mac[i] << (8 * i);
+	}
+	mac |= mac >> 16;
+	mac |= mac >> 8;
+
+	/* 1 only if the folded difference is 0 */
+	valid = (uint8)((((uint16)(uint8)mac - 1) >> 8) & 1);
+	valid &= (uint8)(delta < LINK_SEQ_WINDOW);
+	valid &= (uint8)(g_LINK_session == LINK_OPENED);
+
+	if(valid == 0)
+	{
+		/* A wrong response keeps the challenge for the right one */
+		if(response == TRUE)
+		{
+			g_LINK_session = LINK_CHALLENGED;
+		}
+		TRACE(TRACE_LINK_REJECT, a_framePtr->command, g_LINK_sequence);
+		return LINK_reject();
+	}
+
+	g_LINK_rxSequence = sequence + 1;
+	g_LINK_rejects = 0;
+	TRACE(TRACE_LINK_RECEIVE, a_framePtr->command, g_LINK_sequence);
+	return LINK_FRAME;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_reject
+ * [DESCRIPTION]:	This Function is used to count a frame of an opened session that failed
+ * 					its check, the session is closed after LINK_MAX_REJECTS frames in a row
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	LINK_LOST if the session is closed, else LINK_REJECTED
+ ----------------------------------------------------------------------------------------*/
+static LINK_StatusType LINK_reject(void)
+{
+	if(g_LINK_session != LINK_OPENED)
+	{
+		return LINK_REJECTED;
+	}
+
+	g_LINK_rejects++;
+	if(g_LINK_rejects < LINK_MAX_REJECTS)
+	{
+		return LINK_REJECTED;
+	}
+
+	g_LINK_session = LINK_CLOSED;
+	TRACE(TRACE_LINK_LOST, 0, 0);
+	return LINK_LOST;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LINK_word
+ * [DESCRIPTION]:	This Function is used to read 4 bytes as a little endian word
+ * [ARGS]:		const uint8 *a_bytesPtr :	This Arg shall indicate the bytes
+ * [RETURNS]:	The word
+ ----------------------------------------------------------------------------------------*/
+static uint32 LINK_word(const uint8 *a_bytesPtr)
+{
+	return (uint32)a_bytesPtr[0] | ((uint32)a_bytesPtr[1] << 8) |
+			((uint32)a_bytesPtr[2] << 16) | ((uint32)a_bytesPtr[3] << 24);
+}
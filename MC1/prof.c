@@ -0,0 +1,139 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<prof.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the hot path profiling probes>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "prof.h"
+
+#if (PROF_ENABLE == TRUE)
+
+#include "systick.h"
+#include "uart.h"
+#include "link.h"
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define PROF_RECORD_SIZE	9		/* Id, start and duration of a record in the report */
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* Start timestamp of the sections that are currently measured */
+static uint32 g_PROF_start[PROF_NUM_OF_IDS];
+static uint8 g_PROF_running = 0;
+
+/* Ring buffer of the finished sections, the oldest record is overwritten */
+static PROF_RecordType g_PROF_records[PROF_BUFFER_SIZE];
+static uint8 g_PROF_head = 0;
+static uint8 g_PROF_count = 0;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void PROF_sendWord(uint32 word);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	PROF_begin
+ * [DESCRIPTION]:	This Function is used to take the start timestamp of a section
+ * [ARGS]:		PROF_IdType id :	This Arg shall indicate the measured section
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void PROF_begin(PROF_IdType id)
+{
+	g_PROF_start[id] = SYSTICK_cycles();
+	g_PROF_running |= (1<<id);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	PROF_end
+ * [DESCRIPTION]:	This Function is used to close a section and save its record. A section
+ * 					that was not started by PROF_begin is ignored
+ * [ARGS]:		PROF_IdType id :	This Arg shall indicate the measured section
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void PROF_end(PROF_IdType id)
+{
+	uint32 end = SYSTICK_cycles();
+
+	if(g_PROF_running & (1<<id))
+	{
+		g_PROF_running &= ~(1<<id);
+
+		g_PROF_records[g_PROF_head].id = id;
+		g_PROF_records[g_PROF_head].start = g_PROF_start[id];
+		g_PROF_records[g_PROF_head].duration = end - g_PROF_start[id];
+
+		g_PROF_head++;
+		if(g_PROF_head == PROF_BUFFER_SIZE)
+		{
+			g_PROF_head = 0;
+		}
+		if(g_PROF_count < PROF_BUFFER_SIZE)
+		{
+			g_PROF_count++;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	PROF_dump
+ * [DESCRIPTION]:	This Function is used to send the records from the oldest to the newest
+ * 					then empty the buffer. The answer of the PROFILE_DUMP report is:
+ * 					[ count - count * (id - start[4] - duration[4]) ]
+ * 					and the 4 bytes words are sent with the least significant byte first
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void PROF_dump(void)
+{
+	uint8 i;
+	uint8 index = (uint8)(g_PROF_head + PROF_BUFFER_SIZE - g_PROF_count);
+
+	if(index >= PROF_BUFFER_SIZE)
+	{
+		index -= PROF_BUFFER_SIZE;
+	}
+
+	LINK_sendReport(PROFILE_DUMP, 1 + (g_PROF_count * PROF_RECORD_SIZE));
+	UART_sendByte(g_PROF_count);
+
+	for(i = 0; i < g_PROF_count; i++)
+	{
+		UART_sendByte(g_PROF_records[index].id);
+		PROF_sendWord(g_PROF_records[index].start);
+		PROF_sendWord(g_PROF_records[index].duration);
+
+		index++;
+		if(index == PROF_BUFFER_SIZE)
+		{
+			index = 0;
+		}
+	}
+
+	g_PROF_count = 0;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	PROF_sendWord
+ * [DESCRIPTION]:	This Function is used to send a 4 bytes word, least significant first
+ * [ARGS]:		uint32 word :	This Arg shall indicate the word to send
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void PROF_sendWord(uint32 word)
+{
+	uint8 i;
+
+	for(i = 0; i < 4; i++)
+	{
+		UART_sendByte((uint8)word);
+		word >>= 8;
+	}
+}
+
+#endif	/* PROF_ENABLE */
@@ -0,0 +1,292 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<systick.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the system tick and software timers>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "systick.h"
+#include "timer.h"
+#include "common_macros.h"
+#include "trace.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* Milliseconds since SYSTICK_init, only the Timer1 ISR writes it */
+static volatile uint32 g_SYSTICK_msec = 0;
+
+/* Head of the active software timers list, sorted by deadline */
+static SYSTICK_TimerType *g_SYSTICK_timersHead = NULL_PTR;
+
+/* Set while the call back functions are running to avoid re-entering the list */
+static boolean g_SYSTICK_processing = FALSE;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+#if (TIMER1_COMPA_STATIC_BINDING == FALSE)
+static void SYSTICK_tickProcessing(void);
+#endif
+static void SYSTICK_insertTimer(SYSTICK_TimerType *a_timerPtr);
+static void SYSTICK_removeTimer(SYSTICK_TimerType *a_timerPtr);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_init
+ * [DESCRIPTION]:	This Function is used to start Timer1 as a free running 1 kHz system
+ * 					tick. Timer1 is configured once here and never de-initialized
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SYSTICK_init(void)
+{
+	/*
+	 * Timer1 in CTC mode on channel A with no prescalar, the counter clears after
+	 * (OCR1A + 1) counts so the compare value is one cycle less than a millisecond
+	 */
+	TIMER_ConfigType TIMER1_config = {TIMER1,0,0,CTC_T1,CHANNEL_A,FCPU_1_T1,0,0,0,(SYSTICK_CYCLES_PER_MS - 1)};
+
+	g_SYSTICK_msec = 0;
+#if (TIMER1_COMPA_STATIC_BINDING == FALSE)
+	TIMER1_setCallBack(SYSTICK_tickProcessing);
+#endif
+	TIMER_init(&TIMER1_config);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_millis
+ * [DESCRIPTION]:	This Function is used to read the milliseconds counter. The counter is
+ * 					4 bytes so the interrupts are disabled while copying it to make sure
+ * 					the ISR does not change it in the middle of the read
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The number of milliseconds since SYSTICK_init
+ ----------------------------------------------------------------------------------------*/
+uint32 SYSTICK_millis(void)
+{
+	uint32 msec;
+	uint8 sreg = SREG;
+
+	cli();
+	msec = g_SYSTICK_msec;
+	SREG = sreg;
+
+	return msec;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_cycles
+ * [DESCRIPTION]:	This Function is used to read a timestamp in CPU cycles. As Timer1 is
+ * 					not prescaled, TCNT1 is the number of cycles inside the current tick.
+ * 					The timestamp overflows every (2^32 / F_CPU) seconds
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The number of CPU cycles since SYSTICK_init
+ ----------------------------------------------------------------------------------------*/
+uint32 SYSTICK_cycles(void)
+{
+	uint32 msec;
+	uint16 count;
+	uint8 sreg = SREG;
+
+	cli();
+	msec = g_SYSTICK_msec;
+	count = TCNT1;
+
+	/* If the compare match happened while the interrupts are disabled, the counter
+	 * is already cleared but the ISR did not increment the milliseconds yet */
+	if(BIT_IS_SET(TIFR,OCF1A))
+	{
+		count = TCNT1;
+		msec++;
+	}
+	SREG = sreg;
+
+	return (msec * SYSTICK_CYCLES_PER_MS) + count;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_isExpired
+ * [DESCRIPTION]:	This Function is used to check if a deadline has been reached. The
+ * 					difference is taken as signed so the check still works when the
+ * 					counter overflows
+ * [ARGS]:		uint32 deadline :	This Arg shall indicate the deadline in ticks
+ * [RETURNS]:	TRUE if the deadline has been reached, FALSE otherwise
+ ----------------------------------------------------------------------------------------*/
+boolean SYSTICK_isExpired(uint32 deadline)
+{
+	return ((sint32)(SYSTICK_millis() - deadline) >= 0) ? TRUE : FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_delay_ms
+ * [DESCRIPTION]:	This Function is used to wait for the given milliseconds, the expired
+ * 					software timers are served while waiting
+ * [ARGS]:		uint32 msec :	This Arg shall indicate the delay in milliseconds
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SYSTICK_delay_ms(uint32 msec)
+{
+	uint32 deadline = SYSTICK_millis() + msec;
+
+	while(SYSTICK_isExpired(deadline) == FALSE)
+	{
+		SYSTICK_processTimers();
+		TRACE_DRAIN();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_startTimer
+ * [DESCRIPTION]:	This Function is used to start a software timer, the timer structure
+ * 					is owned by the caller and must stay alive while the timer is active.
+ * 					Starting an active timer restarts it with the new settings
+ * [ARGS]:		SYSTICK_TimerType *a_timerPtr :	This Arg shall indicate the timer to start
+ * 				uint32 msec :	This Arg shall indicate the timeout (and the period) in ms
+ * 				SYSTICK_TimerMode mode :	This Arg shall indicate one-shot or periodic
+ * 				void(*a_ptr)(void) :	This Arg shall indicate the call back function
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SYSTICK_startTimer(SYSTICK_TimerType *a_timerPtr, uint32 msec, SYSTICK_TimerMode mode, void(*a_ptr)(void))
+{
+	if(a_timerPtr->active == TRUE)
+	{
+		SYSTICK_removeTimer(a_timerPtr);
+	}
+
+	a_timerPtr->deadline = SYSTICK_millis() + msec;
+	a_timerPtr->period = msec;
+	a_timerPtr->mode = mode;
+	a_timerPtr->callBack = a_ptr;
+
+	SYSTICK_insertTimer(a_timerPtr);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_stopTimer
+ * [DESCRIPTION]:	This Function is used to stop a software timer before it expires
+ * [ARGS]:		SYSTICK_TimerType *a_timerPtr :	This Arg shall indicate the timer to stop
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SYSTICK_stopTimer(SYSTICK_TimerType *a_timerPtr)
+{
+	if(a_timerPtr->active == TRUE)
+	{
+		SYSTICK_removeTimer(a_timerPtr);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_processTimers
+ * [DESCRIPTION]:	This Function is used to call the call back functions of the expired
+ * 					timers. The list is sorted so only the head has to be checked, the
+ * 					periodic timers are inserted again with their next deadline
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SYSTICK_processTimers(void)
+{
+	SYSTICK_TimerType *timer;
+
+	/* A call back function that waits with SYSTICK_delay_ms shall not serve the list again */
+	if(g_SYSTICK_processing == TRUE)
+	{
+		return;
+	}
+	g_SYSTICK_processing = TRUE;
+
+	while((g_SYSTICK_timersHead != NULL_PTR) && (SYSTICK_isExpired(g_SYSTICK_timersHead->deadline) == TRUE))
+	{
+		timer = g_SYSTICK_timersHead;
+		SYSTICK_removeTimer(timer);
+
+		if(timer->mode == SYSTICK_PERIODIC)
+		{
+			/* Add the period to the old deadline, not to the current tick, so a late
+			 * call back does not make the period drift */
+			timer->deadline += timer->period;
+			SYSTICK_insertTimer(timer);
+		}
+
+		if(timer->callBack != NULL_PTR)
+		{
+			(*timer->callBack)();
+		}
+	}
+
+	g_SYSTICK_processing = FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_insertTimer
+ * [DESCRIPTION]:	This Function is used to insert a timer in the list before the first
+ * 					timer that has a later deadline
+ * [ARGS]:		SYSTICK_TimerType *a_timerPtr :	This Arg shall indicate the timer to insert
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void SYSTICK_insertTimer(SYSTICK_TimerType *a_timerPtr)
+{
+	SYSTICK_TimerType **link = &g_SYSTICK_timersHead;
+
+	while((*link != NULL_PTR) && ((sint32)((*link)->deadline - a_timerPtr->deadline) <= 0))
+	{
+		link = &((*link)->next);
+	}
+
+	a_timerPtr->next = *link;
+	*link = a_timerPtr;
+	a_timerPtr->active = TRUE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_removeTimer
+ * [DESCRIPTION]:	This Function is used to unlink a timer from the list
+ * [ARGS]:		SYSTICK_TimerType *a_timerPtr :	This Arg shall indicate the timer to remove
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void SYSTICK_removeTimer(SYSTICK_TimerType *a_timerPtr)
+{
+	SYSTICK_TimerType **link = &g_SYSTICK_timersHead;
+
+	while((*link != NULL_PTR) && (*link != a_timerPtr))
+	{
+		link = &((*link)->next);
+	}
+
+	if(*link != NULL_PTR)
+	{
+		*link = a_timerPtr->next;
+	}
+	a_timerPtr->next = NULL_PTR;
+	a_timerPtr->active = FALSE;
+}
+
+#if (TIMER1_COMPA_STATIC_BINDING == FALSE)
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SYSTICK_tickProcessing
+ * [DESCRIPTION]:	This Function is the Timer1 call back function, it is called from the
+ * 					compare match ISR every millisecond
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void SYSTICK_tickProcessing(void)
+{
+	g_SYSTICK_msec++;
+}
+
+#else
+/*--------------------------------INTERRUPT SERVICE ROUTINES-----------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [ISR NAME]:		TIMER1_COMPA_vect
+ * [DESCRIPTION]:	This ISR is bound at compile time to the system tick, the increment is
+ * 					inlined here so the ISR only saves the registers it uses
+ ----------------------------------------------------------------------------------------*/
+ISR(TIMER1_COMPA_vect)
+{
+	g_SYSTICK_msec++;
+}
+#endif	/* TIMER1_COMPA_STATIC_BINDING */
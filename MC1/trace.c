@@ -0,0 +1,235 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<trace.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the binary trace of the runtime events, sent
+ * 					on a software UART pin>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "trace.h"
+
+#if (TRACE_ENABLE == TRUE)
+
+#include "gpio.h"
+#include "systick.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+/* The bits are timed on TCNT1 of the system tick, it counts the CPU cycles from 0 to
+ * (SYSTICK_CYCLES_PER_MS - 1) so a bit shall be shorter than a tick */
+#define TRACE_BIT_CYCLES		((uint16)((F_CPU + (TRACE_BAUD / 2)) / TRACE_BAUD))
+
+#if ((F_CPU + (TRACE_BAUD / 2)) / TRACE_BAUD) >= SYSTICK_CYCLES_PER_MS
+#error "TRACE_BAUD is too low, a bit of the trace is longer than the system tick"
+#endif
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* Ring buffer of the events, the sent event leaves it after its last byte */
+static TRACE_RecordType g_TRACE_records[TRACE_BUFFER_SIZE];
+static uint8 g_TRACE_head = 0;
+static volatile uint8 g_TRACE_count = 0;
+static uint8 g_TRACE_lost = 0;
+static uint8 g_TRACE_byte = 0;			/* Next byte of the frame of the oldest event */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void TRACE_sendByte(uint8 byte);
+static uint16 TRACE_waitBit(uint16 edge);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TRACE_init
+ * [DESCRIPTION]:	This Function is used to set the TX pin as an output at the idle level
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void TRACE_init(void)
+{
+	GPIO_PIN_HIGH(TRACE_PORT_ID, TRACE_PIN_ID);
+	GPIO_PIN_OUTPUT(TRACE_PORT_ID, TRACE_PIN_ID);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TRACE_event
+ * [DESCRIPTION]:	This Function is used to save an event in the ring buffer. When it is
+ * 					full the event is counted as lost, a TRACE_LOST event is saved before
+ * 					the next one that fits
+ * [ARGS]:		TRACE_EventType id :	This Arg shall indicate the event
+ * 				uint8 arg1 :			This Arg shall indicate its first argument
+ * 				uint8 arg2 :			This Arg shall indicate its second argument
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void TRACE_event(TRACE_EventType id, uint8 arg1, uint8 arg2)
+{
+	TRACE_RecordType *record;
+	uint16 time = (uint16)SYSTICK_millis();
+	uint8 index;
+	uint8 sreg = SREG;
+
+	cli();
+	if(g_TRACE_count >= (TRACE_BUFFER_SIZE - ((g_TRACE_lost != 0) ? 1 : 0)))
+	{
+		if(g_TRACE_lost != 0xFF)
+		{
+			g_TRACE_lost++;
+		}
+		SREG = sreg;
+		return;
+	}
+
+	if(g_TRACE_lost != 0)
+	{
+		index = g_TRACE_head + g_TRACE_count;
+		record = &g_TRACE_records[(index >= TRACE_BUFFER_SIZE) ? (index - TRACE_BUFFER_SIZE) : index];
+		record->id = TRACE_LOST;
+		record->time = time;
+		record->arg1 = g_TRACE_lost;
+		record->arg2 = 0;
+		g_TRACE_count++;
+		g_TRACE_lost = 0;
+	}
+
+	index = g_TRACE_head + g_TRACE_count;
+	record = &g_TRACE_records[(index >= TRACE_BUFFER_SIZE) ? (index - TRACE_BUFFER_SIZE) : index];
+	record->id = id;
+	record->time = time;
+	record->arg1 = arg1;
+	record->arg2 = arg2;
+	g_TRACE_count++;
+	SREG = sreg;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TRACE_drain
+ * [DESCRIPTION]:	This Function is used to send the next byte of the frame of the oldest
+ * 					event, a call takes one frame of the software UART
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void TRACE_drain(void)
+{
+	const TRACE_RecordType *record = &g_TRACE_records[g_TRACE_head];
+	uint8 byte;
+	uint8 sreg;
+
+	if(g_TRACE_count == 0)
+	{
+		return;
+	}
+
+	switch(g_TRACE_byte)
+	{
+	case 0:
+		byte = TRACE_SYNC;
+		break;
+	case 1:
+		byte = record->id;
+		break;
+	case 2:
+		byte = (uint8)record->time;
+		break;
+	case 3:
+		byte = (uint8)(record->time >> 8);
+		break;
+	case 4:
+		byte = record->arg1;
+		break;
+	case 5:
+		byte = record->arg2;
+		break;
+	default:
+		byte = record->id ^ (uint8)record->time ^ (uint8)(record->time >> 8) ^ record->arg1 ^ record->arg2;
+		break;
+	}
+	TRACE_sendByte(byte);
+
+	g_TRACE_byte++;
+	if(g_TRACE_byte == TRACE_FRAME_SIZE)
+	{
+		g_TRACE_byte = 0;
+		g_TRACE_head = (g_TRACE_head == (TRACE_BUFFER_SIZE - 1)) ? 0 : (g_TRACE_head + 1);
+
+		/* The count is shared with the events saved by the ISRs */
+		sreg = SREG;
+		cli();
+		g_TRACE_count--;
+		SREG = sreg;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TRACE_sendByte
+ * [DESCRIPTION]:	This Function is used to send a byte on the TX pin, 8N1 least significant
+ * 					bit first. Each edge is put on a deadline of TCNT1, so the length of a bit
+ * 					does not depend on the code of the loop nor on the optimization. The
+ * 					interrupts are disabled from the start bit to the last data bit only, an
+ * 					ISR in the stop bit makes it longer which the receiver allows
+ * [ARGS]:		uint8 byte :	This Arg shall indicate the byte
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void TRACE_sendByte(uint8 byte)
+{
+	uint16 frame = ((uint16)byte << 1) | 0x200;	/* The start bit is the low bit, then the stop bit */
+	uint16 edge;
+	uint8 sreg = SREG;
+	uint8 i;
+
+	cli();
+	edge = TCNT1;
+	for(i = 0; i < 10; i++)
+	{
+		if(frame & 0x01)
+		{
+			GPIO_PIN_HIGH(TRACE_PORT_ID, TRACE_PIN_ID);
+		}
+		else
+		{
+			GPIO_PIN_LOW(TRACE_PORT_ID, TRACE_PIN_ID);
+		}
+		frame >>= 1;
+
+		if(i == 9)
+		{
+			SREG = sreg;
+		}
+		edge = TRACE_waitBit(edge);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	TRACE_waitBit
+ * [DESCRIPTION]:	This Function is used to wait until TRACE_BIT_CYCLES cycles of Timer1
+ * 					have passed since the edge of the current bit. TCNT1 is cleared at the
+ * 					end of every tick, the count is taken across it
+ * [ARGS]:		uint16 edge :	This Arg shall indicate TCNT1 at the edge of the current bit
+ * [RETURNS]:	TCNT1 at the edge of the next bit
+ ----------------------------------------------------------------------------------------*/
+static uint16 TRACE_waitBit(uint16 edge)
+{
+	uint16 now;
+	uint16 elapsed;
+
+	do
+	{
+		now = TCNT1;
+		elapsed = (now >= edge) ? (now - edge) : (uint16)(now + SYSTICK_CYCLES_PER_MS - edge);
+	}while(elapsed < TRACE_BIT_CYCLES);
+
+	edge += TRACE_BIT_CYCLES;
+	if(edge >= SYSTICK_CYCLES_PER_MS)
+	{
+		edge -= SYSTICK_CYCLES_PER_MS;
+	}
+
+	return edge;
+}
+
+#endif	/* TRACE_ENABLE */
@@ -0,0 +1,124 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<trace.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the binary trace of the runtime events, sent
+ * 					on a software UART pin>
+ ---------------------------------------------------------------------------*/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/* The trace is only built when the project is compiled with -DTRACE_ENABLE=TRUE,
+ * otherwise every macro expands to nothing */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE			FALSE
+#endif
+
+#define TRACE_BUFFER_SIZE		16		/* Number of events kept until they are sent */
+
+/* The TX pin of the software UART, the UART of the mC is the link with mC2 */
+#define TRACE_PORT_ID			PORTB_ID
+#define TRACE_PIN_ID			PIN7_ID
+
+/*
+ * The bits are timed on TCNT1 of the system tick, not by delay loops, so the baud
+ * rate holds at any optimization level and F_CPU. SYSTICK_init shall be called
+ * before the first TRACE_DRAIN(). The polling of TCNT1 moves an edge by a few
+ * cycles only, far less than half a bit of 104 cycles at 1 MHz
+ */
+#define TRACE_BAUD				9600
+
+/* A sent event is [ TRACE_SYNC - id - time[2] - arg1 - arg2 - check ], the time is
+ * the low 16 bits of SYSTICK_millis() least significant byte first and the check is
+ * the XOR of the 5 bytes after the sync */
+#define TRACE_SYNC				0xA5
+#define TRACE_FRAME_SIZE		7
+
+/*
+ * The events of mC1 as EVENT(id, text), the text is the printf format of the two
+ * arguments for the decoder of the host. The first ids are of the shared
+ * drivers, in the same order on mC2
+ */
+#define TRACE_EVENTS(EVENT)																\
+	EVENT(TRACE_LOST,				"%u events lost, the buffer was full")				\
+	EVENT(TRACE_LINK_HELLO,			"link hello sent")									\
+	EVENT(TRACE_LINK_CHALLENGE,		"link challenge sent")								\
+	EVENT(TRACE_LINK_RESPOND,		"link response sent")								\
+	EVENT(TRACE_LINK_OPEN,			"link session opened")								\
+	EVENT(TRACE_LINK_SEND,			"link frame sent command 0x%02X sequence %u")		\
+	EVENT(TRACE_LINK_RECEIVE,		"link frame received command 0x%02X sequence %u")	\
+	EVENT(TRACE_LINK_PLAIN,			"link handshake received command 0x%02X")			\
+	EVENT(TRACE_LINK_REJECT,		"link frame rejected command 0x%02X sequence %u")	\
+	EVENT(TRACE_LINK_LOST,			"link session closed after rejected frames")		\
+	EVENT(TRACE_APP1_STATE,			"state 0x%02X from mC2")							\
+	EVENT(TRACE_APP1_CONNECT,		"connecting to mC2")
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+#define TRACE_ID(id, text)		id,
+
+typedef enum
+{
+	TRACE_EVENTS(TRACE_ID)
+	TRACE_NUM_OF_EVENTS
+}TRACE_EventType;
+
+#undef TRACE_ID
+
+typedef struct
+{
+	uint8 id;
+	uint16 time;			/* Low 16 bits of the time in ms */
+	uint8 arg1;
+	uint8 arg2;
+}TRACE_RecordType;
+
+/*-------------------------------TRACE MACROS---------------------------------*/
+
+#if (TRACE_ENABLE == TRUE)
+#define TRACE_INIT()				TRACE_init()
+#define TRACE(id, arg1, arg2)		TRACE_event((id), (uint8)(arg1), (uint8)(arg2))
+#define TRACE_DRAIN()				TRACE_drain()
+#else
+#define TRACE_INIT()				((void)0)
+#define TRACE(id, arg1, arg2)		((void)0)
+#define TRACE_DRAIN()				((void)0)
+#endif
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+
+#if (TRACE_ENABLE == TRUE)
+/*
+ * Description:
+ * This Function is used to set the TX pin of the trace to the idle level
+ */
+void TRACE_init(void);
+
+
+/*
+ * Description:
+ * This Function is used to save an event with its time, it can be called from
+ * an ISR. The events that do not fit in the buffer are counted as lost
+ */
+void TRACE_event(TRACE_EventType id, uint8 arg1, uint8 arg2);
+
+
+/*
+ * Description:
+ * This Function is used by the waiting loops to send the next byte of the
+ * events, it does nothing when there is no event
+ */
+void TRACE_drain(void);
+#endif
+
+#endif /* TRACE_H_ */
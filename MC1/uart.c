@@ -11,7 +11,29 @@
 
 #include "uart.h"
 #include "common_macros.h"
+#include "trace.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+#if (UART_RX_INTERRUPT == TRUE)
+/* Ring buffer written by the RX complete ISR and read by UART_receiveByte */
+static volatile uint8 g_UART_rxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_UART_rxHead = 0;
+static volatile uint8 g_UART_rxTail = 0;
+
+static void(* volatile g_UART_rxCallBackPtr)(void) = NULL_PTR;
+#endif
+
+/* Received bytes with a wrong stop bit and bytes lost by an overrun of the receiver
+ * or of the ring buffer, the counts stop at their maximum */
+static volatile uint16 g_UART_framingErrors = 0;
+static volatile uint16 g_UART_overrunErrors = 0;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void UART_countErrors(uint8 status);
 
 /*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
 /*---------------------------------------------------------------------------------------
@@ -45,6 +67,12 @@ void UART_init(UART_configType *configPtr)
 	ubrr_value =(( (F_CPU / ( 8 * (configPtr->baudRate) )) ) - 1);
 	UBRRH = (uint8) (ubrr_value>>8);
 	UBRRL = (uint8) (ubrr_value);
+
+#if (UART_RX_INTERRUPT == TRUE)
+	/* Enable the RX complete interrupt and the global interrupt bit */
+	SET_BIT(UCSRB,RXCIE);
+	SREG |= (1<<7);
+#endif
 }
 
 /*---------------------------------------------------------------------------------------
@@ -70,11 +98,100 @@ void UART_sendByte(uint8 byte)
  ----------------------------------------------------------------------------------------*/
 uint8 UART_receiveByte(void)
 {
+#if (UART_RX_INTERRUPT == TRUE)
+	uint8 byte;
+
+	/* Wait until the ISR puts a byte in the ring buffer */
+	while(g_UART_rxHead == g_UART_rxTail)
+	{
+		TRACE_DRAIN();
+	}
+	byte = g_UART_rxBuffer[g_UART_rxTail];
+	g_UART_rxTail = (g_UART_rxTail + 1) & (UART_RX_BUFFER_SIZE - 1);
+	return byte;
+#else
+	uint8 status = UCSRA;
+
 	/* Wait until the UART receive complete flag bit "RXC" = 1,
-	* this bit is set to one when the UART finish receiving data */
-	while(BIT_IS_CLEAR(UCSRA,RXC)){}
+	* this bit is set to one when the UART finish receiving data.
+	* The error flags of the byte in UDR are in the same read */
+	while(BIT_IS_CLEAR(status,RXC))
+	{
+		TRACE_DRAIN();
+		status = UCSRA;
+	}
+	UART_countErrors(status);
 	return UDR;
+#endif
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	UART_isDataAvailable
+ * [DESCRIPTION]:	This Function is used to check if a byte can be read without waiting
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	TRUE if a received byte is waiting to be read, FALSE otherwise
+ ----------------------------------------------------------------------------------------*/
+boolean UART_isDataAvailable(void)
+{
+#if (UART_RX_INTERRUPT == TRUE)
+	return (g_UART_rxHead != g_UART_rxTail) ? TRUE : FALSE;
+#else
+	return BIT_IS_SET(UCSRA,RXC) ? TRUE : FALSE;
+#endif
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	UART_getErrors
+ * [DESCRIPTION]:	This Function is used to read the counts of the receive errors
+ * [ARGS]:		uint16 *a_framingPtr :	This Arg shall indicate where the count of the
+ * 										framing errors is written
+ * 				uint16 *a_overrunPtr :	This Arg shall indicate where the count of the
+ * 										lost bytes is written
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void UART_getErrors(uint16 *a_framingPtr, uint16 *a_overrunPtr)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	*a_framingPtr = g_UART_framingErrors;
+	*a_overrunPtr = g_UART_overrunErrors;
+	SREG = sreg;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	UART_countErrors
+ * [DESCRIPTION]:	This Function is used to count the errors of a received byte from its
+ * 					status in UCSRA
+ * [ARGS]:		uint8 status :	This Arg shall indicate UCSRA before UDR is read
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void UART_countErrors(uint8 status)
+{
+	if((status & (1<<FE)) && (g_UART_framingErrors != 0xFFFF))
+	{
+		g_UART_framingErrors++;
+	}
+	if((status & (1<<DOR)) && (g_UART_overrunErrors != 0xFFFF))
+	{
+		g_UART_overrunErrors++;
+	}
+}
+
+#if (UART_RX_INTERRUPT == TRUE)
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	UART_setRxCallBack
+ * [DESCRIPTION]:	This Function is used to assign the function called from the RX
+ * 					complete ISR after a byte is saved in the ring buffer
+ * [ARGS]:	void(*a_ptr)(void) :	This Argument is a pointer to function, indicating the
+ * 								 	function called in the call back function
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void UART_setRxCallBack(void(*a_ptr)(void))
+{
+	g_UART_rxCallBackPtr = a_ptr;
 }
+#endif
 
 /*---------------------------------------------------------------------------------------
  * [FUNCTION NAME]:	UART_sendString
@@ -115,3 +232,35 @@ void UART_receiveString(uint8 *str)
 
 	str[i] = '\0';
 }
+
+#if (UART_RX_INTERRUPT == TRUE)
+/*--------------------------------INTERRUPT SERVICE ROUTINES-----------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [ISR NAME]:		USART_RXC_vect
+ * [DESCRIPTION]:	This ISR saves the received byte in the ring buffer, the byte is
+ * 					dropped and counted as an overrun if the buffer is full
+ ----------------------------------------------------------------------------------------*/
+ISR(USART_RXC_vect)
+{
+	uint8 byte;
+	uint8 next = (g_UART_rxHead + 1) & (UART_RX_BUFFER_SIZE - 1);
+
+	UART_countErrors(UCSRA);
+	byte = UDR;
+
+	if(next != g_UART_rxTail)
+	{
+		g_UART_rxBuffer[g_UART_rxHead] = byte;
+		g_UART_rxHead = next;
+	}
+	else if(g_UART_overrunErrors != 0xFFFF)
+	{
+		g_UART_overrunErrors++;
+	}
+
+	if(g_UART_rxCallBackPtr != NULL_PTR)
+	{
+		(*g_UART_rxCallBackPtr)();
+	}
+}
+#endif	/* UART_RX_INTERRUPT */
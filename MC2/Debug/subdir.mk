@@ -4,41 +4,74 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../adc.c \
 ../app2.c \
 ../buzzer.c \
+../cipher.c \
 ../dcmotor.c \
+../diag.c \
 ../eeprom.c \
 ../gpio.c \
+../hash.c \
 ../lcd.c \
+../link.c \
 ../mc2.c \
+../position.c \
+../prof.c \
 ../pwm.c \
+../rng.c \
+../sched.c \
+../systick.c \
 ../timer.c \
+../trace.c \
 ../twi.c \
 ../uart.c 
 
 OBJS += \
+./adc.o \
 ./app2.o \
 ./buzzer.o \
+./cipher.o \
 ./dcmotor.o \
+./diag.o \
 ./eeprom.o \
 ./gpio.o \
+./hash.o \
 ./lcd.o \
+./link.o \
 ./mc2.o \
+./position.o \
+./prof.o \
 ./pwm.o \
+./rng.o \
+./sched.o \
+./systick.o \
 ./timer.o \
+./trace.o \
 ./twi.o \
 ./uart.o 
 
 C_DEPS += \
+./adc.d \
 ./app2.d \
 ./buzzer.d \
+./cipher.d \
 ./dcmotor.d \
+./diag.d \
 ./eeprom.d \
 ./gpio.d \
+./hash.d \
 ./lcd.d \
+./link.d \
 ./mc2.d \
+./position.d \
+./prof.d \
 ./pwm.d \
+./rng.d \
+./sched.d \
+./systick.d \
 ./timer.d \
+./trace.d \
 ./twi.d \
 ./uart.d 
 
@@ -47,7 +80,7 @@ C_DEPS += \
 %.o: ../%.c subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
-	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=1000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	avr-gcc -Wall -g2 -gstabs -Os -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=1000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
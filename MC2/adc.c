@@ -0,0 +1,164 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<adc.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the free running ADC driver>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "adc.h"
+#include "common_macros.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static void(* volatile g_ADC_callBackPtr)(uint8 channel, uint16 average) = NULL_PTR;
+
+static volatile uint16 g_ADC_average[ADC_NUM_OF_CHANNELS];
+static uint16 g_ADC_sum[ADC_NUM_OF_CHANNELS];
+static uint8 g_ADC_samples[ADC_NUM_OF_CHANNELS];
+
+/*
+ * In the free running mode the next conversion has already started with the
+ * old ADMUX when the ISR runs, so a channel written in ADMUX is converted after
+ * the running conversion. The channels of the two conversions are kept.
+ */
+static uint8 g_ADC_resultChannel;		/* Channel of the conversion that just ended */
+static uint8 g_ADC_runningChannel;		/* Channel of the running conversion */
+
+/*--------------------------------FUNCTIONS PROTOTYPES(PRIVATE)-------------------------*/
+
+static uint8 ADC_nextChannel(uint8 channel);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	ADC_init
+ * [DESCRIPTION]:	This Function is used to initialize the ADC with AVCC as reference, the
+ * 					configured prescaler and the free running mode, then start the first
+ * 					conversion. The scanned pins are inputs without pull ups
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void ADC_init(void)
+{
+	uint8 channel = ADC_nextChannel(ADC_NUM_OF_CHANNELS - 1);
+	uint8 i;
+
+	for(i = 0; i < ADC_NUM_OF_CHANNELS; i++)
+	{
+		g_ADC_sum[i] = 0;
+		g_ADC_samples[i] = 0;
+	}
+
+	DDRA &= ~(ADC_CHANNELS);
+	PORTA &= ~(ADC_CHANNELS);
+
+	g_ADC_resultChannel = channel;
+	g_ADC_runningChannel = channel;
+	ADMUX = (1<<REFS0) | channel;
+
+	/* Free running is the auto trigger source 0 */
+	SFIOR &= ~((1<<ADTS2) | (1<<ADTS1) | (1<<ADTS0));
+	ADCSRA = (1<<ADEN) | (1<<ADSC) | (1<<ADATE) | (1<<ADIF) | (1<<ADIE) | ADC_PRESCALER;
+
+	/* Enable the global interrupt */
+	SREG |= (1<<7);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	ADC_deInit
+ * [DESCRIPTION]:	This Function is used to stop the conversions and turn the ADC off
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void ADC_deInit(void)
+{
+	ADCSRA = (1<<ADIF);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	ADC_getAverage
+ * [DESCRIPTION]:	This Function is used to get the last average of a scanned channel, the
+ * 					interrupts are disabled while the two bytes are read
+ * [ARGS]:		uint8 channel :	This Arg shall indicate the channel
+ * [RETURNS]:	The average of the channel, 0 before its first average is ready
+ ----------------------------------------------------------------------------------------*/
+uint16 ADC_getAverage(uint8 channel)
+{
+	uint16 average;
+	uint8 sreg = SREG;
+
+	cli();
+	average = g_ADC_average[channel];
+	SREG = sreg;
+
+	return average;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	ADC_setCallBack
+ * [DESCRIPTION]:	This Function is used to set the call back function called from the ISR
+ * 					each time a new average of a channel is ready
+ * [ARGS]:		void(*a_ptr)(uint8, uint16) :	This Arg shall indicate the call back function
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void ADC_setCallBack(void(*a_ptr)(uint8 channel, uint16 average))
+{
+	g_ADC_callBackPtr = a_ptr;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	ADC_nextChannel
+ * [DESCRIPTION]:	This Function is used to get the scanned channel after a channel
+ * [ARGS]:		uint8 channel :	This Arg shall indicate the current channel
+ * [RETURNS]:	The next scanned channel, it is the same channel if it is the only one
+ ----------------------------------------------------------------------------------------*/
+static uint8 ADC_nextChannel(uint8 channel)
+{
+	do
+	{
+		channel = (channel + 1) & (ADC_NUM_OF_CHANNELS - 1);
+	}while(BIT_IS_CLEAR(ADC_CHANNELS, channel));
+
+	return channel;
+}
+
+/*----------------------------------INTERRUPT SERVICE ROUTINES--------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [ISR NAME]:		ADC_vect
+ * [DESCRIPTION]:	This ISR is called at the end of each conversion. The result is added
+ * 					to the sum of its channel and the average is published when the sum
+ * 					holds 2^ADC_AVERAGE_SHIFT conversions
+ ----------------------------------------------------------------------------------------*/
+ISR(ADC_vect)
+{
+	uint8 channel = g_ADC_resultChannel;
+	uint8 next = ADC_nextChannel(g_ADC_runningChannel);
+	uint16 average;
+
+	g_ADC_sum[channel] += ADC;
+
+	/* Selected for the conversion after the running one */
+	ADMUX = (1<<REFS0) | next;
+	g_ADC_resultChannel = g_ADC_runningChannel;
+	g_ADC_runningChannel = next;
+
+	g_ADC_samples[channel]++;
+	if(g_ADC_samples[channel] >= (1<<ADC_AVERAGE_SHIFT))
+	{
+		average = g_ADC_sum[channel] >> ADC_AVERAGE_SHIFT;
+		g_ADC_average[channel] = average;
+		g_ADC_sum[channel] = 0;
+		g_ADC_samples[channel] = 0;
+
+		if(g_ADC_callBackPtr != NULL_PTR)
+		{
+			(*g_ADC_callBackPtr)(channel, average);
+		}
+	}
+}
@@ -0,0 +1,82 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<adc.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the free running ADC driver>
+ ---------------------------------------------------------------------------*/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+#define ADC_NUM_OF_CHANNELS		8		/* ADC0 to ADC7 on PORTA */
+#define ADC_MAX_VALUE			1023
+
+/* The scanned channels, one bit per channel. The ADC runs in the free running
+ * mode and the ISR moves to the next scanned channel after each conversion */
+#define ADC_CHANNELS			(1<<0)
+
+/* Each published value is the average of 2^ADC_AVERAGE_SHIFT conversions of
+ * the same channel */
+#define ADC_AVERAGE_SHIFT		3
+
+/* AVCC is the reference with a capacitor on AREF */
+#define ADC_REFERENCE_MV		5000
+
+/*
+ * The ADC clock shall be between 50 kHz and 200 kHz for the full resolution.
+ * A conversion takes 13 ADC clocks, so at 62.5 kHz there are 4808 conversions
+ * per second shared by the scanned channels. The smallest prescaler that does
+ * not exceed the wanted clock is selected.
+ */
+#define ADC_CLOCK_FREQUENCY		62500UL
+#define ADC_PRESCALER			\
+	(((F_CPU / 2UL) <= ADC_CLOCK_FREQUENCY) ? 1 :	\
+	 ((F_CPU / 4UL) <= ADC_CLOCK_FREQUENCY) ? 2 :	\
+	 ((F_CPU / 8UL) <= ADC_CLOCK_FREQUENCY) ? 3 :	\
+	 ((F_CPU / 16UL) <= ADC_CLOCK_FREQUENCY) ? 4 :	\
+	 ((F_CPU / 32UL) <= ADC_CLOCK_FREQUENCY) ? 5 :	\
+	 ((F_CPU / 64UL) <= ADC_CLOCK_FREQUENCY) ? 6 : 7)
+
+/* The ADC value of a voltage in mV on a channel */
+#define ADC_MILLIVOLTS(mv)		((uint16)(((uint32)(mv) * (ADC_MAX_VALUE + 1UL)) / ADC_REFERENCE_MV))
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to initialize the ADC and start the free running
+ * conversions of the scanned channels
+ */
+void ADC_init(void);
+
+
+/*
+ * Description:
+ * This Function is used to stop the conversions and turn the ADC off
+ */
+void ADC_deInit(void);
+
+
+/*
+ * Description:
+ * This Function is used to get the last average of a scanned channel
+ */
+uint16 ADC_getAverage(uint8 channel);
+
+
+/*
+ * Description:
+ * This Function is used to set the call back function called from the ISR
+ * each time a new average of a channel is ready
+ */
+void ADC_setCallBack(void(*a_ptr)(uint8 channel, uint16 average));
+
+#endif /* ADC_H_ */
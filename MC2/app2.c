@@ -13,35 +13,243 @@
 #include "app2.h"
 
 #include "uart.h"
-#include "timer.h"
+#include "systick.h"
+#include "sched.h"
 #include <util/delay.h>
+#include <avr/pgmspace.h>
+#include <avr/eeprom.h>
 
 #include "eeprom.h"
 #include "buzzer.h"
 #include "dcmotor.h"
+#include "position.h"
+#include "adc.h"
+#include "cipher.h"
+#include "hash.h"
+#include "link.h"
+#include "rng.h"
 
 #include "uart_commands.h"
+#include "prof.h"
+#include "trace.h"
+#include "diag.h"
+
+#if (PASSWORD_SIZE < HASH_VERIFY_SIZE)
+#error "The password buffers shall hold the HASH_VERIFY_SIZE bytes read by HASH_verify"
+#endif
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/* The door position is measured in encoder edges if the encoder is used, else it
+ * is estimated in ms of travel */
+#if (POSITION_ENCODER_ENABLE == TRUE)
+#define APP2_DOOR_TRAVEL		POSITION_OPEN_COUNT
+#else
+#define APP2_DOOR_TRAVEL		APP2_DOOR_MOTION_TIME
+#endif
+
+/* With a sensor the door moves until it reaches its end and the motion time is
+ * only a timeout, without sensors the motion time is the travel itself */
+#if ((POSITION_LIMIT_SWITCH_ENABLE == TRUE) || (POSITION_ENCODER_ENABLE == TRUE))
+#define APP2_DOOR_CLOSED_LOOP	TRUE
+#else
+#define APP2_DOOR_CLOSED_LOOP	FALSE
+#endif
+
+#define APP2_FAILURES_ERASED	0xFF	/* The failures record of an erased EEPROM */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	APP2_LINK_WAIT_COMMAND,		/* Waiting for a command from mC1 */
+	APP2_LINK_COLLECT_PASSWORD,	/* Receiving the encrypted password frame */
+	APP2_LINK_WAIT_SAVE,		/* Waiting for the attempt to be saved before its result */
+	APP2_LINK_WAIT_ACK			/* Waiting for mC1 to finish displaying a result */
+}APP2_LinkStateType;
+
+/* A row of the door phases table */
+typedef struct
+{
+	uint8 state;				/* State sent to mC1 when the phase starts */
+	uint8 direction;			/* DcMotor_State of the motor during the phase */
+	uint8 speed;				/* Duty cycle of the motor in percent */
+	uint16 time;				/* Time of the phase in ms, for a motion phase it is the
+								 * time of the full travel of the door */
+}APP2_DoorPhaseType;
+
+/* A row of the flows table, it describes a password check started by a command of mC1 */
+typedef struct
+{
+	uint8 command;			/* Command of mC1 that is followed by the password */
+	uint8 success_state;	/* State sent to mC1 when the password is correct */
+	uint8 retry_state;		/* State sent to mC1 to enter the password again */
+}APP2_PasswordFlowType;
+
+typedef struct
+{
+	uint16 address;
+	uint8 data;
+	uint8 record;		/* The bytes of a record are written all or from the first
+						 * dropped byte on not at all */
+}APP2_StorageRecordType;
 
 /*------------------------------------GLOBAL VARIABLES----------------------------------*/
 
-static volatile uint8 password[PASSWORD_SIZE];
-static volatile uint8 re_password[PASSWORD_SIZE];
+static uint8 password[PASSWORD_SIZE];
+static uint8 re_password[PASSWORD_SIZE];
+
+/* Only the salt and the hash of the saved password are kept */
+static uint8 g_APP2_salt[HASH_SALT_SIZE];
+static uint64 g_APP2_hash;
 
 uint8 g_pass_check = PASSWORD_FIRST_TIME;
 uint8 password_size = 0;
 uint8 re_password_size = 0;
 
-uint8 TIMER1_flagComplete = 0;
+/* The password checks of the system, a new flow only needs a new row. The
+ * OPEN_DOOR success state starts the whole door cycle */
+static const APP2_PasswordFlowType g_APP2_flows[] PROGMEM =
+{
+	{RECEIVE_RE_ENTERED_PASSWORD,	OPEN_MAIN_MENU,	ENTER_PASSWORD_AGAIN},
+	{RECEIVE_PASSWORD_IN_MAIN_MENU,	OPEN_DOOR,		ENTER_PASSWORD_AGAIN_MAIN_MENU}
+};
+
+#define APP2_NUM_OF_FLOWS	(sizeof(g_APP2_flows) / sizeof(g_APP2_flows[0]))
+#define APP2_NO_FLOW		0xFF
+
+static uint8 g_APP2_flow = APP2_NO_FLOW;	/* The flow of the password waiting for its result */
+static uint8 g_APP2_verdict;				/* The result of that password */
+static uint32 g_APP2_passwordNonce = 0;	/* Nonce of the last taken password frame */
+static boolean g_APP2_attemptSaved;		/* The record of that attempt is not dropped */
+
+/* Wrong attempts in a row of all the flows, the record in the EEPROM is written on
+ * every attempt. The lockout is a deadline on the system tick, without a clock that
+ * runs while mC2 is off it is started again in full after a reset */
+static uint8 g_APP2_failures = 0;
+static boolean g_APP2_locked = FALSE;
+static uint32 g_APP2_lockoutEnd;
+
+/* Boots of mC2, each boot reserves the 65536 challenges that start with its count so
+ * a challenge is never sent twice with the key after a reset */
+static uint16 g_APP2_bootCount EEMEM;
+static uint32 g_APP2_challenge = 0;
+
+/* Link task state */
+static APP2_LinkStateType g_APP2_linkState = APP2_LINK_WAIT_COMMAND;
+static uint8 g_APP2_linkCommand;		/* The command that the password belongs to */
+static uint8 *g_APP2_linkBuffer;		/* Where the password is saved */
+static LINK_FrameType g_APP2_linkFrame;	/* The message being received */
+static uint8 g_APP2_expectedAck;
+static uint8 g_APP2_nextState;			/* Sent to mC1 when the expected ack is received */
+
+/* The phases of the door, they are run in order from the first to the last phase
+ * of the requested sequence */
+static const APP2_DoorPhaseType g_APP2_doorPhases[APP2_DOOR_NUM_OF_PHASES] PROGMEM =
+{
+	{OPEN_DOOR,			CW,		APP2_DOOR_SPEED,	APP2_DOOR_MOTION_TIME},
+	{DOOR_IS_OPENED,	STOP,	0,					APP2_DOOR_HOLD_TIME},
+	{CLOSE_DOOR,		CCW,	APP2_DOOR_SPEED,	APP2_DOOR_MOTION_TIME}
+};
+
+/* Door task state */
+static uint8 g_APP2_doorRequestFirst;				/* The sequence asked by APP2_doorRequest */
+static uint8 g_APP2_doorRequestLast;
+static uint8 g_APP2_doorPhase = APP2_DOOR_NO_PHASE;	/* The running phase */
+static uint8 g_APP2_doorLastPhase;				/* The last phase of the sequence */
+static uint32 g_APP2_doorPhaseStart;				/* Tick of the start of the running phase */
+static uint32 g_APP2_doorPhaseEnd;				/* Deadline of the running phase */
+static uint16 g_APP2_doorStartPosition;			/* Door position at the start of the phase */
+#if (POSITION_ENCODER_ENABLE == TRUE)
+static sint16 g_APP2_doorLastCount;				/* Encoder count at the last door movement */
+static uint32 g_APP2_doorLastMove;				/* Tick of the last door movement */
+#endif
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+static volatile uint8 g_APP2_doorCurrentArmed = FALSE;	/* The current is watched after the inrush */
+static volatile uint8 g_APP2_doorOverCount;		/* Averages in a row above the current limit */
+static uint8 g_APP2_doorReversed;					/* The closing door was reversed once */
+#endif
+static uint8 g_APP2_doorControlCount;				/* Control periods since the last progress */
+static SYSTICK_TimerType g_APP2_doorTimer;
+static SYSTICK_TimerType g_APP2_doorControlTimer;
+
+static uint8 g_APP2_logIndex;						/* Next record of the fault log */
+
+/* Alarm task state */
+static SYSTICK_TimerType g_APP2_alarmTimer;		/* Stops the siren */
+static SYSTICK_TimerType g_APP2_lockoutTimer;		/* Reports the time left of the lockout */
+
+/* Storage task queue of the EEPROM bytes waiting to be written */
+static APP2_StorageRecordType g_APP2_storageQueue[APP2_STORAGE_QUEUE_SIZE];
+static uint8 g_APP2_storageHead = 0;
+static uint8 g_APP2_storageCount = 0;
+static uint8 g_APP2_storageRetries = 0;			/* Writes of the oldest byte not acknowledged */
+static uint8 g_APP2_storageFault = FALSE;			/* A drop is logged, until a byte is written again */
+static uint8 g_APP2_storageRecord = 0;			/* The record being queued */
+static boolean g_APP2_storageBroken = FALSE;		/* A byte of that record was refused */
+static SYSTICK_TimerType g_APP2_storageTimer;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void APP2_linkTask(uint8 events);
+static void APP2_doorTask(uint8 events);
+static void APP2_alarmTask(uint8 events);
+static void APP2_storageTask(uint8 events);
+
+static void APP2_linkRxNotify(void);
+static void APP2_doorTimeout(void);
+static void APP2_doorControlTimeout(void);
+static void APP2_doorLimitNotify(void);
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+static void APP2_doorCurrentNotify(uint8 channel, uint16 average);
+#endif
+static void APP2_alarmTimeout(void);
+static void APP2_storageTimeout(void);
+
+static void APP2_doorStartPhase(uint8 phase);
+static void APP2_doorNextPhase(uint8 phase);
+static void APP2_doorArrived(void);
+static void APP2_doorControl(void);
+static void APP2_doorProgress(uint16 position);
+static uint16 APP2_doorPosition(void);
+static void APP2_doorStop(void);
+static void APP2_doorFault(uint8 fault);
+static void APP2_logFault(uint8 fault);
+
+static void APP2_savePassword(void);
+static void APP2_saveEntropy(void);
+static uint8 APP2_saveFailures(uint8 failures);
+static void APP2_sendVerdict(void);
+static void APP2_lockoutStart(void);
+static uint16 APP2_lockoutSeconds(void);
+static void APP2_sendLockout(void);
+static void APP2_collectStart(uint8 *a_buffer, uint8 command);
+static void APP2_collectPassword(const LINK_FrameType *a_framePtr);
+static void APP2_linkChallenge(void);
+static boolean APP2_isRepeated(const LINK_FrameType *a_framePtr);
+static void APP2_repeatState(void);
+static uint8 APP2_findFlow(uint8 command);
+static void APP2_waitForAck(uint8 ack, uint8 next_state);
+static void APP2_sendState(uint8 state);
+static void APP2_storageBegin(void);
+static uint8 APP2_storageWrite(uint16 address, uint8 data);
+
 /*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
 /*---------------------------------------------------------------------------------------
  * [FUNCTION NAME]:	APP2_init
  * [DESCRIPTION]:	This Function is used to initialize the Application layer which contains
- * 					HAL, UART Drivers
+ * 					HAL, UART Drivers and the tasks of the scheduler
  * [ARGS]:		No Arguments
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
 void APP2_init(void)
 {
+	uint8 seed[RNG_SEED_SIZE];
+	uint8 i;
+
+	/* The free RAM is filled before the interrupts use the stack */
+	DIAG_init();
+
 	/*
 	 * UART configuration :
 	 * Parity bits: No bits
@@ -52,10 +260,67 @@ void APP2_init(void)
 	UART_configType UART_config = {OFF, EIGHT, ONE, 19200};
 	UART_init(&UART_config);
 
+	/* The trace has its own pin, the UART carries the link */
+	TRACE_INIT();
+
+	/* Timer1 is configured once here as the 1 kHz system tick, all the door and
+	 * alarm timings are deadlines on this tick */
+	SYSTICK_init();
+
+	/* The round keys of the link cipher are expanded once */
+	CIPHER_init();
+	LINK_init(LINK_MC2);
+
 	/* Initializing the hardware drivers */
 	EEPROM_init();
 	BUZZER_init();
 	DcMotor_Init();
+	POSITION_init();
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+	ADC_init();
+#endif
+
+	/* The fault log of an erased EEPROM starts from its first record */
+	EEPROM_readByte(EEPROM_LOG_INDEX_ADDRESS, &g_APP2_logIndex);
+	if(g_APP2_logIndex >= APP2_LOG_SIZE)
+	{
+		g_APP2_logIndex = 0;
+	}
+
+	/* A lockout that was running before the reset starts again */
+	EEPROM_readByte(EEPROM_FAILURES_ADDRESS, &g_APP2_failures);
+	if(g_APP2_failures == APP2_FAILURES_ERASED)
+	{
+		g_APP2_failures = 0;
+	}
+
+	/* Each received byte makes the link task ready */
+	SCHED_createTask(APP2_DOOR_TASK, APP2_doorTask);
+	SCHED_createTask(APP2_ALARM_TASK, APP2_alarmTask);
+	SCHED_createTask(APP2_LINK_TASK, APP2_linkTask);
+	SCHED_createTask(APP2_STORAGE_TASK, APP2_storageTask);
+	UART_setRxCallBack(APP2_linkRxNotify);
+	POSITION_setLimitCallBack(APP2_doorLimitNotify);
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+	ADC_setCallBack(APP2_doorCurrentNotify);
+#endif
+
+	/* The entropy pool starts from the seed of the last boot, a new seed is saved at
+	 * once so the next boot never starts from the same one */
+	for(i = 0; i < RNG_SEED_SIZE; i++)
+	{
+		EEPROM_readByte(EEPROM_RNG_SEED_ADDRESS+i, &seed[i]);
+	}
+	RNG_init(seed);
+	APP2_saveEntropy();
+
+	if(g_APP2_failures >= APP2_LOCKOUT_FREE_ATTEMPTS)
+	{
+		APP2_lockoutStart();
+	}
+
+	/* The first state is sent when mC1 asks for it in the session */
+	APP2_linkChallenge();
 }
 
 /*---------------------------------------------------------------------------------------
@@ -67,426 +332,1423 @@ void APP2_init(void)
  ----------------------------------------------------------------------------------------*/
 void APP2_checkForFirstTime(void)
 {
-	uint8 i = 0;
+	uint8 byte;
+	uint8 i;
+
+	/* The saved record is already in RAM after a new password or a former session,
+	 * its bytes may still be waiting in the storage queue */
+	if(g_pass_check == PASSWORD_HASHED)
+	{
+		LINK_send(RE_ENTER_PASSWORD, NULL_PTR, 0);
+		return;
+	}
 
-	/* Read the EEPROM password check flag whether it's 0 or 1
-	 * 0: It's the first time for the user to enter the password in EEPROM
-	 * 1: The user entered a password in EEPROM before */
+	/* Read the EEPROM password check flag
+	 * 255: It's the first time for the user to enter the password in EEPROM
+	 * 0: The password was saved in clear by an old version, it is hashed now
+	 * 1: The salt and the hash of the password are saved */
 	EEPROM_readByte(EEPROM_ADDRESS_FLAG, &g_pass_check);
 	_delay_ms(EEPROM_FRAME_DELAY);
 
-	/* if the user is entering the password for the first time, the flag
-	 * would by 0. Else if the user entered the password before, the flag
-	 * will be 1 */
 	if(g_pass_check == PASSWORD_FIRST_TIME)
 	{
-		UART_sendByte(ASK_FOR_NEW_PASSWORD);
+		LINK_send(ASK_FOR_NEW_PASSWORD, NULL_PTR, 0);
+		return;
 	}
-	else
+
+	/* The reads do not wait for a write cycle */
+	if(g_pass_check == PASSWORD_NOT_FIRST_TIME)
 	{
-		/*
-		 * If the password is entered in the EEPROM before, enter EEPROM
-		 * to get password, password size, and send a confirmation
-		 */
 		EEPROM_readByte(EEPROM_PASS_SIZE, &password_size);
-		_delay_ms(EEPROM_FRAME_DELAY);
-		do
+		if(password_size > (PASSWORD_SIZE - 1))
+		{
+			password_size = PASSWORD_SIZE - 1;
+		}
+		for(i = 0; i < password_size; i++)
+		{
+			EEPROM_readByte(EEPROM_PASS_ADDRESS+i, &password[i]);
+		}
+
+		/* The hash overwrites the clear password, its size is erased too only if
+		 * the hash is written */
+		APP2_savePassword();
+		APP2_storageWrite(EEPROM_PASS_SIZE, 0xFF);
+		APP2_saveEntropy();
+	}
+	else
+	{
+		for(i = 0; i < HASH_SALT_SIZE; i++)
+		{
+			EEPROM_readByte(EEPROM_SALT_ADDRESS+i, &g_APP2_salt[i]);
+		}
+		for(i = HASH_SIZE; i > 0; i--)
 		{
-			EEPROM_readByte(EEPROM_PASS_ADDRESS+i,&password[i]);
-			_delay_ms(EEPROM_FRAME_DELAY);
-			i++;
-		}while(i<password_size);
-		UART_sendByte(RE_ENTER_PASSWORD);
+			EEPROM_readByte(EEPROM_HASH_ADDRESS+i-1, &byte);
+			g_APP2_hash = (g_APP2_hash << 8) | byte;
+		}
 	}
+	LINK_send(RE_ENTER_PASSWORD, NULL_PTR, 0);
 }
 
 
+
 /*---------------------------------------------------------------------------------------
  * [FUNCTION NAME]:	APP2_receivePassword
- * [DESCRIPTION]:	This Function is used to receive password sent from mC1
+ * [DESCRIPTION]:	This Function is used to save the hash of the new password received from
+ * 					mC1, the EEPROM bytes are queued for the storage task so the link is not
+ * 					blocked during the EEPROM write cycles
  * [ARGS]:		No Arguments
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
 void APP2_receivePassword(void)
 {
-	uint8 i = 0;
-	/* Set the password check flag to (NOT FIRST TIME) to describe that the password
-	 * is set before for further accessing */
-	g_pass_check = PASSWORD_NOT_FIRST_TIME;
-	EEPROM_writeByte(EEPROM_ADDRESS_FLAG, g_pass_check);
-	_delay_ms(EEPROM_FRAME_DELAY);
-
-	UART_receiveString(password);
-
-	while(password[i] != '\0')
-	{
-		EEPROM_writeByte( EEPROM_START_BYTE+i , password[i]);
-		_delay_ms(EEPROM_FRAME_DELAY);
-		i++;
-	}
-	/* Set the given password size in a global variable called password_size */
-	password_size = i;
-
-	/* Write the password size in EEPROM_PASS_SIZE location */
-	EEPROM_writeByte(EEPROM_PASS_SIZE, i);
-	_delay_ms(EEPROM_FRAME_DELAY);
+	PROF_BEGIN(PROF_EEPROM_COMMIT);
+	APP2_savePassword();
+	APP2_saveEntropy();
 
 	/* Send UART command to tell mC1 that the new password is received to initiate
 	 * further processes */
-	UART_sendByte(NEWEST_PASSWORD_RECEIVED);
+	LINK_send(NEWEST_PASSWORD_RECEIVED, NULL_PTR, 0);
 }
 
 
 /*---------------------------------------------------------------------------------------
  * [FUNCTION NAME]:	APP2_receiveCommand
- * [DESCRIPTION]:	This Function is used to receive commands sent from mC1
- * [ARGS]:		No Arguments
+ * [DESCRIPTION]:	This Function is used to handle a command sent from mC1, the commands
+ * 					followed by a password make the link task collect the password first
+ * [ARGS]:		uint8 command :	This Arg shall indicate the received command
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-uint8 APP2_receiveCommand(void)
+void APP2_receiveCommand(uint8 command)
 {
-	return UART_receiveByte();
-}
+	switch(command)
+	{
+	case RECEIVE_NEWEST_PASSWORD :
+		APP2_collectStart(password, command);
+		break;
 
+	case OPEN_DOOR :
+		APP2_doorRequest(APP2_DOOR_PHASE_OPEN, APP2_DOOR_PHASE_OPEN);
+		break;
 
-/*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_receiveCommand
- * [DESCRIPTION]:	This Function is used to check the validity of the re-entered password
- * 					by comparing it to the saved password in EEPROM
- * [ARGS]:		No Arguments
- * [RETURNS]:	No Returns
- ----------------------------------------------------------------------------------------*/
-uint8 APP2_checkPassword(void)
-{
-	uint8 flag = TRUE;
-	uint8 i = 0;
-	if(re_password_size != password_size)
-	{
-		flag = FALSE;
-	}
-	else
-	{
-		while(password[i] != '\0')
+	case CLOSE_DOOR :
+		APP2_doorRequest(APP2_DOOR_PHASE_CLOSE, APP2_DOOR_PHASE_CLOSE);
+		break;
+
+	case DOOR_REOPEN :
+		SCHED_setEvent(APP2_DOOR_TASK, APP2_EVENT_DOOR_REOPEN);
+		break;
+
+	case DOOR_ABORT :
+		SCHED_setEvent(APP2_DOOR_TASK, APP2_EVENT_DOOR_ABORT);
+		break;
+
+	case SEND_CORRECT :
+	case SEND_WRONG :
+		/* An ack already taken, mC1 repeats it when it misses the next state */
+		APP2_repeatState();
+		break;
+
+	default :
+		/* The other password commands are found in the flows table */
+		if(APP2_findFlow(command) != APP2_NO_FLOW)
 		{
-			if(re_password[i] != password[i])
-			{
-				flag = FALSE;
-				break;
-			}
-			i++;
+			APP2_collectStart(re_password, command);
 		}
+		break;
 	}
-	return flag;
 }
 
 
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_receiveAndCheckPassword
- * [DESCRIPTION]:	This Function is used to receive and check for the validity of the entered
- * 					password for the first time
+ * [FUNCTION NAME]:	APP2_checkPassword
+ * [DESCRIPTION]:	This Function is used to check the validity of the re-entered password
+ * 					by comparing its hash to the hash of the saved password
  * [ARGS]:		No Arguments
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void APP2_receiveAndCheckPassword(void)
+uint8 APP2_checkPassword(void)
 {
-	uint8 counter = 0;
+	uint8 flag;
+	uint8 i;
 
-	UART_receiveString(re_password);
+	/* One hash per attempt over the whole zero padded buffer, the time does not
+	 * depend on the size or on the digits of the attempt */
+	PROF_BEGIN(PROF_PASSWORD_CHECK);
+	flag = HASH_verify(g_APP2_salt, re_password, re_password_size, g_APP2_hash);
+	PROF_END(PROF_PASSWORD_CHECK);
 
-	/* A loop to get the size of the re-entered password to use it in
-	 * checking for re-password validity */
-	while(re_password[counter] != '\0')
+	for(i = 0; i < PASSWORD_SIZE; i++)
 	{
-		counter++;
+		re_password[i] = 0;
 	}
-	re_password_size = counter;
 
-	switch(APP2_checkPassword())
-	{
-	case TRUE :
-		/* Hand shaking method is used to send a command to mC1 that the password
-		 * is correct to display on LCD screen then wait mC1 to send that it finished
-		 * displaying the message. Also same goes for wrong password */
-		UART_sendByte(SEND_CORRECT);
-		while(UART_receiveByte() != SEND_CORRECT){}
-		UART_sendByte(OPEN_MAIN_MENU);
-		break;
-	case FALSE :
-		UART_sendByte(SEND_WRONG);
-		while(UART_receiveByte() != SEND_WRONG){}
-		UART_sendByte(ENTER_PASSWORD_AGAIN);
-		break;
-	}
+	return flag;
 }
 
 
+
+
 /*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_receiveAndCheckPassword2
- * [DESCRIPTION]:	This Function is used to receive and check for the validity of the entered
- * 					password for the second time
- * [ARGS]:		No Arguments
+ * [FUNCTION NAME]:	APP2_handlePassword
+ * [DESCRIPTION]:	This Function is used to check the received password for the flow of the
+ * 					given command. The attempt is saved in the failures record before its
+ * 					result is sent, so switching mC2 off once the password is received does
+ * 					not give a free attempt. No password is checked during a lockout
+ * [ARGS]:		uint8 command :	This Arg shall indicate the command the password followed
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void APP2_receiveAndCheckPassword2(void)
+void APP2_handlePassword(uint8 command)
 {
-	uint8 counter = 0;
-	UART_receiveString(re_password);
+	uint8 i;
 
-	while(re_password[counter] != '\0')
+	g_APP2_flow = APP2_findFlow(command);
+	if(g_APP2_flow == APP2_NO_FLOW)
 	{
-		counter++;
+		return;
 	}
-	re_password_size = counter;
 
-	switch(APP2_checkPassword())
+	if(g_APP2_locked == TRUE)
 	{
-	case TRUE :
-		UART_sendByte(SEND_CORRECT);
-		while(UART_receiveByte() != SEND_CORRECT){}
-		UART_sendByte(OPEN_MAIN_MENU);
-		break;
-	case FALSE :
-		UART_sendByte(SEND_WRONG);
-		while(UART_receiveByte() != SEND_WRONG){}
-		UART_sendByte(ENTER_PASSWORD2_AGAIN);
-		break;
+		for(i = 0; i < PASSWORD_SIZE; i++)
+		{
+			re_password[i] = 0;
+		}
+		LINK_send(ALARM_ON, NULL_PTR, 0);
+		APP2_sendLockout();
+		return;
 	}
-}
-
-
-/*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_receiveAndCheckPassword3
- * [DESCRIPTION]:	This Function is used to receive and check for the validity of the entered
- * 					password for the third time
- * [ARGS]:		No Arguments
- * [RETURNS]:	No Returns
- ----------------------------------------------------------------------------------------*/
-void APP2_receiveAndCheckPassword3(void)
-{
-	uint8 counter = 0;
-	UART_receiveString(re_password);
 
-	while(re_password[counter] != '\0')
+	/* The record is written for a right password too, the result is always sent
+	 * after one write cycle */
+	g_APP2_verdict = APP2_checkPassword();
+	if(g_APP2_verdict == TRUE)
 	{
-		counter++;
+		g_APP2_attemptSaved = APP2_saveFailures(0);
 	}
-	re_password_size = counter;
-
-	switch(APP2_checkPassword())
+	else if(g_APP2_failures < (APP2_FAILURES_ERASED - 1))
 	{
-	case TRUE :
-		UART_sendByte(SEND_CORRECT);
-		while(UART_receiveByte() != SEND_CORRECT){}
-		UART_sendByte(OPEN_MAIN_MENU);
-		break;
-	case FALSE :
-		APP2_setAlarmON();
-		break;
+		DIAG_count(DIAG_FAILED_ATTEMPTS);
+		g_APP2_attemptSaved = APP2_saveFailures(g_APP2_failures + 1);
 	}
+	else
+	{
+		DIAG_count(DIAG_FAILED_ATTEMPTS);
+		g_APP2_attemptSaved = APP2_saveFailures(g_APP2_failures);
+	}
+
+	/* The storage task makes the link task ready when the queue is written */
+	g_APP2_linkState = APP2_LINK_WAIT_SAVE;
 }
 
 
 /*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_receiveAndCheckPassword_mainMenu
- * [DESCRIPTION]:	This Function is used to receive and check for the validity of the entered
- * 					password in the main menu in the Door open option for the first time
- * [ARGS]:		No Arguments
+ * [FUNCTION NAME]:	APP2_doorRequest
+ * [DESCRIPTION]:	This Function is used to ask the door task to run the door phases from
+ * 					the first phase to the last phase. The door task moves to the next
+ * 					phase when the running phase reaches its end
+ * [ARGS]:		uint8 first_phase :	This Arg shall indicate the first phase to run
+ * 				uint8 last_phase :	This Arg shall indicate the last phase to run
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void APP2_receiveAndCheckPassword_mainMenu(void)
+void APP2_doorRequest(uint8 first_phase, uint8 last_phase)
 {
-	UART_receiveString(re_password);
-
-	switch(APP2_checkPassword())
+	if((first_phase > last_phase) || (last_phase >= APP2_DOOR_NUM_OF_PHASES))
 	{
-	case TRUE :
-		UART_sendByte(SEND_CORRECT);
-		while(UART_receiveByte() != SEND_CORRECT){}
-		APP2_openDoor();
-		APP2_doorStop();
-		APP2_closeDoor();
-		break;
-	case FALSE :
-		UART_sendByte(SEND_WRONG);
-		while(UART_receiveByte() != SEND_WRONG){}
-		UART_sendByte(ENTER_PASSWORD_AGAIN_MAIN_MENU);
-		break;
+		return;
 	}
+
+	g_APP2_doorRequestFirst = first_phase;
+	g_APP2_doorRequestLast = last_phase;
+	SCHED_setEvent(APP2_DOOR_TASK, APP2_EVENT_START);
 }
 
 
 /*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_receiveAndCheckPassword2_mainMenu
- * [DESCRIPTION]:	This Function is used to receive and check for the validity of the entered
- * 					password in the main menu in the Door open option for the second time
+ * [FUNCTION NAME]:	APP2_setAlarmON
+ * [DESCRIPTION]:	This Function is used set the ALARM on and start the lockout, the alarm
+ * 					task runs it without blocking the other tasks
  * [ARGS]:		No Arguments
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void APP2_receiveAndCheckPassword2_mainMenu(void)
+void APP2_setAlarmON(void)
 {
-	UART_receiveString(re_password);
-
-	switch(APP2_checkPassword())
-	{
-	case TRUE :
-		UART_sendByte(SEND_CORRECT);
-		while(UART_receiveByte() != SEND_CORRECT){}
-		APP2_openDoor();
-		APP2_doorStop();
-		APP2_closeDoor();
-		break;
-	case FALSE :
-		UART_sendByte(SEND_WRONG);
-		while(UART_receiveByte() != SEND_WRONG){}
-		UART_sendByte(ENTER_PASSWORD2_AGAIN_MAIN_MENU);
-		break;
-	}
+	SCHED_setEvent(APP2_ALARM_TASK, APP2_EVENT_START);
 }
 
-
-/*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_receiveAndCheckPassword3_mainMenu
- * [DESCRIPTION]:	This Function is used to receive and check for the validity of the entered
- * 					password in the main menu in the Door open option for the third time
- * [ARGS]:		No Arguments
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_linkTask
+ * [DESCRIPTION]:	This Task is used to handle all the messages received from mC1. The
+ * 					bytes are given to the link layer which only passes the frames of the
+ * 					session with a right MAC and sequence. It never waits for a byte, it
+ * 					keeps the state of the link and returns when the ring buffer of the
+ * 					UART is empty
+ * [ARGS]:		uint8 events :	This Arg shall indicate the events of the task
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void APP2_receiveAndCheckPassword3_mainMenu(void)
+static void APP2_linkTask(uint8 events)
 {
-	UART_receiveString(re_password);
+	LINK_StatusType status;
 
-	switch(APP2_checkPassword())
+	/* The attempt is saved, its result can be sent */
+	if((events & APP2_EVENT_START) && (g_APP2_linkState == APP2_LINK_WAIT_SAVE))
 	{
-	case TRUE :
-		UART_sendByte(SEND_CORRECT);
-		while(UART_receiveByte() != SEND_CORRECT){}
-		APP2_openDoor();
-		APP2_doorStop();
-		APP2_closeDoor();
-		break;
-	case FALSE :
-		APP2_setAlarmON();
-		break;
+		APP2_sendVerdict();
 	}
-}
 
+	while(UART_isDataAvailable() == TRUE)
+	{
+		status = LINK_receive(UART_receiveByte(), &g_APP2_linkFrame);
 
-/*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_openDoor
- * [DESCRIPTION]:	This Function is used to open the door by operating the motor in CW
- * 					direction
- * [ARGS]:		No Arguments
- * [RETURNS]:	No Returns
- ----------------------------------------------------------------------------------------*/
-void APP2_openDoor(void)
-{
-	UART_sendByte(OPEN_DOOR);
+		if(status == LINK_PLAIN)
+		{
+			/* mC1 asks for a new session after its reset */
+			if(g_APP2_linkFrame.command == LINK_HELLO)
+			{
+				APP2_linkChallenge();
+			}
+			else if(g_APP2_linkFrame.command == PROFILE_DUMP)
+			{
+				PROF_DUMP();
+			}
+			else if(g_APP2_linkFrame.command == DIAGNOSTICS)
+			{
+				DIAG_send();
+			}
+			continue;
+		}
 
-	/* Open Door process */
-	DcMotor_Rotate(CW,75);
-	TIMER1_delay_ms(15000);
-	DcMotor_deInit();
-}
+		/* The frames of mC1 are rejected in a row, the session is started again */
+		if(status == LINK_LOST)
+		{
+			APP2_linkChallenge();
+			continue;
+		}
 
+		/* Forged and replayed frames are dropped */
+		if(status != LINK_FRAME)
+		{
+			continue;
+		}
 
-/*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_doorStop
- * [DESCRIPTION]:	This Function is used to stop motor operation
- * [ARGS]:		No Arguments
- * [RETURNS]:	No Returns
- ----------------------------------------------------------------------------------------*/
-void APP2_doorStop(void)
-{
-	UART_sendByte(DOOR_IS_OPENED);
+		/* The session is opened, mC1 sends its last request again or asks for the
+		 * state, the exchange goes on from where it was */
+		if(g_APP2_linkFrame.command == LINK_RESPONSE)
+		{
+			continue;
+		}
 
-	/* Stop Door process */
-	DcMotor_Rotate(STOP,0);
-	TIMER1_delay_ms(3000);
-	DcMotor_deInit();
-}
+		/* mC1 is reset, a password being collected is dropped. The result of a
+		 * saved password is sent anyway */
+		if(g_APP2_linkFrame.command == STATE_REQUEST)
+		{
+			if(g_APP2_linkState == APP2_LINK_COLLECT_PASSWORD)
+			{
+				g_APP2_linkState = APP2_LINK_WAIT_COMMAND;
+			}
+			if(g_APP2_linkState != APP2_LINK_WAIT_SAVE)
+			{
+				APP2_repeatState();
+			}
+			continue;
+		}
 
+		/* A password is taken once, mC1 repeats it when it misses the result */
+		if(APP2_isRepeated(&g_APP2_linkFrame) == TRUE)
+		{
+			if(g_APP2_linkState != APP2_LINK_WAIT_SAVE)
+			{
+				APP2_repeatState();
+			}
+			continue;
+		}
 
-/*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_closeDoor
- * [DESCRIPTION]:	This Function is used to close the door by operating the motor in CCW
- * 					direction
- * [ARGS]:		No Arguments
- * [RETURNS]:	No Returns
- ----------------------------------------------------------------------------------------*/
-void APP2_closeDoor(void)
-{
-	UART_sendByte(CLOSE_DOOR);
+		/* A key press of mC1 may come in the middle of any exchange */
+		if(g_APP2_linkFrame.command == KEY_PRESSED)
+		{
+			BUZZER_play(BUZZER_BEEP);
+			continue;
+		}
 
-	/* Close Door process */
-	DcMotor_Rotate(CCW,75);
-	TIMER1_delay_ms(15000);
-	DcMotor_deInit();
+		TRACE(TRACE_APP2_COMMAND, g_APP2_linkFrame.command, g_APP2_linkState);
+		switch(g_APP2_linkState)
+		{
+		case APP2_LINK_WAIT_COMMAND :
+			APP2_receiveCommand(g_APP2_linkFrame.command);
 
-	UART_sendByte(OPEN_MAIN_MENU);
-}
+			/* The password frame repeats its command, it is taken if the command
+			 * frame is lost */
+			if((g_APP2_linkState == APP2_LINK_COLLECT_PASSWORD) && (g_APP2_linkFrame.size != 0))
+			{
+				APP2_collectPassword(&g_APP2_linkFrame);
+			}
+			break;
+
+		case APP2_LINK_COLLECT_PASSWORD :
+			/* The password frame repeats the command it follows */
+			if(g_APP2_linkFrame.command == g_APP2_linkCommand)
+			{
+				APP2_collectPassword(&g_APP2_linkFrame);
+			}
+			break;
 
+		case APP2_LINK_WAIT_SAVE :
+			/* mC1 waits for the result of its password */
+			break;
 
-/*-----------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	APP2_closeDoor
- * [DESCRIPTION]:	This Function is used set the ALARM on
- * [ARGS]:		No Arguments
+		case APP2_LINK_WAIT_ACK :
+			/* Any other frame is ignored until mC1 finishes displaying the result */
+			if(g_APP2_linkFrame.command == g_APP2_expectedAck)
+			{
+				g_APP2_linkState = APP2_LINK_WAIT_COMMAND;
+				APP2_sendState(g_APP2_nextState);
+			}
+			break;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorTask
+ * [DESCRIPTION]:	This Task is used to run the door phases. It starts the requested
+ * 					sequence, moves to the next phase when the running phase reaches its
+ * 					end, and watches the door from the control period while it moves
+ * [ARGS]:		uint8 events :	This Arg shall indicate the events of the task
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void APP2_setAlarmON(void)
+static void APP2_doorTask(uint8 events)
 {
-	UART_sendByte(ALARM_ON);
+	if(events & APP2_EVENT_DOOR_ABORT)
+	{
+		if(g_APP2_doorPhase != APP2_DOOR_NO_PHASE)
+		{
+			/* An abort stops the motor at once without a ramp */
+			APP2_doorStop();
+			DcMotor_Rotate(STOP,0);
+			DcMotor_deInit();
+			LINK_send(OPEN_MAIN_MENU, NULL_PTR, 0);
+		}
+		return;
+	}
+
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+	if((events & APP2_EVENT_OVERCURRENT) && (g_APP2_doorCurrentArmed == TRUE))
+	{
+		if((g_APP2_doorPhase == APP2_DOOR_PHASE_CLOSE) && (g_APP2_doorReversed == FALSE))
+		{
+			/* The door is stopped at once then opened again, the whole cycle continues */
+			g_APP2_doorReversed = TRUE;
+			APP2_logFault(APP2_FAULT_OBSTACLE);
+			DcMotor_Rotate(STOP,0);
+			g_APP2_doorLastPhase = APP2_DOOR_PHASE_CLOSE;
+			APP2_doorStartPhase(APP2_DOOR_PHASE_OPEN);
+		}
+		else
+		{
+			APP2_doorFault(APP2_FAULT_OVERCURRENT);
+		}
+		return;
+	}
+#endif
 
-	/* ALARM ON process */
-	BUZZER_ON();
-	TIMER1_delay_ms(60000);
-	BUZZER_OFF();
+	if(events & APP2_EVENT_START)
+	{
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+		g_APP2_doorReversed = FALSE;
+#endif
+		g_APP2_doorLastPhase = g_APP2_doorRequestLast;
+		APP2_doorStartPhase(g_APP2_doorRequestFirst);
+	}
+	else if(events & APP2_EVENT_DOOR_REOPEN)
+	{
+		/* The door is opened again from where it is then the whole cycle continues */
+		if(g_APP2_doorPhase == APP2_DOOR_PHASE_CLOSE)
+		{
+			g_APP2_doorLastPhase = APP2_DOOR_PHASE_CLOSE;
+			APP2_doorStartPhase(APP2_DOOR_PHASE_OPEN);
+		}
+	}
+	/* The deadline is checked too as the timer event of a phase that was replaced
+	 * may be still pending */
+	else if((events & APP2_EVENT_TIMEOUT) && (g_APP2_doorPhase != APP2_DOOR_NO_PHASE)
+			&& (SYSTICK_isExpired(g_APP2_doorPhaseEnd) == TRUE))
+	{
+		if(pgm_read_byte(&g_APP2_doorPhases[g_APP2_doorPhase].direction) == STOP)
+		{
+			APP2_doorNextPhase(g_APP2_doorPhase);
+		}
+		else
+		{
+#if (APP2_DOOR_CLOSED_LOOP == TRUE)
+			/* The sensor did not see the end of the travel in time */
+			APP2_doorFault(APP2_FAULT_TIMEOUT);
+#else
+			APP2_doorArrived();
+#endif
+		}
+	}
 
-	UART_sendByte(NEWEST_PASSWORD_RECEIVED);
+	if((events & (APP2_EVENT_LIMIT | APP2_EVENT_CONTROL)) && (g_APP2_doorControlTimer.active == TRUE))
+	{
+		APP2_doorControl();
+	}
 }
 
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	TIMER1_countProcessing
- * [DESCRIPTION]:	This Function is used to count ticks for Timer1 driver, the function
- * 					will set the Timer1 flag to 1 if the ticks are equal to the input
- * 					milliseconds
- * [ARGS]:		No Arguments
+ * [FUNCTION NAME]:	APP2_alarmTask
+ * [DESCRIPTION]:	This Task is used to play the siren for APP2_ALARM_TIME and run the
+ * 					lockout. The time left is sent to mC1 every APP2_LOCKOUT_REPORT_TIME,
+ * 					when the lockout ends mC1 is told to ask for the password again
+ * [ARGS]:		uint8 events :	This Arg shall indicate the events of the task
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void TIMER1_countProcessing(uint16 g_msec1)
+static void APP2_alarmTask(uint8 events)
 {
-	g_tick1++;
-	if(g_tick1 == g_msec1)
+	if(events & APP2_EVENT_START)
+	{
+		LINK_send(ALARM_ON, NULL_PTR, 0);
+
+		/* ALARM ON process, the siren is played by the system tick timers */
+		BUZZER_play(BUZZER_SIREN);
+		SYSTICK_startTimer(&g_APP2_alarmTimer, APP2_ALARM_TIME, SYSTICK_ONE_SHOT, BUZZER_stop);
+		APP2_lockoutStart();
+		APP2_sendLockout();
+	}
+	else if((events & APP2_EVENT_TIMEOUT) && (g_APP2_locked == TRUE))
 	{
-		TIMER1_flagComplete = 1;
-		g_tick1 = 0;
+		if(APP2_lockoutSeconds() != 0)
+		{
+			APP2_sendLockout();
+		}
+		else
+		{
+			/* One more attempt is allowed before the next lockout */
+			g_APP2_locked = FALSE;
+			SYSTICK_stopTimer(&g_APP2_lockoutTimer);
+			SYSTICK_stopTimer(&g_APP2_alarmTimer);
+			BUZZER_stop();
+			APP2_checkForFirstTime();
+		}
 	}
 }
 
-
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	TIMER1_delay_ms
- * [DESCRIPTION]:	This Function is used to give a delay process according to the give
- * 					milliseconds
- * [ARGS]:		No Arguments
+ * [FUNCTION NAME]:	APP2_storageTask
+ * [DESCRIPTION]:	This Task is used to write the queued bytes in the EEPROM, one byte
+ * 					per run, then it waits for the EEPROM write cycle using its timer. A
+ * 					byte that the EEPROM did not acknowledge is written again after it, up
+ * 					to APP2_STORAGE_RETRIES times, then it is dropped and a storage fault
+ * 					is logged. The fault is logged once until a byte is written again, so
+ * 					a dead EEPROM does not fill the queue with its own fault records
+ * [ARGS]:		uint8 events :	This Arg shall indicate the events of the task
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void TIMER1_delay_ms(uint16 seconds)
+static void APP2_storageTask(uint8 events)
 {
-	/*
-	 * Timer is initialized here because we need to init then de-init it
-	 * after each function.
-	 * As we're using a prescalar of 64, then every count takes 8 u.sec,
-	 * so we need 125 counts to get 1 m.sec
-	 */
-	TIMER_ConfigType TIMER1_config = {TIMER1,0,0,CTC_T1,CHANNEL_A,FCPU_64_T1,0,0,0,125};
-	TIMER_init(&TIMER1_config);
-	TIMER1_setCallBack(TIMER1_countProcessing);
+	uint8 index;
+	uint8 record;
 
-	g_tick1 = 0;
-	g_msec1 = seconds;
+	/* A new request while the EEPROM is busy is served when the write cycle ends */
+	if(g_APP2_storageTimer.active == TRUE)
+	{
+		return;
+	}
+	(void)events;
 
-	while(TIMER1_flagComplete != 1){}
-	TIMER1_flagComplete = 0;
+	/* The write cycle of the last byte ended, the whole queue is in the EEPROM */
+	if(g_APP2_storageCount == 0)
+	{
+		PROF_END(PROF_EEPROM_COMMIT);
+		if(g_APP2_linkState == APP2_LINK_WAIT_SAVE)
+		{
+			SCHED_setEvent(APP2_LINK_TASK, APP2_EVENT_START);
+		}
+		return;
+	}
 
-	TIMER1_deInit();
+	index = (uint8)(g_APP2_storageHead + APP2_STORAGE_QUEUE_SIZE - g_APP2_storageCount) % APP2_STORAGE_QUEUE_SIZE;
+	if(EEPROM_writeByte(g_APP2_storageQueue[index].address, g_APP2_storageQueue[index].data) == SUCCESS)
+	{
+		DIAG_count(DIAG_EEPROM_WRITES);
+		g_APP2_storageCount--;
+		g_APP2_storageRetries = 0;
+		g_APP2_storageFault = FALSE;
+	}
+	else if(g_APP2_storageRetries < APP2_STORAGE_RETRIES)
+	{
+		DIAG_count(DIAG_TWI_RETRIES);
+		g_APP2_storageRetries++;
+	}
+	else
+	{
+		/* The rest of the record is dropped with the byte, a record is never
+		 * completed over a missing byte */
+		record = g_APP2_storageQueue[index].record;
+		do
+		{
+			DIAG_count(DIAG_EEPROM_DROPS);
+			if(g_APP2_storageQueue[index].address == EEPROM_FAILURES_ADDRESS)
+			{
+				g_APP2_attemptSaved = FALSE;
+			}
+			g_APP2_storageCount--;
+			index = (index + 1) % APP2_STORAGE_QUEUE_SIZE;
+		}while((g_APP2_storageCount > 0) && (g_APP2_storageQueue[index].record == record));
+		g_APP2_storageRetries = 0;
+		if(g_APP2_storageFault == FALSE)
+		{
+			g_APP2_storageFault = TRUE;
+			APP2_logFault(APP2_FAULT_STORAGE);
+		}
+	}
+
+	SYSTICK_startTimer(&g_APP2_storageTimer, EEPROM_WRITE_CYCLE_TIME, SYSTICK_ONE_SHOT, APP2_storageTimeout);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorStartPhase
+ * [DESCRIPTION]:	This Function is used to start a door phase. Without sensors a motion
+ * 					phase only lasts for the travel left from the current position of the
+ * 					door, with sensors it lasts until the end of the travel is seen and
+ * 					the motion time is its timeout
+ * [ARGS]:		uint8 phase :	This Arg shall indicate the phase to start
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorStartPhase(uint8 phase)
+{
+	DcMotor_State direction = (DcMotor_State)pgm_read_byte(&g_APP2_doorPhases[phase].direction);
+	uint16 time = pgm_read_word(&g_APP2_doorPhases[phase].time);
+
+	g_APP2_doorStartPosition = APP2_doorPosition();
+#if (APP2_DOOR_CLOSED_LOOP == TRUE)
+	if(direction != STOP)
+	{
+		time += APP2_DOOR_TIMEOUT_MARGIN;
+	}
+#else
+	if(direction == CW)
+	{
+		time = APP2_DOOR_MOTION_TIME - g_APP2_doorStartPosition;
+	}
+	else if(direction == CCW)
+	{
+		time = g_APP2_doorStartPosition;
+	}
+#endif
+
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+	g_APP2_doorCurrentArmed = FALSE;
+#endif
+	g_APP2_doorPhase = phase;
+	TRACE(TRACE_APP2_DOOR_PHASE, phase, 0);
+	g_APP2_doorPhaseStart = SYSTICK_millis();
+	g_APP2_doorPhaseEnd = g_APP2_doorPhaseStart + time;
+#if (POSITION_ENCODER_ENABLE == TRUE)
+	g_APP2_doorLastCount = POSITION_getCount();
+	g_APP2_doorLastMove = g_APP2_doorPhaseStart;
+#endif
+
+	LINK_send(pgm_read_byte(&g_APP2_doorPhases[phase].state), NULL_PTR, 0);
+	DcMotor_Ramp(direction, pgm_read_byte(&g_APP2_doorPhases[phase].speed));
+	SYSTICK_startTimer(&g_APP2_doorTimer, time, SYSTICK_ONE_SHOT, APP2_doorTimeout);
+
+	/* The control period runs in the hold phases too, they repeat the phase to mC1 */
+	if(g_APP2_doorControlTimer.active == FALSE)
+	{
+		g_APP2_doorControlCount = 0;
+		SYSTICK_startTimer(&g_APP2_doorControlTimer, APP2_DOOR_CONTROL_TIME, SYSTICK_PERIODIC, APP2_doorControlTimeout);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorNextPhase
+ * [DESCRIPTION]:	This Function is used to start the phase after the ended phase, or to
+ * 					end the sequence after its last phase
+ * [ARGS]:		uint8 phase :	This Arg shall indicate the ended phase
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorNextPhase(uint8 phase)
+{
+	if(phase < g_APP2_doorLastPhase)
+	{
+		APP2_doorStartPhase(phase + 1);
+	}
+	else
+	{
+		/* The door stays where the last phase left it */
+		APP2_doorStop();
+		APP2_saveEntropy();
+		if(g_APP2_doorLastPhase == APP2_DOOR_PHASE_CLOSE)
+		{
+			LINK_send(OPEN_MAIN_MENU, NULL_PTR, 0);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorArrived
+ * [DESCRIPTION]:	This Function is used to end a motion phase that reached the end of the
+ * 					travel. The position is set to the exact end so the error of the
+ * 					estimation or the encoder does not add up between the cycles
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorArrived(void)
+{
+	uint8 phase = g_APP2_doorPhase;
+	uint8 progress[2];
+
+	if(pgm_read_byte(&g_APP2_doorPhases[phase].direction) == CW)
+	{
+		g_APP2_doorStartPosition = APP2_DOOR_TRAVEL;
+	}
+	else
+	{
+		g_APP2_doorStartPosition = 0;
+	}
+#if (POSITION_ENCODER_ENABLE == TRUE)
+	POSITION_setCount(g_APP2_doorStartPosition);
+#endif
+
+	/* The position is now fixed until the next phase starts */
+	g_APP2_doorPhase = APP2_DOOR_NO_PHASE;
+	progress[0] = (g_APP2_doorStartPosition == 0) ? 0 : 100;
+	progress[1] = pgm_read_byte(&g_APP2_doorPhases[phase].state);
+	LINK_send(DOOR_PROGRESS, progress, 2);
+
+	APP2_doorNextPhase(phase);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorControl
+ * [DESCRIPTION]:	This Function is the control loop of a moving door. It stops the motor
+ * 					on the limit switch or on the encoder target, stops it if the door
+ * 					stops moving while the motor is driven, and sends the position of the
+ * 					door to mC1 every APP2_DOOR_PROGRESS_TIME
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorControl(void)
+{
+	DcMotor_State direction = (DcMotor_State)pgm_read_byte(&g_APP2_doorPhases[g_APP2_doorPhase].direction);
+	POSITION_LimitType limit = POSITION_getLimit();
+	uint16 position = APP2_doorPosition();
+
+	/* The held door does not move, its phase is only sent again */
+	if(direction == STOP)
+	{
+		APP2_doorProgress(position);
+		return;
+	}
+
+	/* The end stop is reached, the motor is stopped at once */
+	if(((direction == CW) && (limit == POSITION_OPEN_LIMIT)) ||
+			((direction == CCW) && (limit == POSITION_CLOSED_LIMIT)))
+	{
+		DcMotor_Rotate(STOP,0);
+		APP2_doorArrived();
+		return;
+	}
+
+#if (POSITION_ENCODER_ENABLE == TRUE)
+	/* The encoder target is reached, the motor is ramped down by the next phase */
+	if(((direction == CW) && (position >= APP2_DOOR_TRAVEL)) ||
+			((direction == CCW) && (position == 0)))
+	{
+		APP2_doorArrived();
+		return;
+	}
+
+	/* The door does not move while the motor is driven at its speed, the count is
+	 * used as the position is limited to the travel */
+	if(POSITION_getCount() != g_APP2_doorLastCount)
+	{
+		g_APP2_doorLastCount = POSITION_getCount();
+		g_APP2_doorLastMove = SYSTICK_millis();
+	}
+	else if((DcMotor_isRamping() == FALSE) &&
+			(SYSTICK_isExpired(g_APP2_doorLastMove + APP2_DOOR_STALL_TIME) == TRUE))
+	{
+		APP2_doorFault(APP2_FAULT_STALL);
+		return;
+	}
+#endif
+
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+	/* The start current of the motor is not an obstacle */
+	if((g_APP2_doorCurrentArmed == FALSE) &&
+			(SYSTICK_isExpired(g_APP2_doorPhaseStart + APP2_DOOR_INRUSH_TIME) == TRUE))
+	{
+		g_APP2_doorOverCount = 0;
+		g_APP2_doorCurrentArmed = TRUE;
+	}
+#endif
+
+	APP2_doorProgress(position);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorProgress
+ * [DESCRIPTION]:	This Function is used to send the position of the door and its running
+ * 					phase to mC1 every APP2_DOOR_PROGRESS_TIME, mC1 shows the phase again
+ * 					when the frame that started it was lost
+ * [ARGS]:		uint16 position :	This Arg shall indicate the position of the door
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorProgress(uint16 position)
+{
+	uint8 progress[2];
+
+	g_APP2_doorControlCount++;
+	if(g_APP2_doorControlCount >= (APP2_DOOR_PROGRESS_TIME / APP2_DOOR_CONTROL_TIME))
+	{
+		g_APP2_doorControlCount = 0;
+		progress[0] = (uint8)(((uint32)position * 100) / APP2_DOOR_TRAVEL);
+		progress[1] = pgm_read_byte(&g_APP2_doorPhases[g_APP2_doorPhase].state);
+		LINK_send(DOOR_PROGRESS, progress, 2);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorPosition
+ * [DESCRIPTION]:	This Function is used to get the position of the door from the encoder,
+ * 					or from the time the running phase has been moving the door
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The position of the door, 0 is closed and APP2_DOOR_TRAVEL is fully opened
+ ----------------------------------------------------------------------------------------*/
+static uint16 APP2_doorPosition(void)
+{
+#if (POSITION_ENCODER_ENABLE == TRUE)
+	sint16 count = POSITION_getCount();
+
+	if(count < 0)
+	{
+		return 0;
+	}
+	if(count > APP2_DOOR_TRAVEL)
+	{
+		return APP2_DOOR_TRAVEL;
+	}
+	return (uint16)count;
+#else
+	uint32 elapsed;
+	DcMotor_State direction;
+
+	if(g_APP2_doorPhase == APP2_DOOR_NO_PHASE)
+	{
+		return g_APP2_doorStartPosition;
+	}
+
+	direction = (DcMotor_State)pgm_read_byte(&g_APP2_doorPhases[g_APP2_doorPhase].direction);
+	elapsed = SYSTICK_millis() - g_APP2_doorPhaseStart;
+
+	if(direction == CW)
+	{
+		if(elapsed > (uint32)(APP2_DOOR_MOTION_TIME - g_APP2_doorStartPosition))
+		{
+			return APP2_DOOR_MOTION_TIME;
+		}
+		return g_APP2_doorStartPosition + (uint16)elapsed;
+	}
+	else if(direction == CCW)
+	{
+		if(elapsed > g_APP2_doorStartPosition)
+		{
+			return 0;
+		}
+		return g_APP2_doorStartPosition - (uint16)elapsed;
+	}
+	return g_APP2_doorStartPosition;
+#endif
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorStop
+ * [DESCRIPTION]:	This Function is used to end the running sequence, the motor is ramped
+ * 					down and the position where the door stopped is kept for the next one
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorStop(void)
+{
+	g_APP2_doorStartPosition = APP2_doorPosition();
+	g_APP2_doorPhase = APP2_DOOR_NO_PHASE;
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+	g_APP2_doorCurrentArmed = FALSE;
+#endif
+
+	SYSTICK_stopTimer(&g_APP2_doorTimer);
+	SYSTICK_stopTimer(&g_APP2_doorControlTimer);
+	DcMotor_Ramp(STOP,0);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorFault
+ * [DESCRIPTION]:	This Function is used to stop a moving door at once on a fault, the fault
+ * 					is logged and mC1 shows it then goes back to the main menu
+ * [ARGS]:		uint8 fault :	This Arg shall indicate the fault
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorFault(uint8 fault)
+{
+	APP2_logFault(fault);
+	APP2_doorStop();
+	DcMotor_Rotate(STOP,0);
+	DcMotor_deInit();
+	LINK_send(DOOR_STALLED, NULL_PTR, 0);
+	LINK_send(OPEN_MAIN_MENU, NULL_PTR, 0);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_logFault
+ * [DESCRIPTION]:	This Function is used to save a record of a fault in the next slot
+ * 					of the EEPROM log, the oldest record is overwritten when the log is
+ * 					full. The record holds the fault, the running phase, the position of
+ * 					the door in percent and the last average of the motor current
+ * [ARGS]:		uint8 fault :	This Arg shall indicate the fault
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_logFault(uint8 fault)
+{
+	uint16 address = EEPROM_LOG_ADDRESS + ((uint16)g_APP2_logIndex * APP2_LOG_RECORD_SIZE);
+	uint16 current = 0;
+
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+	current = ADC_getAverage(APP2_DOOR_CURRENT_CHANNEL);
+#endif
+
+	APP2_storageBegin();
+	APP2_storageWrite(address, fault);
+	APP2_storageWrite(address + 1, g_APP2_doorPhase);
+	APP2_storageWrite(address + 2, (uint8)(((uint32)APP2_doorPosition() * 100) / APP2_DOOR_TRAVEL));
+	APP2_storageWrite(address + 3, (uint8)(current >> 8));
+	APP2_storageWrite(address + 4, (uint8)current);
+
+	g_APP2_logIndex = (g_APP2_logIndex + 1) % APP2_LOG_SIZE;
+	APP2_storageWrite(EEPROM_LOG_INDEX_ADDRESS, g_APP2_logIndex);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_savePassword
+ * [DESCRIPTION]:	This Function is used to save the salt and the hash of the password in the
+ * 					external EEPROM through the storage queue, then the clear password is
+ * 					erased. Each password gets a new random salt. The flag is queued last in
+ * 					the record so it is not written after a refused or dropped byte
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_savePassword(void)
+{
+	uint64 word;
+	uint8 i;
+
+	APP2_storageBegin();
+	RNG_get(g_APP2_salt, HASH_SALT_SIZE);
+	for(i = 0; i < HASH_SALT_SIZE; i++)
+	{
+		APP2_storageWrite(EEPROM_SALT_ADDRESS+i, g_APP2_salt[i]);
+	}
+
+	g_APP2_hash = HASH_compute(g_APP2_salt, password, password_size);
+	word = g_APP2_hash;
+	for(i = 0; i < HASH_SIZE; i++)
+	{
+		APP2_storageWrite(EEPROM_HASH_ADDRESS+i, (uint8)word);
+		word >>= 8;
+	}
+
+	/* The clear password is not kept */
+	for(i = 0; i < PASSWORD_SIZE; i++)
+	{
+		password[i] = 0;
+	}
+
+	g_pass_check = PASSWORD_HASHED;
+	APP2_storageWrite(EEPROM_ADDRESS_FLAG, g_pass_check);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_saveEntropy
+ * [DESCRIPTION]:	This Function is used to save a new seed of the entropy pool for the
+ * 					next boot. It is called at the points the system may be switched off
+ * 					after: the boot, a new password and the end of a door cycle
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_saveEntropy(void)
+{
+	uint8 seed[RNG_SEED_SIZE];
+	uint8 i;
+
+	APP2_storageBegin();
+	RNG_get(seed, RNG_SEED_SIZE);
+	for(i = 0; i < RNG_SEED_SIZE; i++)
+	{
+		APP2_storageWrite(EEPROM_RNG_SEED_ADDRESS+i, seed[i]);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_saveFailures
+ * [DESCRIPTION]:	This Function is used to set the wrong attempts in a row and queue its
+ * 					record for the storage task
+ * [ARGS]:		uint8 failures :	This Arg shall indicate the wrong attempts in a row
+ * [RETURNS]:	SUCCESS if the record is queued, ERROR if the queue is full
+ ----------------------------------------------------------------------------------------*/
+static uint8 APP2_saveFailures(uint8 failures)
+{
+	g_APP2_failures = failures;
+	APP2_storageBegin();
+	return APP2_storageWrite(EEPROM_FAILURES_ADDRESS, failures);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_sendVerdict
+ * [DESCRIPTION]:	This Function is used to send the result of the checked password once
+ * 					its attempt is saved. The next state is taken from the flows table, a
+ * 					wrong attempt from APP2_LOCKOUT_FREE_ATTEMPTS on sets the alarm on.
+ * 					An attempt that could not be saved is not judged, it starts the
+ * 					lockout so the attempts are never more than the saved count
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_sendVerdict(void)
+{
+	if(g_APP2_attemptSaved == FALSE)
+	{
+		g_APP2_linkState = APP2_LINK_WAIT_COMMAND;
+		APP2_setAlarmON();
+	}
+	else if(g_APP2_verdict == TRUE)
+	{
+		BUZZER_play(BUZZER_CHIRP);
+
+		/* Hand shaking method is used to send a command to mC1 that the password
+		 * is correct to display on LCD screen then wait mC1 to send that it finished
+		 * displaying the message. Also same goes for wrong password */
+		LINK_send(SEND_CORRECT, NULL_PTR, 0);
+		APP2_waitForAck(SEND_CORRECT, pgm_read_byte(&g_APP2_flows[g_APP2_flow].success_state));
+	}
+	else if(g_APP2_failures >= APP2_LOCKOUT_FREE_ATTEMPTS)
+	{
+		g_APP2_linkState = APP2_LINK_WAIT_COMMAND;
+		APP2_setAlarmON();
+	}
+	else
+	{
+		LINK_send(SEND_WRONG, NULL_PTR, 0);
+		APP2_waitForAck(SEND_WRONG, pgm_read_byte(&g_APP2_flows[g_APP2_flow].retry_state));
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_lockoutStart
+ * [DESCRIPTION]:	This Function is used to start the lockout of the wrong attempts in a
+ * 					row. The first lockout lasts APP2_LOCKOUT_BASE_TIME and each attempt
+ * 					after it doubles the time up to APP2_LOCKOUT_MAX_TIME. A lockout of an
+ * 					attempt that was not saved lasts the first time
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_lockoutStart(void)
+{
+	uint8 doublings = 0;
+	uint32 time = APP2_LOCKOUT_BASE_TIME;
+
+	if(g_APP2_failures > APP2_LOCKOUT_FREE_ATTEMPTS)
+	{
+		doublings = g_APP2_failures - APP2_LOCKOUT_FREE_ATTEMPTS;
+	}
+
+	while((doublings > 0) && (time < APP2_LOCKOUT_MAX_TIME))
+	{
+		time <<= 1;
+		doublings--;
+	}
+	if(time > APP2_LOCKOUT_MAX_TIME)
+	{
+		time = APP2_LOCKOUT_MAX_TIME;
+	}
+
+	g_APP2_lockoutEnd = SYSTICK_millis() + time;
+	g_APP2_locked = TRUE;
+	SYSTICK_startTimer(&g_APP2_lockoutTimer, APP2_LOCKOUT_REPORT_TIME, SYSTICK_PERIODIC, APP2_alarmTimeout);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_lockoutSeconds
+ * [DESCRIPTION]:	This Function is used to get the time left of the lockout
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The time left in seconds rounded up, 0 when the lockout ended
+ ----------------------------------------------------------------------------------------*/
+static uint16 APP2_lockoutSeconds(void)
+{
+	if(SYSTICK_isExpired(g_APP2_lockoutEnd) == TRUE)
+	{
+		return 0;
+	}
+	return (uint16)((g_APP2_lockoutEnd - SYSTICK_millis() + 999) / 1000);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_sendLockout
+ * [DESCRIPTION]:	This Function is used to send the time left of the lockout to mC1
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_sendLockout(void)
+{
+	uint16 seconds = APP2_lockoutSeconds();
+	uint8 payload[2];
+
+	payload[0] = (uint8)seconds;
+	payload[1] = (uint8)(seconds >> 8);
+	LINK_send(LOCKOUT_TIME, payload, 2);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_collectStart
+ * [DESCRIPTION]:	This Function is used to make the link task collect the password frame
+ * 					that follows a command
+ * [ARGS]:		uint8 *a_buffer :	This Arg shall indicate where the password is saved
+ * 				uint8 command :		This Arg shall indicate the command
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_collectStart(uint8 *a_buffer, uint8 command)
+{
+	g_APP2_linkBuffer = a_buffer;
+	g_APP2_linkCommand = command;
+	g_APP2_linkState = APP2_LINK_COLLECT_PASSWORD;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_collectPassword
+ * [DESCRIPTION]:	This Function is used to take the password frame. Its payload is the
+ * 					size of the password, the nonce (least significant byte first) and the
+ * 					password encrypted in the CTR mode. The password is decrypted and
+ * 					handled according to the command it follows. The extra bytes of a
+ * 					password longer than the buffer are dropped
+ * [ARGS]:		const LINK_FrameType *a_framePtr :	This Arg shall indicate the frame
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_collectPassword(const LINK_FrameType *a_framePtr)
+{
+	uint32 nonce = 0;
+	uint8 size = a_framePtr->payload[0];
+	uint8 i;
+
+	if((a_framePtr->size < (CIPHER_NONCE_SIZE + 1)) ||
+			(size > (a_framePtr->size - (CIPHER_NONCE_SIZE + 1))))
+	{
+		return;
+	}
+
+	for(i = 0; i < CIPHER_NONCE_SIZE; i++)
+	{
+		nonce |= (uint32)a_framePtr->payload[i + 1] << (8 * i);
+	}
+	g_APP2_passwordNonce = nonce;
+	if(size > (PASSWORD_SIZE - 1))
+	{
+		size = PASSWORD_SIZE - 1;
+	}
+	for(i = 0; i < size; i++)
+	{
+		g_APP2_linkBuffer[i] = a_framePtr->payload[i + CIPHER_NONCE_SIZE + 1];
+	}
+
+	PROF_BEGIN(PROF_PASSWORD_DECRYPT);
+	CIPHER_ctr(nonce, g_APP2_linkBuffer, size);
+	PROF_END(PROF_PASSWORD_DECRYPT);
+	for(i = size; i < PASSWORD_SIZE; i++)
+	{
+		g_APP2_linkBuffer[i] = 0;
+	}
+	g_APP2_linkState = APP2_LINK_WAIT_COMMAND;
+
+	if(g_APP2_linkCommand == RECEIVE_NEWEST_PASSWORD)
+	{
+		password_size = size;
+		APP2_receivePassword();
+	}
+	else
+	{
+		re_password_size = size;
+		APP2_handlePassword(g_APP2_linkCommand);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_linkChallenge
+ * [DESCRIPTION]:	This Function is used to start a new session of the link with the next
+ * 					challenge, the link task keeps its state
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_linkChallenge(void)
+{
+	uint16 boot_count;
+
+	/* A new boot count is reserved at the first challenge and when the challenges of
+	 * this one are used up */
+	if((uint16)g_APP2_challenge == 0)
+	{
+		boot_count = eeprom_read_word(&g_APP2_bootCount) + 1;
+		eeprom_update_word(&g_APP2_bootCount, boot_count);
+		g_APP2_challenge = (uint32)boot_count << 16;
+	}
+
+	LINK_challenge(g_APP2_challenge);
+	g_APP2_challenge++;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_isRepeated
+ * [DESCRIPTION]:	This Function is used to check if a frame is a password frame that is
+ * 					already taken, the nonce of each password frame of mC1 is new
+ * [ARGS]:		const LINK_FrameType *a_framePtr :	This Arg shall indicate the frame
+ * [RETURNS]:	TRUE if the password is already taken, else FALSE
+ ----------------------------------------------------------------------------------------*/
+static boolean APP2_isRepeated(const LINK_FrameType *a_framePtr)
+{
+	uint32 nonce = 0;
+	uint8 i;
+
+	if((a_framePtr->size < (CIPHER_NONCE_SIZE + 1)) || ((a_framePtr->command != RECEIVE_NEWEST_PASSWORD) &&
+			(APP2_findFlow(a_framePtr->command) == APP2_NO_FLOW)))
+	{
+		return FALSE;
+	}
+
+	for(i = 0; i < CIPHER_NONCE_SIZE; i++)
+	{
+		nonce |= (uint32)a_framePtr->payload[i + 1] << (8 * i);
+	}
+	return (nonce == g_APP2_passwordNonce) ? TRUE : FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_repeatState
+ * [DESCRIPTION]:	This Function is used to answer a request of mC1 that is already taken
+ * 					with the state of mC2: the lockout, else the last frame sent to mC1,
+ * 					else the first state of the password
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_repeatState(void)
+{
+	if(g_APP2_locked == TRUE)
+	{
+		LINK_send(ALARM_ON, NULL_PTR, 0);
+		APP2_sendLockout();
+	}
+	else if(LINK_resend() == FALSE)
+	{
+		APP2_checkForFirstTime();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_findFlow
+ * [DESCRIPTION]:	This Function is used to search the flows table for a password command
+ * [ARGS]:		uint8 command :	This Arg shall indicate the command received from mC1
+ * [RETURNS]:	The index of the flow in the table, or APP2_NO_FLOW if the command does
+ * 				not start a password check
+ ----------------------------------------------------------------------------------------*/
+static uint8 APP2_findFlow(uint8 command)
+{
+	uint8 i;
+
+	for(i = 0; i < APP2_NUM_OF_FLOWS; i++)
+	{
+		if(pgm_read_byte(&g_APP2_flows[i].command) == command)
+		{
+			return i;
+		}
+	}
+	return APP2_NO_FLOW;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_waitForAck
+ * [DESCRIPTION]:	This Function is used to make the link task wait for mC1 to send back
+ * 					the result it displayed before sending it the next state
+ * [ARGS]:		uint8 ack :			This Arg shall indicate the expected byte from mC1
+ * 				uint8 next_state :	This Arg shall indicate the state sent after the ack
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_waitForAck(uint8 ack, uint8 next_state)
+{
+	g_APP2_expectedAck = ack;
+	g_APP2_nextState = next_state;
+	g_APP2_linkState = APP2_LINK_WAIT_ACK;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_sendState
+ * [DESCRIPTION]:	This Function is used to send the next state to mC1. The OPEN_DOOR state
+ * 					starts the whole door cycle, the door task reports each phase itself
+ * [ARGS]:		uint8 state :	This Arg shall indicate the state
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_sendState(uint8 state)
+{
+	if(state == OPEN_DOOR)
+	{
+		DIAG_count(DIAG_UNLOCKS);
+		APP2_doorRequest(APP2_DOOR_PHASE_OPEN, APP2_DOOR_PHASE_CLOSE);
+	}
+	else
+	{
+		LINK_send(state, NULL_PTR, 0);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_storageBegin
+ * [DESCRIPTION]:	This Function is used to start a new record, the next queued bytes
+ * 					belong to it until the next record is started
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_storageBegin(void)
+{
+	g_APP2_storageRecord++;
+	g_APP2_storageBroken = FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_storageWrite
+ * [DESCRIPTION]:	This Function is used to queue a byte of the current record to be
+ * 					written in the EEPROM by the storage task. The byte is refused if the
+ * 					queue is full, and so are the next bytes of its record
+ * [ARGS]:		uint16 address :	This Arg shall indicate the EEPROM address
+ * 				uint8 data :		This Arg shall indicate the data byte
+ * [RETURNS]:	SUCCESS if the byte is queued, ERROR if it is refused
+ ----------------------------------------------------------------------------------------*/
+static uint8 APP2_storageWrite(uint16 address, uint8 data)
+{
+	if((g_APP2_storageBroken == TRUE) || (g_APP2_storageCount >= APP2_STORAGE_QUEUE_SIZE))
+	{
+		DIAG_count(DIAG_EEPROM_DROPS);
+		g_APP2_storageBroken = TRUE;
+		return ERROR;
+	}
+
+	g_APP2_storageQueue[g_APP2_storageHead].address = address;
+	g_APP2_storageQueue[g_APP2_storageHead].data = data;
+	g_APP2_storageQueue[g_APP2_storageHead].record = g_APP2_storageRecord;
+	g_APP2_storageHead = (g_APP2_storageHead + 1) % APP2_STORAGE_QUEUE_SIZE;
+	g_APP2_storageCount++;
+
+	SCHED_setEvent(APP2_STORAGE_TASK, APP2_EVENT_START);
+	return SUCCESS;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_linkRxNotify
+ * [DESCRIPTION]:	This Function is the UART RX call back, it makes the link task ready
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_linkRxNotify(void)
+{
+	/* The bytes are timed by the clock of mC1 and the key presses of the user, the
+	 * low bits of their arrival time in cycles are noise */
+	RNG_addSample((uint16)SYSTICK_cycles());
+	SCHED_setEvent(APP2_LINK_TASK, APP2_EVENT_RX);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorTimeout
+ * [DESCRIPTION]:	This Function is the door timer call back, it makes the door task ready
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorTimeout(void)
+{
+	SCHED_setEvent(APP2_DOOR_TASK, APP2_EVENT_TIMEOUT);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorControlTimeout
+ * [DESCRIPTION]:	This Function is the door control timer call back, it makes the door
+ * 					task run the control loop
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorControlTimeout(void)
+{
+	SCHED_setEvent(APP2_DOOR_TASK, APP2_EVENT_CONTROL);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorLimitNotify
+ * [DESCRIPTION]:	This Function is the limit switches call back, it is called from the
+ * 					ISR to make the door task check the switches without waiting for
+ * 					the next control period
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorLimitNotify(void)
+{
+	SCHED_setEvent(APP2_DOOR_TASK, APP2_EVENT_LIMIT);
+}
+
+#if (APP2_DOOR_CURRENT_SENSE_ENABLE == TRUE)
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_doorCurrentNotify
+ * [DESCRIPTION]:	This Function is the ADC call back, it is called from the ISR with each
+ * 					new average. The door task is made ready when the motor current stays
+ * 					above the limit for APP2_DOOR_OVERCURRENT_SAMPLES averages in a row
+ * [ARGS]:		uint8 channel :		This Arg shall indicate the ADC channel
+ * 				uint16 average :	This Arg shall indicate the average of the channel
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_doorCurrentNotify(uint8 channel, uint16 average)
+{
+	/* The low bits of the averages are the noise of the shunt and the converter */
+	RNG_addSample(average);
+
+	if((channel != APP2_DOOR_CURRENT_CHANNEL) || (g_APP2_doorCurrentArmed == FALSE))
+	{
+		return;
+	}
+
+	if(average < ADC_MILLIVOLTS(((uint32)APP2_DOOR_OBSTACLE_CURRENT * APP2_DOOR_SHUNT_MV_PER_A) / 1000))
+	{
+		g_APP2_doorOverCount = 0;
+	}
+	else if(g_APP2_doorOverCount < APP2_DOOR_OVERCURRENT_SAMPLES)
+	{
+		g_APP2_doorOverCount++;
+		if(g_APP2_doorOverCount == APP2_DOOR_OVERCURRENT_SAMPLES)
+		{
+			SCHED_setEvent(APP2_DOOR_TASK, APP2_EVENT_OVERCURRENT);
+		}
+	}
+}
+#endif
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_alarmTimeout
+ * [DESCRIPTION]:	This Function is the lockout timer call back, it makes the alarm task ready
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_alarmTimeout(void)
+{
+	SCHED_setEvent(APP2_ALARM_TASK, APP2_EVENT_TIMEOUT);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	APP2_storageTimeout
+ * [DESCRIPTION]:	This Function is the storage timer call back, it is called when the
+ * 					EEPROM write cycle ends to make the storage task ready
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void APP2_storageTimeout(void)
+{
+	SCHED_setEvent(APP2_STORAGE_TASK, APP2_EVENT_TIMEOUT);
 }
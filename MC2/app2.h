@@ -20,18 +20,83 @@
 #define PASSWORD_SIZE		7
 #define EEPROM_START_BYTE	0x3E8
 
+#define APP2_DOOR_MOTION_TIME	15000	/* Time in ms to fully open or close the door */
+#define APP2_DOOR_TIMEOUT_MARGIN	5000	/* Time in ms added to the motion time when the
+										 * door end is sensed before it is a fault */
+#define APP2_DOOR_HOLD_TIME		3000	/* Time in ms the door stays opened */
+#define APP2_DOOR_SPEED			75		/* Duty cycle in percent of the door motor */
+#define APP2_DOOR_PROGRESS_TIME	500		/* Period in ms of the door position sent to mC1 */
+#define APP2_DOOR_CONTROL_TIME	50		/* Period in ms of the door control loop */
+#define APP2_DOOR_STALL_TIME	500		/* Time in ms without encoder edges to detect a stall */
+#define APP2_ALARM_TIME			60000	/* Time in ms the alarm stays on */
+
+/* The motor current is read from a shunt on an ADC channel, the amplifier of the
+ * shunt gives APP2_DOOR_SHUNT_MV_PER_A mV per A. A current above the obstacle
+ * limit for APP2_DOOR_OVERCURRENT_SAMPLES averages in a row reverses a closing
+ * door once, else the door is stopped */
+#define APP2_DOOR_CURRENT_SENSE_ENABLE	TRUE
+#define APP2_DOOR_CURRENT_CHANNEL		0
+#define APP2_DOOR_SHUNT_MV_PER_A		1000
+#define APP2_DOOR_OBSTACLE_CURRENT		1500	/* Current limit in mA of a moving door */
+#define APP2_DOOR_OVERCURRENT_SAMPLES	3		/* About 5 ms with the default ADC configuration */
+#define APP2_DOOR_INRUSH_TIME			300		/* Time in ms the current is ignored after a start */
+
+/* The door and storage faults are logged in a ring of records in the EEPROM */
+#define APP2_LOG_SIZE			8		/* Number of records in the log */
+#define APP2_LOG_RECORD_SIZE	5		/* Fault, phase, position in percent and current (2 bytes) */
+#define APP2_FAULT_TIMEOUT		1		/* The end of the travel is not sensed in time */
+#define APP2_FAULT_STALL		2		/* The encoder does not move while the motor is driven */
+#define APP2_FAULT_OVERCURRENT	3		/* The motor current is above the limit, the door is stopped */
+#define APP2_FAULT_OBSTACLE		4		/* The motor current is above the limit, the door is reversed */
+#define APP2_FAULT_STORAGE		5		/* A byte was dropped, the EEPROM did not acknowledge it */
+
+/* The wrong password attempts in a row are saved in the EEPROM so a reset does not
+ * clear them. From APP2_LOCKOUT_FREE_ATTEMPTS on, each wrong attempt sets the alarm
+ * on and no password is checked until the lockout ends, the lockout time doubles
+ * with each attempt up to APP2_LOCKOUT_MAX_TIME */
+#define APP2_LOCKOUT_FREE_ATTEMPTS	3			/* Wrong attempts before the first lockout */
+#define APP2_LOCKOUT_BASE_TIME		30000UL		/* Time in ms of the first lockout */
+#define APP2_LOCKOUT_MAX_TIME		3600000UL	/* Time in ms of the longest lockout */
+#define APP2_LOCKOUT_REPORT_TIME	1000		/* Period in ms of the time left sent to mC1 */
+
+/* Phases of the door, a sequence runs a range of them in order */
+#define APP2_DOOR_PHASE_OPEN	0
+#define APP2_DOOR_PHASE_HOLD	1
+#define APP2_DOOR_PHASE_CLOSE	2
+#define APP2_DOOR_NUM_OF_PHASES	3
+#define APP2_DOOR_NO_PHASE		0xFF
+
+#define APP2_STORAGE_QUEUE_SIZE	40		/* Number of EEPROM bytes waiting to be written, the boot
+									 * seed and a migrated password record fit together */
+#define APP2_STORAGE_RETRIES	3		/* Writes again of a byte not acknowledged before it is dropped */
+
+/* Tasks of mC2, the task id is also its priority (0 is the highest) */
+#define APP2_DOOR_TASK			0
+#define APP2_ALARM_TASK			1
+#define APP2_LINK_TASK			2
+#define APP2_STORAGE_TASK		3
+
+/* Events of the tasks */
+#define APP2_EVENT_START		0x01	/* A new request for the task */
+#define APP2_EVENT_TIMEOUT		0x02	/* The software timer of the task expired */
+#define APP2_EVENT_RX			0x04	/* A byte is received from mC1 */
+#define APP2_EVENT_LIMIT		0x08	/* A limit switch of the door is pressed */
+#define APP2_EVENT_OVERCURRENT	0x10	/* The motor current is above the limit */
+#define APP2_EVENT_DOOR_REOPEN	0x20	/* Open the closing door again */
+#define APP2_EVENT_DOOR_ABORT	0x40	/* Stop the door where it is */
+#define APP2_EVENT_CONTROL		0x80	/* Run the door control loop */
+
 /*----------------------------------EXTERNS-----------------------------------*/
 
 extern uint8 g_pass_check;
 extern uint8 password_size;
-extern uint8 TIMER1_flagComplete;
 
 /*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
 
 /*
  * Description:
  * This Function is used to initialize the Application layer which contains
- * HAL, UART Drivers
+ * HAL, UART Drivers and the tasks of the scheduler
  */
 void APP2_init(void);
 
@@ -47,16 +112,16 @@ void APP2_checkForFirstTime(void);
 
 /*
  * Description:
- * This Function is used to receive password sent from mC1
+ * This Function is used to save the new password received from mC1
  */
 void APP2_receivePassword(void);
 
 
 /*
  * Description:
- * This Function is used to receive commands sent from mC1
+ * This Function is used to handle the commands sent from mC1
  */
-uint8 APP2_receiveCommand(void);
+void APP2_receiveCommand(uint8 command);
 
 
 /*
@@ -69,96 +134,25 @@ uint8 APP2_checkPassword(void);
 
 /*
  * Description:
- * This Function is used to receive and check for the validity of the entered
- * password for the first time
- */
-void APP2_receiveAndCheckPassword(void);
-
-
-/*
- * Description:
- * This Function is used to receive and check for the validity of the entered
- * password for the second time
- */
-void APP2_receiveAndCheckPassword2(void);
-
-
-/*
- * Description:
- * This Function is used to receive and check for the validity of the entered
- * password for the third time
- */
-void APP2_receiveAndCheckPassword3(void);
-
-
-/*
- * Description:
- * This Function is used to receive and check for the validity of the entered
- * password in the main menu in the Door open option for the first time
- */
-void APP2_receiveAndCheckPassword_mainMenu(void);
-
-
-/*
- * Description:
- * This Function is used to receive and check for the validity of the entered
- * password in the main menu in the Door open option for the second time
- */
-void APP2_receiveAndCheckPassword2_mainMenu(void);
-
-
-/*
- * Description:
- * This Function is used to receive and check for the validity of the entered
- * password in the main menu in the Door open option for the third time
- */
-void APP2_receiveAndCheckPassword3_mainMenu(void);
-
-
-/*
- * Description:
- * This Function is used to open the door by operating the motor in CW
- * direction
+ * This Function is used to check the received password for the flow of the
+ * given command and send the next state of the flow to mC1
  */
-void APP2_openDoor(void);
+void APP2_handlePassword(uint8 command);
 
 
 /*
  * Description:
- * This Function is used to stop motor operation
+ * This Function is used to ask the door task to run the door phases from the
+ * first phase to the last phase, the phases are run in order without blocking
  */
-void APP2_doorStop(void);
+void APP2_doorRequest(uint8 first_phase, uint8 last_phase);
 
 
 /*
  * Description:
- * This Function is used to close the door by operating the motor in CCW
- * direction
- */
-void APP2_closeDoor(void);
-
-
-/*
- * Description:
- * This Function is used set the ALARM on
+ * This Function is used set the ALARM on and start the lockout of the
+ * password checks
  */
 void APP2_setAlarmON(void);
 
-
-/*
- * Description:
- * This Function is used to count ticks for Timer1 driver, the function
- * will set the Timer1 flag to 1 if the ticks are equal to the input
- * milliseconds
- */
-void TIMER1_countProcessing(uint16 g_msec1);
-
-
-/*
- * Description:
- * This Function is used to give a delay process according to the give
- * milliseconds
- */
-void TIMER1_delay_ms(uint16 seconds);
-
 #endif /* APP_H_ */
@@ -12,6 +12,64 @@
 
 #include "buzzer.h"
 #include "gpio.h"
+#include "systick.h"
+#include "timer.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#if ((BUZZER_TONE_ENABLE == TRUE) && (TIMER2_COMP_STATIC_BINDING == FALSE))
+#error "The buzzer tones need TIMER2_COMP_STATIC_BINDING set to TRUE in timer.h"
+#endif
+
+/*-----------------------------------TYPES DECLEARATION--------------------------------*/
+
+typedef struct
+{
+	const BUZZER_StepType *steps;
+	uint8 num_of_steps;
+	boolean repeat;				/* The pattern starts again after its last step */
+}BUZZER_PatternConfigType;
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static const BUZZER_StepType g_BUZZER_beep[] PROGMEM =
+{
+	BUZZER_STEP(2000, 40)
+};
+
+static const BUZZER_StepType g_BUZZER_chirp[] PROGMEM =
+{
+	BUZZER_STEP(1500, 30), BUZZER_STEP(2000, 30), BUZZER_STEP(2500, 30), BUZZER_STEP(3000, 60)
+};
+
+static const BUZZER_StepType g_BUZZER_siren[] PROGMEM =
+{
+	BUZZER_STEP(600, 60), BUZZER_STEP(700, 60), BUZZER_STEP(800, 60), BUZZER_STEP(900, 60),
+	BUZZER_STEP(1000, 60), BUZZER_STEP(1100, 60), BUZZER_STEP(1200, 60), BUZZER_STEP(1100, 60),
+	BUZZER_STEP(1000, 60), BUZZER_STEP(900, 60), BUZZER_STEP(800, 60), BUZZER_STEP(700, 60)
+};
+
+/* Indexed by BUZZER_PatternType */
+static const BUZZER_PatternConfigType g_BUZZER_patterns[BUZZER_NUM_OF_PATTERNS] PROGMEM =
+{
+	{g_BUZZER_beep,		sizeof(g_BUZZER_beep) / sizeof(BUZZER_StepType),	FALSE},
+	{g_BUZZER_chirp,	sizeof(g_BUZZER_chirp) / sizeof(BUZZER_StepType),	FALSE},
+	{g_BUZZER_siren,	sizeof(g_BUZZER_siren) / sizeof(BUZZER_StepType),	TRUE}
+};
+
+static uint8 g_BUZZER_pattern = BUZZER_NUM_OF_PATTERNS;	/* The playing pattern, or none */
+static uint8 g_BUZZER_step;
+static SYSTICK_TimerType g_BUZZER_timer;
+#if (BUZZER_TONE_ENABLE == TRUE)
+static volatile uint8 g_BUZZER_level = LOGIC_LOW;		/* Level of the pin toggled by the ISR */
+#endif
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void BUZZER_startStep(void);
+static void BUZZER_nextStep(void);
+static void BUZZER_tone(uint8 clock, uint8 compare);
 
 /*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
 /*---------------------------------------------------------------------------------------
@@ -22,7 +80,7 @@
  ----------------------------------------------------------------------------------------*/
 void BUZZER_init(void)
 {
-	GPIO_setPinDirection(BUZZER_PORT_ID,BUZZER_PIN_ID,PIN_OUTPUT);
+	GPIO_PIN_OUTPUT(BUZZER_PORT_ID,BUZZER_PIN_ID);
 }
 
 
@@ -34,7 +92,7 @@ void BUZZER_init(void)
  ----------------------------------------------------------------------------------------*/
 void BUZZER_ON(void)
 {
-	GPIO_writePin(BUZZER_PORT_ID,BUZZER_PIN_ID,LOGIC_HIGH);
+	GPIO_PIN_HIGH(BUZZER_PORT_ID,BUZZER_PIN_ID);
 }
 
 
@@ -46,5 +104,144 @@ void BUZZER_ON(void)
  ----------------------------------------------------------------------------------------*/
 void BUZZER_OFF(void)
 {
-	GPIO_writePin(BUZZER_PORT_ID,BUZZER_PIN_ID,LOGIC_LOW);
+	GPIO_PIN_LOW(BUZZER_PORT_ID,BUZZER_PIN_ID);
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	BUZZER_play
+ * [DESCRIPTION]:	This Function is used to start playing a pattern from its first step.
+ * 					The request is ignored while a pattern of a higher priority is playing
+ * [ARGS]:			BUZZER_PatternType pattern :	This Arg shall indicate the pattern
+ * [RETURNS]:		No Returns
+ ----------------------------------------------------------------------------------------*/
+void BUZZER_play(BUZZER_PatternType pattern)
+{
+	if((pattern >= BUZZER_NUM_OF_PATTERNS) ||
+			((g_BUZZER_pattern != BUZZER_NUM_OF_PATTERNS) && (g_BUZZER_pattern > pattern)))
+	{
+		return;
+	}
+
+	g_BUZZER_pattern = pattern;
+	g_BUZZER_step = 0;
+	BUZZER_startStep();
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	BUZZER_stop
+ * [DESCRIPTION]:	This Function is used to stop the playing pattern and silence the buzzer
+ * [ARGS]:			No Arguments
+ * [RETURNS]:		No Returns
+ ----------------------------------------------------------------------------------------*/
+void BUZZER_stop(void)
+{
+	SYSTICK_stopTimer(&g_BUZZER_timer);
+	g_BUZZER_pattern = BUZZER_NUM_OF_PATTERNS;
+	BUZZER_tone(0, 0);
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	BUZZER_isPlaying
+ * [DESCRIPTION]:	This Function is used to check if a pattern is playing
+ * [ARGS]:			No Arguments
+ * [RETURNS]:		TRUE if a pattern is playing, else FALSE
+ ----------------------------------------------------------------------------------------*/
+boolean BUZZER_isPlaying(void)
+{
+	return (g_BUZZER_pattern != BUZZER_NUM_OF_PATTERNS) ? TRUE : FALSE;
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	BUZZER_startStep
+ * [DESCRIPTION]:	This Function is used to sound the current step of the playing pattern
+ * 					and start the timer of its time
+ * [ARGS]:			No Arguments
+ * [RETURNS]:		No Returns
+ ----------------------------------------------------------------------------------------*/
+static void BUZZER_startStep(void)
+{
+	const BUZZER_StepType *step = (const BUZZER_StepType *)pgm_read_ptr(&g_BUZZER_patterns[g_BUZZER_pattern].steps) + g_BUZZER_step;
+
+	BUZZER_tone(pgm_read_byte(&step->clock), pgm_read_byte(&step->compare));
+	SYSTICK_startTimer(&g_BUZZER_timer, pgm_read_word(&step->time), SYSTICK_ONE_SHOT, BUZZER_nextStep);
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	BUZZER_nextStep
+ * [DESCRIPTION]:	This Function is the step timer call back, it moves to the next step of
+ * 					the pattern, or to its first step if it is repeated, else it stops
+ * [ARGS]:			No Arguments
+ * [RETURNS]:		No Returns
+ ----------------------------------------------------------------------------------------*/
+static void BUZZER_nextStep(void)
+{
+	g_BUZZER_step++;
+	if(g_BUZZER_step >= pgm_read_byte(&g_BUZZER_patterns[g_BUZZER_pattern].num_of_steps))
+	{
+		if(pgm_read_byte(&g_BUZZER_patterns[g_BUZZER_pattern].repeat) == FALSE)
+		{
+			BUZZER_stop();
+			return;
+		}
+		g_BUZZER_step = 0;
+	}
+	BUZZER_startStep();
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	BUZZER_tone
+ * [DESCRIPTION]:	This Function is used to start or stop the tone. With a passive buzzer
+ * 					Timer2 is started in the CTC mode with its compare interrupt, else the
+ * 					pin is only set
+ * [ARGS]:			uint8 clock :	This Arg shall indicate the Timer2 clock select, 0 stops
+ * 									the tone
+ * 					uint8 compare :	This Arg shall indicate the OCR2 of the tone
+ * [RETURNS]:		No Returns
+ ----------------------------------------------------------------------------------------*/
+static void BUZZER_tone(uint8 clock, uint8 compare)
+{
+#if (BUZZER_TONE_ENABLE == TRUE)
+	TCCR2 = 0;
+	TIMSK &= ~(1<<OCIE2);
+	g_BUZZER_level = LOGIC_LOW;
+	BUZZER_OFF();
+
+	if(clock != 0)
+	{
+		TCNT2 = 0;
+		OCR2 = compare;
+		TIFR = (1<<OCF2);
+		TIMSK |= (1<<OCIE2);
+		TCCR2 = (1<<WGM21) | (clock & 0x07);
+	}
+#else
+	(void)compare;
+	if(clock != 0)
+	{
+		BUZZER_ON();
+	}
+	else
+	{
+		BUZZER_OFF();
+	}
+#endif
+}
+
+/*----------------------------------INTERRUPT SERVICE ROUTINES--------------------------*/
+#if (BUZZER_TONE_ENABLE == TRUE)
+/*---------------------------------------------------------------------------------------
+ * [ISR NAME]:		TIMER2_COMP_vect
+ * [DESCRIPTION]:	This ISR is called every half period of the tone to toggle the pin
+ ----------------------------------------------------------------------------------------*/
+ISR(TIMER2_COMP_vect)
+{
+	g_BUZZER_level ^= LOGIC_HIGH;
+	GPIO_PIN_WRITE(BUZZER_PORT_ID, BUZZER_PIN_ID, g_BUZZER_level);
 }
+#endif
@@ -20,6 +20,53 @@
 #define BUZZER_PORT_ID		PORTC_ID
 #define BUZZER_PIN_ID		PIN2_ID
 
+/* TRUE for a passive buzzer, the tone of each step is made by toggling the pin
+ * from the Timer2 compare match ISR. FALSE for an active buzzer which makes its
+ * own tone, the pin is only held high during the sounding steps */
+#define BUZZER_TONE_ENABLE	TRUE
+
+/*
+ * Timer2 runs in the CTC mode and the ISR toggles the pin twice per period of
+ * the tone. The smallest prescaler that makes OCR2 fit in 8 bits is selected
+ * at compile time by BUZZER_STEP.
+ */
+#define BUZZER_TIMER2_DIVIDER(clock)	\
+	(((clock) == 1) ? 1UL : ((clock) == 2) ? 8UL : ((clock) == 3) ? 32UL : ((clock) == 4) ? 64UL :	\
+	 ((clock) == 5) ? 128UL : ((clock) == 6) ? 256UL : 1024UL)
+#define BUZZER_HALF_PERIOD(clock,freq)	(F_CPU / (2UL * BUZZER_TIMER2_DIVIDER(clock) * ((freq) + ((freq) == 0))))
+#define BUZZER_CLOCK(freq)				\
+	((BUZZER_HALF_PERIOD(1,freq) <= 256UL) ? 1 :	\
+	 (BUZZER_HALF_PERIOD(2,freq) <= 256UL) ? 2 :	\
+	 (BUZZER_HALF_PERIOD(3,freq) <= 256UL) ? 3 :	\
+	 (BUZZER_HALF_PERIOD(4,freq) <= 256UL) ? 4 :	\
+	 (BUZZER_HALF_PERIOD(5,freq) <= 256UL) ? 5 :	\
+	 (BUZZER_HALF_PERIOD(6,freq) <= 256UL) ? 6 : 7)
+
+/* Initializer of a BUZZER_StepType, a frequency of 0 is a silent step */
+#define BUZZER_STEP(freq,time)			\
+	{((freq) == 0) ? 0 : BUZZER_CLOCK(freq),	\
+	 ((freq) == 0) ? 0 : (uint8)(BUZZER_HALF_PERIOD(BUZZER_CLOCK(freq),freq) - 1),	\
+	 (time)}
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* The patterns in the order of their priority, a pattern does not replace a
+ * playing pattern of a higher priority */
+typedef enum
+{
+	BUZZER_BEEP,		/* Short beep of a pressed key */
+	BUZZER_CHIRP,		/* Rising chirp of a correct password */
+	BUZZER_SIREN,		/* Rising and falling siren of the alarm, repeated until stopped */
+	BUZZER_NUM_OF_PATTERNS
+}BUZZER_PatternType;
+
+typedef struct
+{
+	uint8 clock;		/* Timer2 clock select, 0 is silent */
+	uint8 compare;		/* OCR2 of the half period of the tone */
+	uint16 time;		/* Time in ms of the step */
+}BUZZER_StepType;
+
 /*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
 /*
  * Description:
@@ -41,4 +88,26 @@ void BUZZER_ON(void);
  */
 void BUZZER_OFF(void);
 
+
+/*
+ * Description:
+ * This Function is used to start playing a pattern, the steps are played by
+ * the system tick timers without blocking the CPU
+ */
+void BUZZER_play(BUZZER_PatternType pattern);
+
+
+/*
+ * Description:
+ * This Function is used to stop the playing pattern
+ */
+void BUZZER_stop(void);
+
+
+/*
+ * Description:
+ * This Function is used to check if a pattern is playing
+ */
+boolean BUZZER_isPlaying(void);
+
 #endif /* BUZZER_H_ */
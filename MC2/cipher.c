@@ -0,0 +1,164 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<cipher.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the Speck64/128 cipher of the UART link>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "cipher.h"
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define CIPHER_ROR(word,num)	(((word) >> (num)) | ((word) << (32 - (num))))
+#define CIPHER_ROL(word,num)	(((word) << (num)) | ((word) >> (32 - (num))))
+
+/* One Speck round, the rotations by 8 are byte moves on the AVR */
+#define CIPHER_ROUND(x,y,k)		\
+	do{							\
+		(x) = CIPHER_ROR(x,8);	\
+		(x) += (y);				\
+		(x) ^= (k);				\
+		(y) = CIPHER_ROL(y,3);	\
+		(y) ^= (x);				\
+	}while(0)
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* Expanded once by CIPHER_init, 108 bytes of SRAM */
+static uint32 g_CIPHER_roundKeys[CIPHER_ROUNDS];
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	CIPHER_init
+ * [DESCRIPTION]:	This Function is used to expand the key in the round keys. The key
+ * 					schedule uses the round function itself with the round number as key
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void CIPHER_init(void)
+{
+	const uint32 key[CIPHER_KEY_WORDS] = CIPHER_KEY;
+	uint32 l[CIPHER_KEY_WORDS - 1];
+	uint32 k = key[0];
+	uint8 i;
+
+	for(i = 0; i < (CIPHER_KEY_WORDS - 1); i++)
+	{
+		l[i] = key[i + 1];
+	}
+
+	for(i = 0; i < CIPHER_ROUNDS; i++)
+	{
+		g_CIPHER_roundKeys[i] = k;
+		CIPHER_ROUND(l[i % (CIPHER_KEY_WORDS - 1)], k, i);
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	CIPHER_encryptBlock
+ * [DESCRIPTION]:	This Function is used to encrypt one block of two words in place
+ * [ARGS]:		uint32 *a_xPtr :	This Arg shall indicate the first word of the block
+ * 				uint32 *a_yPtr :	This Arg shall indicate the second word of the block
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void CIPHER_encryptBlock(uint32 *a_xPtr, uint32 *a_yPtr)
+{
+	uint32 x = *a_xPtr;
+	uint32 y = *a_yPtr;
+	uint8 i;
+
+	for(i = 0; i < CIPHER_ROUNDS; i++)
+	{
+		CIPHER_ROUND(x, y, g_CIPHER_roundKeys[i]);
+	}
+
+	*a_xPtr = x;
+	*a_yPtr = y;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	CIPHER_ctr
+ * [DESCRIPTION]:	This Function is used to encrypt or decrypt a message in place in the
+ * 					CTR mode. The key stream of each 8 bytes is the encrypted block of the
+ * 					nonce and the block counter, its bytes are taken from the lowest byte
+ * 					of x then of y
+ * [ARGS]:		uint32 nonce :		This Arg shall indicate the nonce of the message
+ * 				uint8 *a_dataPtr :	This Arg shall indicate the message
+ * 				uint8 size :		This Arg shall indicate the size of the message
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void CIPHER_ctr(uint32 nonce, uint8 *a_dataPtr, uint8 size)
+{
+	uint32 x = 0;
+	uint32 y = 0;
+	uint32 counter = 0;
+	uint8 i;
+
+	for(i = 0; i < size; i++)
+	{
+		if((i % CIPHER_BLOCK_SIZE) == 0)
+		{
+			x = nonce;
+			y = counter;
+			CIPHER_encryptBlock(&x, &y);
+			counter++;
+		}
+		else if((i % CIPHER_BLOCK_SIZE) == (CIPHER_BLOCK_SIZE / 2))
+		{
+			x = y;
+		}
+
+		a_dataPtr[i] ^= (uint8)x;
+		x >>= 8;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	CIPHER_mac
+ * [DESCRIPTION]:	This Function is used to compute the CBC-MAC of a message. Each 8 bytes
+ * 					of the message are added to the state (x then y, lowest byte first) and
+ * 					the state is encrypted, the last block is padded with zeros. The size
+ * 					shall be in the first block so a message is never the start of another
+ * [ARGS]:		const uint32 *a_ivPtr :		This Arg shall indicate the two words of the
+ * 											secret initial state
+ * 				const uint8 *a_dataPtr :	This Arg shall indicate the message
+ * 				uint8 size :				This Arg shall indicate the size of the message
+ * [RETURNS]:	The first word of the last state
+ ----------------------------------------------------------------------------------------*/
+uint32 CIPHER_mac(const uint32 *a_ivPtr, const uint8 *a_dataPtr, uint8 size)
+{
+	uint32 x = a_ivPtr[0];
+	uint32 y = a_ivPtr[1];
+	uint32 word = 0;
+	uint8 i;
+
+	for(i = 0; i < size; i++)
+	{
+		word |= (uint32)a_dataPtr[i] << (8 * (i % (CIPHER_BLOCK_SIZE / 2)));
+
+		if(((i % (CIPHER_BLOCK_SIZE / 2)) == ((CIPHER_BLOCK_SIZE / 2) - 1)) || (i == (size - 1)))
+		{
+			if((i % CIPHER_BLOCK_SIZE) < (CIPHER_BLOCK_SIZE / 2))
+			{
+				x ^= word;
+			}
+			else
+			{
+				y ^= word;
+			}
+			word = 0;
+		}
+
+		if(((i % CIPHER_BLOCK_SIZE) == (CIPHER_BLOCK_SIZE - 1)) || (i == (size - 1)))
+		{
+			CIPHER_encryptBlock(&x, &y);
+		}
+	}
+
+	return x;
+}
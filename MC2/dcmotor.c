@@ -12,7 +12,38 @@
 
 #include "dcmotor.h"
 #include "gpio.h"
-#include "pwm.h"
+#include "systick.h"
+
+#if (DCMOTOR_PWM_FREQUENCY > DCMOTOR_PWM_MAX_FREQUENCY)
+#error "DCMOTOR_PWM_FREQUENCY is above the highest frequency of the PWM channel at this F_CPU"
+#endif
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* The prescaler and TOP are computed at compile time from the frequency */
+static const PWM_ConfigType g_DcMotor_pwmConfig =
+		PWM_CONFIG(DCMOTOR_PWM_CHANNEL, DCMOTOR_PWM_MODE, DCMOTOR_PWM_FREQUENCY);
+
+static DcMotor_RampProfile g_DcMotor_profile = DCMOTOR_RAMP_PROFILE;
+static uint16 g_DcMotor_rampSteps = DCMOTOR_RAMP_TIME / DCMOTOR_RAMP_STEP_TIME;
+
+static DcMotor_State g_DcMotor_state = STOP;	/* Direction the motor is driven in */
+static uint8 g_DcMotor_duty = 0;				/* Duty cycle written to the PWM */
+
+/* The running ramp goes from the start duty to the target duty, then the motor
+ * takes the next state and ramps to the next duty if it is changing direction */
+static uint8 g_DcMotor_startDuty;
+static uint8 g_DcMotor_targetDuty;
+static uint16 g_DcMotor_step;
+static DcMotor_State g_DcMotor_nextState;
+static uint8 g_DcMotor_nextDuty;
+static SYSTICK_TimerType g_DcMotor_rampTimer;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void DcMotor_setDirection(DcMotor_State state);
+static void DcMotor_startRamp(uint8 target_duty);
+static void DcMotor_rampStep(void);
 
 /*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
 
@@ -24,11 +55,11 @@
  ----------------------------------------------------------------------------------------*/
 void DcMotor_Init(void)
 {
-	GPIO_setPinDirection(IN1_PORT_ID, IN1_PIN_ID, PIN_OUTPUT);
-	GPIO_setPinDirection(IN2_PORT_ID, IN2_PIN_ID, PIN_OUTPUT);
+	GPIO_PIN_OUTPUT(IN1_PORT_ID, IN1_PIN_ID);
+	GPIO_PIN_OUTPUT(IN2_PORT_ID, IN2_PIN_ID);
 
-	GPIO_writePin(IN1_PORT_ID, IN1_PIN_ID, LOGIC_LOW);
-	GPIO_writePin(IN2_PORT_ID, IN2_PIN_ID, LOGIC_LOW);
+	GPIO_PIN_LOW(IN1_PORT_ID, IN1_PIN_ID);
+	GPIO_PIN_LOW(IN2_PORT_ID, IN2_PIN_ID);
 }
 
 /*---------------------------------------------------------------------------------------
@@ -48,26 +79,84 @@ void DcMotor_Rotate(DcMotor_State state, uint8 speed)	//uint8 speed
 	 * into duty cycle range (0->255)
 	 */
 	duty_cycle = (uint8) ( ((uint16)speed * 255) / 100 );
-	PWM_Timer0_Start(duty_cycle);
+	PWM_init(&g_DcMotor_pwmConfig);
+	PWM_setDutyCycle(DCMOTOR_PWM_CHANNEL, duty_cycle);
+
+	/* A running ramp is cancelled, the new speed is applied at once */
+	SYSTICK_stopTimer(&g_DcMotor_rampTimer);
+	g_DcMotor_duty = duty_cycle;
+	DcMotor_setDirection(state);
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DcMotor_Ramp
+ * [DESCRIPTION]:	This Function is used to move the motor to a state and a speed smoothly,
+ * 					the duty cycle is changed every DCMOTOR_RAMP_STEP_TIME by the system
+ * 					tick timer. If the direction changes, the motor is ramped down to
+ * 					zero before the direction pins are changed
+ * [ARGS]:
+ * [in]		DcMotor_State state :	This Arg shall indicate the state of the motor (STOP,CW,CCW)
+ * 			uint8 speed : 			This Arg shall indicate the cruise speed in percentage (%)
+ *	[RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void DcMotor_Ramp(DcMotor_State state, uint8 speed)
+{
+	uint8 duty_cycle = (uint8) ( ((uint16)speed * 255) / 100 );
 
 	if(state == STOP)
 	{
-		GPIO_writePin(IN1_PORT_ID, IN1_PIN_ID, LOGIC_LOW);
-		GPIO_writePin(IN2_PORT_ID, IN2_PIN_ID, LOGIC_LOW);
+		duty_cycle = 0;
 	}
-	else if(state == CW)
+
+	g_DcMotor_nextState = state;
+	g_DcMotor_nextDuty = duty_cycle;
+
+	if((g_DcMotor_state != state) && (g_DcMotor_state != STOP) && (g_DcMotor_duty != 0))
 	{
-		GPIO_writePin(IN1_PORT_ID, IN1_PIN_ID, LOGIC_HIGH);
-		GPIO_writePin(IN2_PORT_ID, IN2_PIN_ID, LOGIC_LOW);
+		/* Ramp down in the old direction first */
+		DcMotor_startRamp(0);
 	}
-	else if(state == CCW)
+	else
 	{
-		GPIO_writePin(IN1_PORT_ID, IN1_PIN_ID, LOGIC_LOW);
-		GPIO_writePin(IN2_PORT_ID, IN2_PIN_ID, LOGIC_HIGH);
+		if(g_DcMotor_duty == 0)
+		{
+			PWM_init(&g_DcMotor_pwmConfig);
+		}
+		DcMotor_setDirection(state);
+		DcMotor_startRamp(duty_cycle);
 	}
 }
 
 
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DcMotor_setRamp
+ * [DESCRIPTION]:	This Function is used to set the profile and the time of the next ramps
+ * [ARGS]:
+ * [in]		DcMotor_RampProfile profile :	This Arg shall indicate the ramp profile
+ * 			uint16 ramp_time :	This Arg shall indicate the time of a ramp in ms, 0 makes
+ * 								the speed change at once
+ *	[RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void DcMotor_setRamp(DcMotor_RampProfile profile, uint16 ramp_time)
+{
+	g_DcMotor_profile = profile;
+	g_DcMotor_rampSteps = ramp_time / DCMOTOR_RAMP_STEP_TIME;
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DcMotor_isRamping
+ * [DESCRIPTION]:	This Function is used to check if the motor is still ramping
+ * [ARGS]:		No Arguments
+ *	[RETURNS]:	TRUE if a ramp is running, FALSE if the motor reached its speed
+ ----------------------------------------------------------------------------------------*/
+boolean DcMotor_isRamping(void)
+{
+	return g_DcMotor_rampTimer.active;
+}
+
+
 /*---------------------------------------------------------------------------------------
  * [FUNCTION NAME]:	DcMotor_deInit
  * [DESCRIPTION]:	This Function is used to de-initialize the motor by de-initializing
@@ -77,5 +166,116 @@ void DcMotor_Rotate(DcMotor_State state, uint8 speed)	//uint8 speed
  ----------------------------------------------------------------------------------------*/
 void DcMotor_deInit(void)
 {
-	PWM_Timer0_Stop();
+	SYSTICK_stopTimer(&g_DcMotor_rampTimer);
+	g_DcMotor_duty = 0;
+	PWM_deInit(DCMOTOR_PWM_CHANNEL);
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DcMotor_setDirection
+ * [DESCRIPTION]:	This Function is used to set the direction pins of the motor
+ * [ARGS]:		DcMotor_State state :	This Arg shall indicate the state of the motor
+ *	[RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void DcMotor_setDirection(DcMotor_State state)
+{
+	g_DcMotor_state = state;
+
+	if(state == STOP)
+	{
+		GPIO_PIN_LOW(IN1_PORT_ID, IN1_PIN_ID);
+		GPIO_PIN_LOW(IN2_PORT_ID, IN2_PIN_ID);
+	}
+	else if(state == CW)
+	{
+		GPIO_PIN_HIGH(IN1_PORT_ID, IN1_PIN_ID);
+		GPIO_PIN_LOW(IN2_PORT_ID, IN2_PIN_ID);
+	}
+	else if(state == CCW)
+	{
+		GPIO_PIN_LOW(IN1_PORT_ID, IN1_PIN_ID);
+		GPIO_PIN_HIGH(IN2_PORT_ID, IN2_PIN_ID);
+	}
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DcMotor_startRamp
+ * [DESCRIPTION]:	This Function is used to start a ramp from the current duty cycle to
+ * 					the target duty cycle
+ * [ARGS]:		uint8 target_duty :	This Arg shall indicate the duty cycle (0->255)
+ *	[RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void DcMotor_startRamp(uint8 target_duty)
+{
+	g_DcMotor_startDuty = g_DcMotor_duty;
+	g_DcMotor_targetDuty = target_duty;
+	g_DcMotor_step = 0;
+
+	SYSTICK_startTimer(&g_DcMotor_rampTimer, DCMOTOR_RAMP_STEP_TIME, SYSTICK_PERIODIC, DcMotor_rampStep);
+
+	/* The first step is done now so a zero ramp time changes the speed at once */
+	DcMotor_rampStep();
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DcMotor_rampStep
+ * [DESCRIPTION]:	This Function is the ramp timer call back, it moves the duty cycle one
+ * 					step along the profile. The progress of the ramp x is kept in Q8 fixed
+ * 					point (256 is the end of the ramp), the S-curve is 3x^2 - 2x^3
+ * [ARGS]:		No Arguments
+ *	[RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void DcMotor_rampStep(void)
+{
+	uint16 x;
+	uint16 shape;
+	sint16 delta = (sint16)g_DcMotor_targetDuty - (sint16)g_DcMotor_startDuty;
+
+	if(g_DcMotor_step < g_DcMotor_rampSteps)
+	{
+		g_DcMotor_step++;
+	}
+
+	if(g_DcMotor_step >= g_DcMotor_rampSteps)
+	{
+		g_DcMotor_duty = g_DcMotor_targetDuty;
+	}
+	else
+	{
+		x = (uint16)(((uint32)g_DcMotor_step << 8) / g_DcMotor_rampSteps);
+		if(g_DcMotor_profile == DCMOTOR_S_CURVE)
+		{
+			shape = (uint16)(((uint32)x * x * ((3UL << 8) - 2 * x)) >> 16);
+		}
+		else
+		{
+			shape = x;
+		}
+		g_DcMotor_duty = (uint8)(g_DcMotor_startDuty + (sint16)(((sint32)delta * shape) >> 8));
+	}
+	PWM_setDutyCycle(DCMOTOR_PWM_CHANNEL, g_DcMotor_duty);
+
+	if(g_DcMotor_duty != g_DcMotor_targetDuty)
+	{
+		return;
+	}
+
+	SYSTICK_stopTimer(&g_DcMotor_rampTimer);
+	if(g_DcMotor_state != g_DcMotor_nextState)
+	{
+		/* The motor is stopped, now it can turn in the other direction */
+		DcMotor_setDirection(g_DcMotor_nextState);
+		if(g_DcMotor_nextDuty != 0)
+		{
+			DcMotor_startRamp(g_DcMotor_nextDuty);
+			return;
+		}
+	}
+	if(g_DcMotor_state == STOP)
+	{
+		PWM_deInit(DCMOTOR_PWM_CHANNEL);
+	}
 }
@@ -14,6 +14,7 @@
 /*-----------------------------------INCLUDES---------------------------------*/
 
 #include "std_types.h"
+#include "pwm.h"
 
 /*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
 
@@ -23,6 +24,21 @@
 #define	IN2_PORT_ID		PORTB_ID
 #define IN2_PIN_ID		PIN1_ID
 
+/* Timer1 is taken by the system tick and the encoder, so the motor is on Timer0
+ * whose TOP is fixed at 255. Its highest frequency is F_CPU / 256: 3.9 kHz at the
+ * 1 MHz of the build, which is audible. The motor cannot be driven above the
+ * audible range at this clock, that needs F_CPU of 8 MHz or more (31.25 kHz).
+ * DCMOTOR_PWM_MAX_FREQUENCY shall follow the channel and the mode */
+#define DCMOTOR_PWM_CHANNEL			PWM_TIMER0_OC0
+#define DCMOTOR_PWM_MODE			PWM_FAST
+#define DCMOTOR_PWM_MAX_FREQUENCY	PWM_TIMER0_MAX_FAST_FREQUENCY
+#define DCMOTOR_PWM_FREQUENCY		PWM_TIMER0_MAX_FAST_FREQUENCY
+
+/* Default ramp used by DcMotor_Ramp, it can be changed by DcMotor_setRamp */
+#define DCMOTOR_RAMP_PROFILE		DCMOTOR_S_CURVE
+#define DCMOTOR_RAMP_TIME			1000	/* Time in ms of a ramp from a speed to another */
+#define DCMOTOR_RAMP_STEP_TIME		10		/* Time in ms between two duty cycle updates */
+
 /*-----------------------------TYPES DECLEARATION-----------------------------*/
 
 typedef enum
@@ -30,6 +46,12 @@ typedef enum
 	STOP,CW,CCW
 }DcMotor_State;
 
+typedef enum
+{
+	DCMOTOR_LINEAR,		/* Constant acceleration */
+	DCMOTOR_S_CURVE		/* Acceleration rises and falls smoothly (smoothstep) */
+}DcMotor_RampProfile;
+
 /*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
 /*
  * Description:
@@ -45,6 +67,29 @@ void DcMotor_Init(void);
 void DcMotor_Rotate(DcMotor_State state, uint8 speed);
 
 
+/*
+ * Description:
+ * This Function is used to move the motor to a state and a speed smoothly.
+ * The duty cycle is ramped from the system tick, a change of direction
+ * ramps down to zero first. A ramp to STOP turns the PWM off at its end
+ */
+void DcMotor_Ramp(DcMotor_State state, uint8 speed);
+
+
+/*
+ * Description:
+ * This Function is used to set the profile and the time of the next ramps
+ */
+void DcMotor_setRamp(DcMotor_RampProfile profile, uint16 ramp_time);
+
+
+/*
+ * Description:
+ * This Function is used to check if the motor is still ramping
+ */
+boolean DcMotor_isRamping(void);
+
+
 /*
  * Description:
  * This Function is used to de-initialize the motor by de-initializing
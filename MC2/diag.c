@@ -0,0 +1,129 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<diag.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the diagnostics counters of mC2, they are read by the
+ * 					DIAGNOSTICS command of the link>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "diag.h"
+#include "uart.h"
+#include "sched.h"
+#include "link.h"
+#include <avr/io.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static uint16 g_DIAG_counters[DIAG_NUM_OF_COUNTERS];
+
+#if defined(__AVR__)
+/* The end of the static variables and the start of the free RAM, from the linker */
+extern uint8 __heap_start;
+#endif
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static uint16 DIAG_stackHighWater(void);
+static void DIAG_sendWord(uint16 word);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DIAG_init
+ * [DESCRIPTION]:	This Function is used to fill the RAM from the end of the variables up
+ * 					to the stack pointer with the pattern. The host build has no such RAM
+ * 					so nothing is filled there
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void DIAG_init(void)
+{
+#if defined(__AVR__)
+	uint8 *byte;
+
+	for(byte = &__heap_start; byte < (uint8 *)SP; byte++)
+	{
+		*byte = DIAG_STACK_PATTERN;
+	}
+#endif
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DIAG_count
+ * [DESCRIPTION]:	This Function is used to count an event, the count stops at 0xFFFF
+ * [ARGS]:		DIAG_CounterType counter :	This Arg shall indicate the counter
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void DIAG_count(DIAG_CounterType counter)
+{
+	if(g_DIAG_counters[counter] != 0xFFFF)
+	{
+		g_DIAG_counters[counter]++;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DIAG_send
+ * [DESCRIPTION]:	This Function is used to collect the counters of the application and of
+ * 					the drivers and send them in one report, see diag.h for its layout
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void DIAG_send(void)
+{
+	uint32 latency = SCHED_getMaxLatency() / (F_CPU / 1000000UL);
+	uint16 framing;
+	uint16 overrun;
+
+	UART_getErrors(&framing, &overrun);
+
+	LINK_sendReport(DIAGNOSTICS, DIAG_FRAME_SIZE);
+	DIAG_sendWord(g_DIAG_counters[DIAG_UNLOCKS]);
+	DIAG_sendWord(g_DIAG_counters[DIAG_FAILED_ATTEMPTS]);
+	DIAG_sendWord(framing);
+	DIAG_sendWord(overrun);
+	DIAG_sendWord(g_DIAG_counters[DIAG_TWI_RETRIES]);
+	DIAG_sendWord(g_DIAG_counters[DIAG_EEPROM_WRITES]);
+	DIAG_sendWord(g_DIAG_counters[DIAG_EEPROM_DROPS]);
+	DIAG_sendWord((latency > 0xFFFF) ? 0xFFFF : (uint16)latency);
+	DIAG_sendWord(DIAG_stackHighWater());
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DIAG_stackHighWater
+ * [DESCRIPTION]:	This Function is used to find the lowest byte of the filled RAM that
+ * 					the stack changed, the search starts from the end of the variables
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The most bytes of stack used, 0 on the host
+ ----------------------------------------------------------------------------------------*/
+static uint16 DIAG_stackHighWater(void)
+{
+#if defined(__AVR__)
+	const uint8 *byte = &__heap_start;
+
+	while((byte < (const uint8 *)SP) && (*byte == DIAG_STACK_PATTERN))
+	{
+		byte++;
+	}
+
+	return (uint16)((const uint8 *)RAMEND - byte + 1);
+#else
+	return 0;
+#endif
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	DIAG_sendWord
+ * [DESCRIPTION]:	This Function is used to send a 2 bytes word, least significant first
+ * [ARGS]:		uint16 word :	This Arg shall indicate the word to send
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void DIAG_sendWord(uint16 word)
+{
+	UART_sendByte((uint8)word);
+	UART_sendByte((uint8)(word >> 8));
+}
@@ -0,0 +1,70 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<diag.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the diagnostics counters of mC2>
+ ---------------------------------------------------------------------------*/
+
+#ifndef DIAG_H_
+#define DIAG_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+#define DIAG_STACK_PATTERN		0xC5	/* The free RAM is filled with it at the start */
+
+/*
+ * The answer of the DIAGNOSTICS report, see link.h, is:
+ * [ unlocks[2] - failed attempts[2] - UART framing errors[2] -
+ *   UART overruns[2] - TWI retries[2] - EEPROM writes[2] - EEPROM drops[2] -
+ *   max loop latency[2] - stack high-water mark[2] ]
+ * The counters are since the reset, least significant byte first, and stop at
+ * 0xFFFF. The latency is in us and the high-water mark is the most bytes of
+ * stack used, 0 where the stack is not measured.
+ */
+#define DIAG_FRAME_SIZE			18		/* Size of the answer */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* The counters of the application, the drivers keep their own */
+typedef enum
+{
+	DIAG_UNLOCKS,			/* Door cycles started by a right password */
+	DIAG_FAILED_ATTEMPTS,	/* Wrong passwords */
+	DIAG_TWI_RETRIES,		/* EEPROM writes that were not acknowledged */
+	DIAG_EEPROM_WRITES,		/* Bytes written in the EEPROM */
+	DIAG_EEPROM_DROPS,		/* Bytes not written: refused by a full queue, dropped after
+							 * all their retries or with a dropped byte of their record */
+	DIAG_NUM_OF_COUNTERS
+}DIAG_CounterType;
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to fill the free RAM under the stack with the pattern
+ * to measure its high-water mark, it shall be called first with the interrupts
+ * disabled
+ */
+void DIAG_init(void);
+
+
+/*
+ * Description:
+ * This Function is used to count an event of the application
+ */
+void DIAG_count(DIAG_CounterType counter);
+
+
+/*
+ * Description:
+ * This Function is used to send the frame of the counters by UART
+ */
+void DIAG_send(void);
+
+#endif /* DIAG_H_ */
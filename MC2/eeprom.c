@@ -29,7 +29,8 @@ void EEPROM_init(void)
 
 /*---------------------------------------------------------------------------------------
  * [FUNCTION NAME]:	EEPROM_writeByte
- * [DESCRIPTION]:	This Function is used to write a data byte in EEPROM.
+ * [DESCRIPTION]:	This Function is used to write a data byte in EEPROM. The bus is
+ * 					released if the EEPROM does not acknowledge, so the write can be retried.
  * [ARGS]:		uint16 u16address:	This Argument shall indicate the address of location in
  * 									EEPROM we want to write in it.
  * 				uint8 u8data:	This Argument shall indicate the data we want to write in
@@ -46,23 +47,35 @@ uint8 EEPROM_writeByte(uint16 u16address,uint8 u8data)
 	/* Send a start bit then check for the TWI status */
 	TWI_start();
 	if(TWI_getStatus() != TWI_START)
+	{
+		TWI_stop();
 		return ERROR;
+	}
 
 	/* Send the device address bits + Write bit, then check for the TWI status. it will return
 	 * ACK bit */
 	TWI_writeByte((uint8)((u16address & 0x0700) >> 7) | 0xA0);
 	if(TWI_getStatus() != TWI_MT_SLA_W_ACK)
+	{
+		TWI_stop();
 		return ERROR;
+	}
 
 	/* Send the location address bits, then check for the TWI status. it will return ACK bit */
 	TWI_writeByte((uint8)(u16address));
 	if(TWI_getStatus() != TWI_MT_DATA_ACK)
+	{
+		TWI_stop();
 		return ERROR;
+	}
 
 	/* Send the data bits, then check for the TWI status. it will return ACK bit */
 	TWI_writeByte(u8data);
 	if(TWI_getStatus() != TWI_MT_DATA_ACK)
+	{
+		TWI_stop();
 		return ERROR;
+	}
 
 	/* Send the stop bit to finish the process */
 	TWI_stop();
@@ -21,12 +21,20 @@
 #define SUCCESS		1
 
 #define EEPROM_FRAME_DELAY					500
+#define EEPROM_WRITE_CYCLE_TIME				10		/* Time in ms of the internal write cycle */
 
 #define PASSWORD_FIRST_TIME					255
-#define PASSWORD_NOT_FIRST_TIME				0
-#define	EEPROM_PASS_SIZE					0x1F4
+#define PASSWORD_NOT_FIRST_TIME				0		/* Old record, the password is in clear */
+#define PASSWORD_HASHED						1		/* The record is the salt and the hash */
+#define	EEPROM_PASS_SIZE					0x1F4	/* Size of the old clear password */
 #define	EEPROM_PASS_ADDRESS					0x3E8	/* Set an adress of 1000 as an Example */
+#define EEPROM_HASH_ADDRESS					0x3E8	/* Hash of the password, it replaces the clear one */
+#define EEPROM_SALT_ADDRESS					0x3F0	/* Salt of the hash */
 #define EEPROM_ADDRESS_FLAG					0x0C8
+#define EEPROM_LOG_INDEX_ADDRESS			0x12C	/* Index of the next record of the fault log */
+#define EEPROM_LOG_ADDRESS					0x12D	/* First record of the fault log */
+#define EEPROM_RNG_SEED_ADDRESS				0x3F8	/* Seed of the entropy pool for the next boot */
+#define EEPROM_FAILURES_ADDRESS				0x156	/* Wrong password attempts in a row, 0xFF when erased */
 
 /*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
 /*
@@ -0,0 +1,184 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<hash.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the SipHash-2-4 password hash>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "hash.h"
+#include <avr/pgmspace.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define HASH_C_ROUNDS		2		/* Rounds per message block */
+#define HASH_D_ROUNDS		4		/* Rounds of the finalization */
+
+#define HASH_ROTL(word,num)	(((word) << (num)) | ((word) >> (64 - (num))))
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static const uint8 g_HASH_pepper[HASH_SALT_SIZE] PROGMEM = HASH_PEPPER;
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void HASH_start(uint64 *v, const uint8 *a_saltPtr);
+static uint64 HASH_finish(uint64 *v, uint64 m);
+static uint64 HASH_load(const uint8 *a_bytesPtr, boolean progmem);
+static void HASH_rounds(uint64 *v, uint8 rounds);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HASH_compute
+ * [DESCRIPTION]:	This Function is used to compute the SipHash-2-4 of a message with the
+ * 					key made of the salt and the pepper. The message is taken in blocks of
+ * 					8 bytes, the last block holds the rest of the message and its size
+ * [ARGS]:		const uint8 *a_saltPtr :	This Arg shall indicate the salt
+ * 				const uint8 *a_dataPtr :	This Arg shall indicate the message
+ * 				uint8 size :				This Arg shall indicate the size of the message
+ * [RETURNS]:	The hash, its bytes are saved from the least significant one
+ ----------------------------------------------------------------------------------------*/
+uint64 HASH_compute(const uint8 *a_saltPtr, const uint8 *a_dataPtr, uint8 size)
+{
+	uint64 v[4];
+	uint64 m;
+	uint8 i;
+
+	HASH_start(v, a_saltPtr);
+	for(i = 0; (uint8)(size - i) >= 8; i += 8)
+	{
+		m = HASH_load(&a_dataPtr[i], FALSE);
+		v[3] ^= m;
+		HASH_rounds(v, HASH_C_ROUNDS);
+		v[0] ^= m;
+	}
+
+	/* The last block, the size is in its most significant byte */
+	m = (uint64)size << 56;
+	for(; i < size; i++)
+	{
+		m |= (uint64)a_dataPtr[i] << (8 * (i & 7));
+	}
+
+	return HASH_finish(v, m);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HASH_verify
+ * [DESCRIPTION]:	This Function is used to check a message against a hash in a constant
+ * 					time. The message is in a buffer of HASH_VERIFY_SIZE bytes padded with
+ * 					zeros, all the bytes of the buffer are taken whatever the size, which
+ * 					gives the same hash as HASH_compute. The hashes are compared by folding
+ * 					their difference in one byte, there is no branch on a byte of the
+ * 					message or of the hash
+ * [ARGS]:		const uint8 *a_saltPtr :	This Arg shall indicate the salt
+ * 				const uint8 *a_bufferPtr :	This Arg shall indicate the buffer of the message
+ * 				uint8 size :				This Arg shall indicate the size of the message, it
+ * 											shall not be more than HASH_VERIFY_SIZE
+ * 				uint64 hash :				This Arg shall indicate the expected hash
+ * [RETURNS]:	TRUE if the hash of the message is the expected hash, else FALSE
+ ----------------------------------------------------------------------------------------*/
+boolean HASH_verify(const uint8 *a_saltPtr, const uint8 *a_bufferPtr, uint8 size, uint64 hash)
+{
+	uint64 v[4];
+	uint64 m = size;
+	uint8 i;
+
+	HASH_start(v, a_saltPtr);
+
+	/* The size ends in the most significant byte after the shifts by whole bytes */
+	for(i = HASH_VERIFY_SIZE; i > 0; i--)
+	{
+		m = (m << 8) | a_bufferPtr[i - 1];
+	}
+
+	hash ^= HASH_finish(v, m);
+	hash |= hash >> 32;
+	hash |= hash >> 16;
+	hash |= hash >> 8;
+
+	/* 1 only if the folded difference is 0 */
+	return (boolean)((((uint16)(uint8)hash - 1) >> 8) & 1);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HASH_start
+ * [DESCRIPTION]:	This Function is used to initialize the state with the key made of the
+ * 					salt and the pepper
+ * [ARGS]:		uint64 *v :					This Arg shall indicate the four words of the state
+ * 				const uint8 *a_saltPtr :	This Arg shall indicate the salt
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HASH_start(uint64 *v, const uint8 *a_saltPtr)
+{
+	uint64 k0 = HASH_load(a_saltPtr, FALSE);
+	uint64 k1 = HASH_load(g_HASH_pepper, TRUE);
+
+	v[0] = k0 ^ 0x736F6D6570736575ULL;
+	v[1] = k1 ^ 0x646F72616E646F6DULL;
+	v[2] = k0 ^ 0x6C7967656E657261ULL;
+	v[3] = k1 ^ 0x7465646279746573ULL;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HASH_finish
+ * [DESCRIPTION]:	This Function is used to compress the last block and finalize the state
+ * [ARGS]:		uint64 *v :		This Arg shall indicate the four words of the state
+ * 				uint64 m :		This Arg shall indicate the last block with the size
+ * [RETURNS]:	The hash
+ ----------------------------------------------------------------------------------------*/
+static uint64 HASH_finish(uint64 *v, uint64 m)
+{
+	v[3] ^= m;
+	HASH_rounds(v, HASH_C_ROUNDS);
+	v[0] ^= m;
+
+	v[2] ^= 0xFF;
+	HASH_rounds(v, HASH_D_ROUNDS);
+
+	return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HASH_load
+ * [DESCRIPTION]:	This Function is used to read 8 bytes as a little endian word
+ * [ARGS]:		const uint8 *a_bytesPtr :	This Arg shall indicate the bytes
+ * 				boolean progmem :			This Arg shall indicate if the bytes are in the flash
+ * [RETURNS]:	The word
+ ----------------------------------------------------------------------------------------*/
+static uint64 HASH_load(const uint8 *a_bytesPtr, boolean progmem)
+{
+	uint64 word = 0;
+	uint8 i = 8;
+
+	while(i > 0)
+	{
+		i--;
+		word = (word << 8) | ((progmem == TRUE) ? pgm_read_byte(&a_bytesPtr[i]) : a_bytesPtr[i]);
+	}
+	return word;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	HASH_rounds
+ * [DESCRIPTION]:	This Function is used to run SipRounds on the state, the rotations by
+ * 					16 and 32 are byte moves on the AVR
+ * [ARGS]:		uint64 *v :		This Arg shall indicate the four words of the state
+ * 				uint8 rounds :	This Arg shall indicate the number of rounds
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void HASH_rounds(uint64 *v, uint8 rounds)
+{
+	while(rounds > 0)
+	{
+		v[0] += v[1]; v[1] = HASH_ROTL(v[1], 13); v[1] ^= v[0]; v[0] = HASH_ROTL(v[0], 32);
+		v[2] += v[3]; v[3] = HASH_ROTL(v[3], 16); v[3] ^= v[2];
+		v[0] += v[3]; v[3] = HASH_ROTL(v[3], 21); v[3] ^= v[0];
+		v[2] += v[1]; v[1] = HASH_ROTL(v[1], 17); v[1] ^= v[2]; v[2] = HASH_ROTL(v[2], 32);
+		rounds--;
+	}
+}
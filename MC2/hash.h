@@ -0,0 +1,50 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<hash.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the SipHash-2-4 password hash>
+ ---------------------------------------------------------------------------*/
+
+#ifndef HASH_H_
+#define HASH_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+#define HASH_SIZE				8		/* Bytes of a hash */
+#define HASH_SALT_SIZE			8		/* Bytes of the salt saved with a hash */
+#define HASH_VERIFY_SIZE		7		/* Bytes of the buffer of HASH_verify, one block with the size */
+
+/*
+ * The 128-bit key of SipHash is the salt followed by the pepper. The salt is
+ * saved in the EEPROM next to the hash and the pepper is only in the flash, so
+ * a dump of the external EEPROM is not enough to search the passwords. It shall
+ * be changed for each installation.
+ */
+#define HASH_PEPPER				{0x6D, 0x43, 0x32, 0x2D, 0x70, 0x65, 0x70, 0x72}
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to compute the hash of a message with a salt. A
+ * message shorter than 8 bytes is always one compression round, so the time
+ * of the hash of a password does not depend on it
+ */
+uint64 HASH_compute(const uint8 *a_saltPtr, const uint8 *a_dataPtr, uint8 size);
+
+
+/*
+ * Description:
+ * This Function is used to check a message in a zero padded buffer of
+ * HASH_VERIFY_SIZE bytes against a hash. The time does not depend on the
+ * size or on the bytes of the message, nor on the bytes that match
+ */
+boolean HASH_verify(const uint8 *a_saltPtr, const uint8 *a_bufferPtr, uint8 size, uint64 hash);
+
+#endif /* HASH_H_ */
@@ -13,7 +13,18 @@
 #include "lcd.h"
 #include "gpio.h"
 #include <util/delay.h>
-#include <stdlib.h>
+#include <avr/pgmspace.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* Powers of ten used to extract the digits by subtraction instead of division,
+ * the AVR has no divider so each division by 10 is a call to the 32-bit division
+ * routine of the library */
+static const uint32 g_LCD_powersOfTen[LCD_MAX_DIGITS] PROGMEM =
+{
+	1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL,
+	10000000UL, 100000000UL, 1000000000UL
+};
 
 /*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
 
@@ -38,14 +49,14 @@ void LCD_sendCommand(uint8 command)
 	 * 7. delay t(dsw) = 100 ns	~1ms
 	 * 8. E = 0
 	 * 9. delay t(h) = 13 ns 	~1ms */
-	GPIO_writePin(LCD_PORT, LCD_RS_PIN, LOGIC_LOW);
-	GPIO_writePin(LCD_PORT, LCD_RW_PIN, LOGIC_LOW);
+	GPIO_PIN_LOW(LCD_PORT, LCD_RS_PIN);
+	GPIO_PIN_LOW(LCD_PORT, LCD_RW_PIN);
 	_delay_ms(1);
-	GPIO_writePin(LCD_PORT, LCD_E_PIN, LOGIC_HIGH);
+	GPIO_PIN_HIGH(LCD_PORT, LCD_E_PIN);
 	_delay_ms(1);
-	GPIO_writePort(LCD_DB_PORT, command);
+	GPIO_PORT_WRITE(LCD_DB_PORT, command);
 	_delay_ms(1);
-	GPIO_writePin(LCD_PORT, LCD_E_PIN, LOGIC_LOW);
+	GPIO_PIN_LOW(LCD_PORT, LCD_E_PIN);
 	_delay_ms(1);
 }
 
@@ -70,14 +81,14 @@ void LCD_displayCharacter(uint8 character)
 	 * 7. delay t(dsw) = 100 ns	~1ms
 	 * 8. E = 0
 	 * 9. delay t(h) = 13 ns 	~1ms */
-	GPIO_writePin(LCD_PORT, LCD_RS_PIN, LOGIC_HIGH);
-	GPIO_writePin(LCD_PORT, LCD_RW_PIN, LOGIC_LOW);
+	GPIO_PIN_HIGH(LCD_PORT, LCD_RS_PIN);
+	GPIO_PIN_LOW(LCD_PORT, LCD_RW_PIN);
 	_delay_ms(1);
-	GPIO_writePin(LCD_PORT, LCD_E_PIN, LOGIC_HIGH);
+	GPIO_PIN_HIGH(LCD_PORT, LCD_E_PIN);
 	_delay_ms(1);
-	GPIO_writePort(LCD_DB_PORT, character);
+	GPIO_PORT_WRITE(LCD_DB_PORT, character);
 	_delay_ms(1);
-	GPIO_writePin(LCD_PORT, LCD_E_PIN, LOGIC_LOW);
+	GPIO_PIN_LOW(LCD_PORT, LCD_E_PIN);
 	_delay_ms(1);
 }
 
@@ -95,10 +106,10 @@ void LCD_init(void)
 	 * 3. Send command to initiate 2-lines,8-bit mode
 	 * 4. Send command to set cursor off
 	 * 5. Send command to clear The screen */
-	GPIO_setPinDirection(LCD_PORT, LCD_RS_PIN, PIN_OUTPUT);
-	GPIO_setPinDirection(LCD_PORT, LCD_RW_PIN, PIN_OUTPUT);
-	GPIO_setPinDirection(LCD_PORT, LCD_E_PIN, PIN_OUTPUT);
-	GPIO_setPortDirection(LCD_DB_PORT, PORT_OUTPUT);
+	GPIO_PIN_OUTPUT(LCD_PORT, LCD_RS_PIN);
+	GPIO_PIN_OUTPUT(LCD_PORT, LCD_RW_PIN);
+	GPIO_PIN_OUTPUT(LCD_PORT, LCD_E_PIN);
+	GPIO_PORT_DIRECTION(LCD_DB_PORT, PORT_OUTPUT);
 	LCD_sendCommand(LCD_2LINES_8BITS_MODE);
 	LCD_sendCommand(LCD_CURSOR_OFF);
 	LCD_sendCommand(LCD_CLEAR_SCREEN);
@@ -176,9 +187,73 @@ void LCD_clearScreen(void)
 	LCD_sendCommand(LCD_CLEAR_SCREEN);
 }
 
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LCD_integerToString
+ * [DESCRIPTION]:	This Function is used to display a number on the LCD with no padding
+ * [ARGS]:
+ * [in]		uint32 integer :	This Arg shall indicate the number to display on LCD
+ *	[RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
 void LCD_integerToString(uint32 integer)
 {
-	char buffer[16];
-	itoa(integer, buffer, 10);
-	LCD_displayString(buffer);
+	LCD_displayNumber(integer, 0, LCD_ALIGN_RIGHT, ' ');
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	LCD_displayNumber
+ * [DESCRIPTION]:	This Function is used to display a number in a field of a fixed width,
+ * 					the digits are sent to the LCD one by one without any buffer. If the
+ * 					number needs more digits than the width, all the digits are displayed
+ * [ARGS]:
+ * [in]		uint32 number :			This Arg shall indicate the number to display on LCD
+ * 			uint8 width :			This Arg shall indicate the minimum number of characters
+ * 									to display
+ * 			LCD_AlignType align :	This Arg shall indicate whether the number is aligned to
+ * 									the right or to the left of the field
+ * 			uint8 pad :				This Arg shall indicate the character used to fill the
+ * 									field (' ' or '0' as an example)
+ *	[RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void LCD_displayNumber(uint32 number, uint8 width, LCD_AlignType align, uint8 pad)
+{
+	uint8 digits = 1;
+	uint8 digit;
+	uint8 i;
+	uint32 power;
+
+	/* Count the digits of the number by comparing it with the powers of ten */
+	while((digits < LCD_MAX_DIGITS) && (number >= pgm_read_dword(&g_LCD_powersOfTen[digits])))
+	{
+		digits++;
+	}
+
+	if(align == LCD_ALIGN_RIGHT)
+	{
+		for(i = digits; i < width; i++)
+		{
+			LCD_displayCharacter(pad);
+		}
+	}
+
+	/* Each digit is the number of times its power of ten can be subtracted,
+	 * which takes 9 subtractions at most */
+	for(i = digits; i > 0; i--)
+	{
+		power = pgm_read_dword(&g_LCD_powersOfTen[i - 1]);
+		digit = '0';
+		while(number >= power)
+		{
+			number -= power;
+			digit++;
+		}
+		LCD_displayCharacter(digit);
+	}
+
+	if(align == LCD_ALIGN_LEFT)
+	{
+		for(i = digits; i < width; i++)
+		{
+			LCD_displayCharacter(pad);
+		}
+	}
 }
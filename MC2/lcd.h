@@ -32,6 +32,15 @@
 #define LCD_CLEAR_SCREEN		0x01
 #define LCD_SET_CURSOR_AT_BEGIN	0x80
 
+#define LCD_MAX_DIGITS			10		/* Number of digits of the biggest uint32 value */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	LCD_ALIGN_RIGHT,LCD_ALIGN_LEFT
+}LCD_AlignType;
+
 /*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
 /*
  * Description:
@@ -87,4 +96,12 @@ void LCD_clearScreen(void);
  */
 void LCD_integerToString(uint32 integer);
 
+
+/*
+ * Description:
+ * This function is used in displaying a number in a fixed width field on LCD,
+ * padded with the given character and aligned to the right or to the left
+ */
+void LCD_displayNumber(uint32 number, uint8 width, LCD_AlignType align, uint8 pad);
+
 #endif /* LCD_H_ */
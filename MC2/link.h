@@ -0,0 +1,145 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<link.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the authenticated frames of the UART link>
+ ---------------------------------------------------------------------------*/
+
+#ifndef LINK_H_
+#define LINK_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+#include "uart_commands.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/*
+ * A session starts when mC2 sends LINK_CHALLENGE with a fresh nonce and mC1
+ * answers with the LINK_RESPONSE frame that holds its own fresh nonce. The
+ * secret initial state of the MACs of the session is the Speck block of the
+ * two nonces, so a frame of another session never passes.
+ *
+ * Every other message is a frame:
+ * [command][size][sequence][payload][MAC, 4 bytes least significant first]
+ * The MAC is the CBC-MAC of the 32-bit sequence number, the sender, the command,
+ * the size and the payload. Only the low byte of the sequence is sent, a frame
+ * is taken if its sequence is less than LINK_SEQ_WINDOW after the last taken
+ * frame, so lost frames are skipped but a replayed frame is always rejected.
+ * LINK_HELLO, PROFILE_DUMP and DIAGNOSTICS are single bytes without a MAC, they
+ * can not change the state of the system. Their answers are reports for a PC
+ * on the line, also without a MAC:
+ * [LINK_REPORT][size][command][answer]
+ * The size counts the command and the answer, the link skips the whole report
+ * so it is never taken as the start of a frame.
+ *
+ * A message cut by a lost byte is dropped when no byte is received for
+ * LINK_BYTE_TIMEOUT, so the next message is taken from its first byte. After
+ * LINK_MAX_REJECTS frames in a row that fail their check the session is closed
+ * and a new handshake is needed.
+ */
+#define LINK_MAX_PAYLOAD		12		/* The password frame is the largest payload */
+#define LINK_HEADER_SIZE		3		/* Command, size and sequence */
+#define LINK_MAC_SIZE			4
+#define LINK_SEQ_WINDOW			16
+#define LINK_BYTE_TIMEOUT		20		/* Time in ms between two bytes of a message */
+#define LINK_MAX_REJECTS		3		/* Frames in a row failing their check that close the session */
+
+/* The sender of a frame, it is in the MAC so a frame can not be sent back */
+#define LINK_MC1				0
+#define LINK_MC2				1
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	LINK_BUSY,			/* The message is not complete */
+	LINK_FRAME,			/* A frame passed its MAC and its sequence check */
+	LINK_PLAIN,			/* A message without a MAC of the handshake, PROFILE_DUMP or DIAGNOSTICS */
+	LINK_REJECTED,		/* A frame failed its checks and is dropped */
+	LINK_LOST			/* Too many frames were rejected, the session is closed */
+}LINK_StatusType;
+
+typedef struct
+{
+	uint8 command;
+	uint8 size;
+	uint8 payload[LINK_MAX_PAYLOAD];
+}LINK_FrameType;
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to initialize the link for mC1 or mC2, no frame is
+ * sent or taken until a session is opened
+ */
+void LINK_init(uint8 device);
+
+
+/*
+ * Description:
+ * This Function is used by mC1 to ask mC2 for a new session
+ */
+void LINK_hello(void);
+
+
+/*
+ * Description:
+ * This Function is used by mC2 to close the session and send a challenge
+ * with a fresh nonce, the session is opened by the response of mC1
+ */
+void LINK_challenge(uint32 nonce);
+
+
+/*
+ * Description:
+ * This Function is used by mC1 to open the session of a received challenge
+ * and send the response with a fresh nonce
+ */
+void LINK_respond(uint32 nonce, const LINK_FrameType *a_challengePtr);
+
+
+/*
+ * Description:
+ * This Function is used to check if a session is opened
+ */
+boolean LINK_isOpen(void);
+
+
+/*
+ * Description:
+ * This Function is used to send a frame of the session, nothing is sent
+ * while no session is opened
+ */
+void LINK_send(uint8 command, const uint8 *a_payloadPtr, uint8 size);
+
+
+/*
+ * Description:
+ * This Function is used to send the last frame again with the next sequence
+ * of the session, it returns FALSE if no frame was sent since the init
+ */
+boolean LINK_resend(void);
+
+
+/*
+ * Description:
+ * This Function is used to send the header of a report, the size bytes of
+ * the answer shall be sent right after it
+ */
+void LINK_sendReport(uint8 command, uint8 size);
+
+
+/*
+ * Description:
+ * This Function is used to take a received byte, the same frame shall be
+ * given for all the bytes of a message. The frame is valid when LINK_FRAME
+ * or LINK_PLAIN is returned
+ */
+LINK_StatusType LINK_receive(uint8 byte, LINK_FrameType *a_framePtr);
+
+#endif /* LINK_H_ */
@@ -0,0 +1,180 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<position.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the door position sensors driver>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "position.h"
+#include "common_macros.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static void(* volatile g_POSITION_limitCallBackPtr)(void) = NULL_PTR;
+
+/* Encoder edges counted by the input capture ISR */
+static volatile sint16 g_POSITION_count = 0;
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	POSITION_init
+ * [DESCRIPTION]:	This Function is used to initialize the limit switches on INT0 and INT1
+ * 					on the falling edge and the encoder on the Timer1 input capture. Timer1
+ * 					is left running as the system tick, only its capture unit is used
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void POSITION_init(void)
+{
+#if (POSITION_LIMIT_SWITCH_ENABLE == TRUE)
+	GPIO_PIN_INPUT(POSITION_CLOSED_PORT_ID, POSITION_CLOSED_PIN_ID);
+	GPIO_PIN_INPUT(POSITION_OPEN_PORT_ID, POSITION_OPEN_PIN_ID);
+	GPIO_PIN_HIGH(POSITION_CLOSED_PORT_ID, POSITION_CLOSED_PIN_ID);
+	GPIO_PIN_HIGH(POSITION_OPEN_PORT_ID, POSITION_OPEN_PIN_ID);
+
+	/* Falling edge of INT0 and INT1 */
+	MCUCR = (MCUCR & 0xF0) | (1<<ISC01) | (1<<ISC11);
+	GIFR = (1<<INTF0) | (1<<INTF1);
+	GICR |= (1<<INT0) | (1<<INT1);
+#endif
+
+#if (POSITION_ENCODER_ENABLE == TRUE)
+	GPIO_PIN_INPUT(POSITION_ENCODER_A_PORT_ID, POSITION_ENCODER_A_PIN_ID);
+	GPIO_PIN_INPUT(POSITION_ENCODER_B_PORT_ID, POSITION_ENCODER_B_PIN_ID);
+
+	/* Noise canceler on, start with the rising edge, the edge is toggled by the ISR
+	 * to capture both edges of the channel A */
+	SET_BIT(TCCR1B,ICNC1);
+	SET_BIT(TCCR1B,ICES1);
+	TIFR = (1<<ICF1);
+	SET_BIT(TIMSK,TICIE1);
+#endif
+
+	/* Enable the global interrupt */
+	SREG |= (1<<7);
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	POSITION_getLimit
+ * [DESCRIPTION]:	This Function is used to read which limit switch is pressed
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The pressed limit switch, or POSITION_NO_LIMIT
+ ----------------------------------------------------------------------------------------*/
+POSITION_LimitType POSITION_getLimit(void)
+{
+#if (POSITION_LIMIT_SWITCH_ENABLE == TRUE)
+	if(GPIO_PIN_READ(POSITION_CLOSED_PORT_ID, POSITION_CLOSED_PIN_ID) == POSITION_SWITCH_PRESSED)
+	{
+		return POSITION_CLOSED_LIMIT;
+	}
+	if(GPIO_PIN_READ(POSITION_OPEN_PORT_ID, POSITION_OPEN_PIN_ID) == POSITION_SWITCH_PRESSED)
+	{
+		return POSITION_OPEN_LIMIT;
+	}
+#endif
+	return POSITION_NO_LIMIT;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	POSITION_setLimitCallBack
+ * [DESCRIPTION]:	This Function is used to set the call back function called from the ISR
+ * 					when a limit switch is pressed
+ * [ARGS]:		void(*a_ptr)(void) :	This Arg shall indicate the call back function
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void POSITION_setLimitCallBack(void(*a_ptr)(void))
+{
+	g_POSITION_limitCallBackPtr = a_ptr;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	POSITION_getCount
+ * [DESCRIPTION]:	This Function is used to get the encoder count, the interrupts are
+ * 					disabled while the two bytes are read
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The encoder count
+ ----------------------------------------------------------------------------------------*/
+sint16 POSITION_getCount(void)
+{
+	sint16 count;
+	uint8 sreg = SREG;
+
+	cli();
+	count = g_POSITION_count;
+	SREG = sreg;
+
+	return count;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	POSITION_setCount
+ * [DESCRIPTION]:	This Function is used to set the encoder count
+ * [ARGS]:		sint16 count :	This Arg shall indicate the new count
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void POSITION_setCount(sint16 count)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	g_POSITION_count = count;
+	SREG = sreg;
+}
+
+/*----------------------------------INTERRUPT SERVICE ROUTINES--------------------------*/
+#if (POSITION_LIMIT_SWITCH_ENABLE == TRUE)
+/*---------------------------------------------------------------------------------------
+ * [ISR NAME]:		INT0_vect
+ * [DESCRIPTION]:	This ISR is called when the closed limit switch is pressed
+ ----------------------------------------------------------------------------------------*/
+ISR(INT0_vect)
+{
+	if(g_POSITION_limitCallBackPtr != NULL_PTR)
+	{
+		(*g_POSITION_limitCallBackPtr)();
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [ISR NAME]:		INT1_vect
+ * [DESCRIPTION]:	This ISR is called when the open limit switch is pressed
+ ----------------------------------------------------------------------------------------*/
+ISR(INT1_vect)
+{
+	if(g_POSITION_limitCallBackPtr != NULL_PTR)
+	{
+		(*g_POSITION_limitCallBackPtr)();
+	}
+}
+#endif	/* POSITION_LIMIT_SWITCH_ENABLE */
+
+#if (POSITION_ENCODER_ENABLE == TRUE)
+/*---------------------------------------------------------------------------------------
+ * [ISR NAME]:		TIMER1_CAPT_vect
+ * [DESCRIPTION]:	This ISR is called on every edge of the encoder channel A. The channel B
+ * 					is different from the new level of A while the door is opening
+ ----------------------------------------------------------------------------------------*/
+ISR(TIMER1_CAPT_vect)
+{
+	uint8 a_level = BIT_IS_SET(TCCR1B,ICES1) ? LOGIC_HIGH : LOGIC_LOW;
+
+	/* Capture the other edge next time */
+	TOGGLE_BIT(TCCR1B,ICES1);
+
+	if(GPIO_PIN_READ(POSITION_ENCODER_B_PORT_ID, POSITION_ENCODER_B_PIN_ID) != a_level)
+	{
+		g_POSITION_count++;
+	}
+	else
+	{
+		g_POSITION_count--;
+	}
+}
+#endif	/* POSITION_ENCODER_ENABLE */
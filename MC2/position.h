@@ -0,0 +1,85 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<position.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the door position sensors driver>
+ ---------------------------------------------------------------------------*/
+
+#ifndef POSITION_H_
+#define POSITION_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+#include "gpio.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/* The closed limit switch is on INT0 (PD2) and the open one on INT1 (PD3), the
+ * switches connect the pin to ground and the internal pull ups are used */
+#define POSITION_LIMIT_SWITCH_ENABLE	TRUE
+#define POSITION_CLOSED_PORT_ID			PORTD_ID
+#define POSITION_CLOSED_PIN_ID			PIN2_ID
+#define POSITION_OPEN_PORT_ID			PORTD_ID
+#define POSITION_OPEN_PIN_ID			PIN3_ID
+#define POSITION_SWITCH_PRESSED			LOGIC_LOW
+
+/* The channel A of the quadrature encoder is on ICP1 (PD6), every edge of it is
+ * captured by Timer1 and the channel B tells the direction */
+#define POSITION_ENCODER_ENABLE			FALSE
+#define POSITION_ENCODER_A_PORT_ID		PORTD_ID
+#define POSITION_ENCODER_A_PIN_ID		PIN6_ID
+#define POSITION_ENCODER_B_PORT_ID		PORTD_ID
+#define POSITION_ENCODER_B_PIN_ID		PIN7_ID
+#define POSITION_OPEN_COUNT				1200	/* Encoder edges from closed to fully opened */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	POSITION_NO_LIMIT,POSITION_CLOSED_LIMIT,POSITION_OPEN_LIMIT
+}POSITION_LimitType;
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to initialize the limit switches interrupts and the
+ * encoder input capture
+ */
+void POSITION_init(void);
+
+
+/*
+ * Description:
+ * This Function is used to read which limit switch is pressed
+ */
+POSITION_LimitType POSITION_getLimit(void);
+
+
+/*
+ * Description:
+ * This Function is used to set the call back function called from the ISR
+ * when a limit switch is pressed
+ */
+void POSITION_setLimitCallBack(void(*a_ptr)(void));
+
+
+/*
+ * Description:
+ * This Function is used to get the encoder count, it increases while the
+ * door is opening
+ */
+sint16 POSITION_getCount(void);
+
+
+/*
+ * Description:
+ * This Function is used to set the encoder count, it is used to calibrate
+ * the count when a limit switch is reached
+ */
+void POSITION_setCount(sint16 count);
+
+#endif /* POSITION_H_ */
@@ -0,0 +1,83 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<prof.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the hot path profiling probes>
+ ---------------------------------------------------------------------------*/
+
+#ifndef PROF_H_
+#define PROF_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/* The probes are only built when the project is compiled with -DPROF_ENABLE=TRUE,
+ * otherwise every probe expands to nothing */
+#ifndef PROF_ENABLE
+#define PROF_ENABLE				FALSE
+#endif
+
+#define PROF_BUFFER_SIZE		16		/* Number of records kept in the ring buffer */
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* The measured sections of mC2 */
+typedef enum
+{
+	PROF_PASSWORD_CHECK,	/* Comparing the received password with the saved one */
+	PROF_EEPROM_COMMIT,		/* Writing the new password in the EEPROM */
+	PROF_PASSWORD_DECRYPT,	/* Decrypting a received password frame */
+	PROF_NUM_OF_IDS
+}PROF_IdType;
+
+typedef struct
+{
+	uint8 id;
+	uint32 start;			/* Timestamp in CPU cycles */
+	uint32 duration;		/* Duration in CPU cycles */
+}PROF_RecordType;
+
+/*-------------------------------PROBES MACROS--------------------------------*/
+
+#if (PROF_ENABLE == TRUE)
+#define PROF_BEGIN(id)		PROF_begin(id)
+#define PROF_END(id)		PROF_end(id)
+#define PROF_DUMP()			PROF_dump()
+#else
+#define PROF_BEGIN(id)		((void)0)
+#define PROF_END(id)		((void)0)
+#define PROF_DUMP()			((void)0)
+#endif
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+
+#if (PROF_ENABLE == TRUE)
+/*
+ * Description:
+ * This Function is used to take the start timestamp of a measured section
+ */
+void PROF_begin(PROF_IdType id);
+
+
+/*
+ * Description:
+ * This Function is used to close a measured section and save its record in
+ * the ring buffer
+ */
+void PROF_end(PROF_IdType id);
+
+
+/*
+ * Description:
+ * This Function is used to send the records of the ring buffer by UART
+ */
+void PROF_dump(void);
+#endif
+
+#endif /* PROF_H_ */
@@ -13,42 +13,198 @@
 #include "pwm.h"
 #include "common_macros.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+/* TOP of each started channel, used to scale the duty cycle */
+static uint16 g_PWM_top[PWM_NUM_OF_CHANNELS];
 
 /*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
 
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	DcMotor_Init
- * [DESCRIPTION]:	This Function is used to initialize the DC motor
- * [ARGS]:		No Arguments
- *	[RETURNS]:	No Returns
+ * [FUNCTION NAME]:	PWM_init
+ * [DESCRIPTION]:	This Function is used to start a PWM channel in the non inverted mode
+ * 					with a duty cycle of zero. The prescaler and the TOP are taken from
+ * 					the configuration made by PWM_CONFIG
+ * [ARGS]:		const PWM_ConfigType *a_configPtr :	This Arg shall indicate the channel
+ * 												configuration
+ * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void PWM_Timer0_Start(uint8 duty_cycle)
+void PWM_init(const PWM_ConfigType *a_configPtr)
 {
-	TCNT0 = 0;
-	OCR0 = duty_cycle;
-
-	SET_BIT(DDRB,PB3);	/* Set PB3/OC0 pin as output */
-
-	/* Configure timer control register
-	 * 1. Fast PWM mode FOC0=0
-	 * 2. Fast PWM Mode WGM01=1 & WGM00=1
-	 * 3. Clear OC0 when match occurs (non inverted mode) COM00=0 & COM01=1
-	 * 4. clock = F_CPU/8 CS00=0 CS01=1 CS02=0
-	 */
-	TCCR0 = (1<<WGM00) | (1<<WGM01) | (1<<COM01) | (1<<CS01);
+#if (PWM_TIMER1_ENABLE == TRUE)
+	uint8 sreg;
+#endif
+
+	g_PWM_top[a_configPtr->channel] = a_configPtr->top;
+
+	switch(a_configPtr->channel)
+	{
+	case PWM_TIMER0_OC0 :
+		TCNT0 = 0;
+		OCR0 = 0;
+
+		SET_BIT(DDRB,PB3);	/* Set PB3/OC0 pin as output */
+
+		/* Configure timer control register
+		 * 1. Fast PWM WGM01=1 & WGM00=1, or Phase Correct PWM WGM01=0 & WGM00=1
+		 * 2. Clear OC0 when match occurs (non inverted mode) COM00=0 & COM01=1
+		 * 3. Clock from the configuration CS02:0
+		 */
+		TCCR0 = (1<<WGM00) | (1<<COM01) | (a_configPtr->clock & 0x07);
+		if(a_configPtr->mode == PWM_FAST)
+		{
+			SET_BIT(TCCR0,WGM01);
+		}
+		break;
+
+#if (PWM_TIMER1_ENABLE == TRUE)
+	case PWM_TIMER1_OC1A :
+	case PWM_TIMER1_OC1B :
+		if(a_configPtr->channel == PWM_TIMER1_OC1A)
+		{
+			SET_BIT(DDRD,PD5);	/* Set PD5/OC1A pin as output */
+			OCR1A = 0;
+			SET_BIT(TCCR1A,COM1A1);
+		}
+		else
+		{
+			SET_BIT(DDRD,PD4);	/* Set PD4/OC1B pin as output */
+			OCR1B = 0;
+			SET_BIT(TCCR1A,COM1B1);
+		}
+
+		/* The 16-bit registers are written with the interrupts disabled as they
+		 * share the temporary register with the ISRs */
+		sreg = SREG;
+		cli();
+		ICR1 = a_configPtr->top;
+		TCNT1 = 0;
+		SREG = sreg;
+
+		/* Fast PWM mode 14 or Phase Correct PWM mode 10, TOP = ICR1 */
+		SET_BIT(TCCR1A,WGM11);
+		CLEAR_BIT(TCCR1A,WGM10);
+		if(a_configPtr->mode == PWM_FAST)
+		{
+			TCCR1B = (1<<WGM13) | (1<<WGM12) | (a_configPtr->clock & 0x07);
+		}
+		else
+		{
+			TCCR1B = (1<<WGM13) | (a_configPtr->clock & 0x07);
+		}
+		break;
+#endif
+
+	default :
+		break;
+	}
 }
 
 
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	PWM_setDutyCycle
+ * [DESCRIPTION]:	This Function is used to change the duty cycle of a running channel, the
+ * 					new value is taken by the hardware at the next PWM period
+ * [ARGS]:		PWM_ChannelType channel :	This Arg shall indicate the channel
+ * 				uint8 duty_cycle :	This Arg shall indicate the duty cycle (0->255)
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void PWM_setDutyCycle(PWM_ChannelType channel, uint8 duty_cycle)
+{
+	if(channel == PWM_TIMER0_OC0)
+	{
+		/* The TOP of Timer0 is 255, no scaling is needed */
+		OCR0 = duty_cycle;
+	}
+	else
+	{
+		PWM_setCompareValue(channel, (uint16)(((uint32)duty_cycle * g_PWM_top[channel]) / 255));
+	}
+}
+
 
 /*---------------------------------------------------------------------------------------
- * [FUNCTION NAME]:	PWM_Timer0_Stop
- * [DESCRIPTION]:	This Function is used to de-initialize the PWM driver
- * [ARGS]:		No Arguments
+ * [FUNCTION NAME]:	PWM_setCompareValue
+ * [DESCRIPTION]:	This Function is used to write the compare value of a running channel
+ * [ARGS]:		PWM_ChannelType channel :	This Arg shall indicate the channel
+ * 				uint16 value :	This Arg shall indicate the compare value (0->TOP)
  * [RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void PWM_Timer0_Stop(void)
+void PWM_setCompareValue(PWM_ChannelType channel, uint16 value)
 {
-	TCNT0 = 0;
-	OCR0 = 0;
-	TCCR0 = 0;
+#if (PWM_TIMER1_ENABLE == TRUE)
+	uint8 sreg;
+#endif
+
+	switch(channel)
+	{
+	case PWM_TIMER0_OC0 :
+		OCR0 = (uint8)value;
+		break;
+
+#if (PWM_TIMER1_ENABLE == TRUE)
+	case PWM_TIMER1_OC1A :
+		sreg = SREG;
+		cli();
+		OCR1A = value;
+		SREG = sreg;
+		break;
+
+	case PWM_TIMER1_OC1B :
+		sreg = SREG;
+		cli();
+		OCR1B = value;
+		SREG = sreg;
+		break;
+#endif
+
+	default :
+		break;
+	}
+}
+
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	PWM_deInit
+ * [DESCRIPTION]:	This Function is used to de-initialize a PWM channel, Timer1 is stopped
+ * 					when both of its channels are disconnected
+ * [ARGS]:		PWM_ChannelType channel :	This Arg shall indicate the channel
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void PWM_deInit(PWM_ChannelType channel)
+{
+	switch(channel)
+	{
+	case PWM_TIMER0_OC0 :
+		TCNT0 = 0;
+		OCR0 = 0;
+		TCCR0 = 0;
+		break;
+
+#if (PWM_TIMER1_ENABLE == TRUE)
+	case PWM_TIMER1_OC1A :
+	case PWM_TIMER1_OC1B :
+		PWM_setCompareValue(channel, 0);
+		if(channel == PWM_TIMER1_OC1A)
+		{
+			CLEAR_BIT(TCCR1A,COM1A1);
+		}
+		else
+		{
+			CLEAR_BIT(TCCR1A,COM1B1);
+		}
+
+		if((TCCR1A & ((1<<COM1A1) | (1<<COM1B1))) == 0)
+		{
+			TCCR1A = 0;
+			TCCR1B = 0;
+		}
+		break;
+#endif
+
+	default :
+		break;
+	}
 }
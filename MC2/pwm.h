@@ -15,18 +15,108 @@
 
 #include "std_types.h"
 
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/*
+ * Timer1 is the system tick of this application and its input capture is used
+ * by the door encoder. Its PWM channels use ICR1 as TOP and take the whole
+ * timer, so they shall only be enabled on a board where both are moved away.
+ * Timer2 is left for the buzzer.
+ */
+#define PWM_TIMER1_ENABLE		FALSE
+
+/*
+ * The prescaler and the TOP of a channel are computed at compile time from the
+ * wanted frequency by PWM_CONFIG:
+ * - Timer0 has a fixed TOP of 255, the largest prescaler that still gives the
+ *   wanted frequency or more is selected, else no prescaling.
+ * - Timer1 uses ICR1 as TOP, the smallest prescaler that makes TOP fit in 16
+ *   bits is selected to get the highest resolution.
+ */
+#define PWM_TIMER0_FREQUENCY(div,mode)	(F_CPU / ((div) * (((mode) == PWM_FAST) ? 256UL : 510UL)))
+#define PWM_TIMER0_CLOCK(mode,freq)		\
+	((PWM_TIMER0_FREQUENCY(1024UL,mode) >= (freq)) ? 5 :	\
+	 (PWM_TIMER0_FREQUENCY(256UL,mode) >= (freq)) ? 4 :	\
+	 (PWM_TIMER0_FREQUENCY(64UL,mode) >= (freq)) ? 3 :		\
+	 (PWM_TIMER0_FREQUENCY(8UL,mode) >= (freq)) ? 2 : 1)
+
+#define PWM_TIMER1_TICKS(mode,freq)		(((mode) == PWM_FAST) ? (F_CPU / (freq)) : (F_CPU / (2UL * (freq))))
+#define PWM_TIMER1_CLOCK(mode,freq)		\
+	((PWM_TIMER1_TICKS(mode,freq) <= 65536UL) ? 1 :			\
+	 ((PWM_TIMER1_TICKS(mode,freq) / 8UL) <= 65536UL) ? 2 :	\
+	 ((PWM_TIMER1_TICKS(mode,freq) / 64UL) <= 65536UL) ? 3 :	\
+	 ((PWM_TIMER1_TICKS(mode,freq) / 256UL) <= 65536UL) ? 4 : 5)
+#define PWM_CLOCK_DIVIDER(clock)		\
+	(((clock) == 1) ? 1UL : ((clock) == 2) ? 8UL : ((clock) == 3) ? 64UL : ((clock) == 4) ? 256UL : 1024UL)
+#define PWM_TIMER1_TOP(mode,freq)		\
+	((PWM_TIMER1_TICKS(mode,freq) / PWM_CLOCK_DIVIDER(PWM_TIMER1_CLOCK(mode,freq))) - (((mode) == PWM_FAST) ? 1 : 0))
+
+/*
+ * Highest frequencies of Timer0, with no prescaling. PWM_CONFIG gives the highest
+ * one to a wanted frequency above it, so the users check their frequency with #if
+ * against these (the channels and modes are enums, #if cannot compare them)
+ */
+#define PWM_TIMER0_MAX_FAST_FREQUENCY			(F_CPU / 256UL)
+#define PWM_TIMER0_MAX_PHASE_CORRECT_FREQUENCY	(F_CPU / 510UL)
+
+/* Initializer of a PWM_ConfigType, all its arguments shall be constants */
+#define PWM_CONFIG(channel,mode,freq)	\
+	{(channel), (mode),					\
+	 ((channel) == PWM_TIMER0_OC0) ? PWM_TIMER0_CLOCK(mode,freq) : PWM_TIMER1_CLOCK(mode,freq),	\
+	 ((channel) == PWM_TIMER0_OC0) ? 255 : PWM_TIMER1_TOP(mode,freq)}
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	PWM_TIMER0_OC0,		/* PB3 */
+	PWM_TIMER1_OC1A,	/* PD5 */
+	PWM_TIMER1_OC1B,	/* PD4 */
+	PWM_NUM_OF_CHANNELS
+}PWM_ChannelType;
+
+typedef enum
+{
+	PWM_FAST,			/* Single slope, twice the frequency of the phase correct mode */
+	PWM_PHASE_CORRECT	/* Dual slope, the pulses are centered in the period */
+}PWM_ModeType;
+
+typedef struct
+{
+	PWM_ChannelType channel;
+	PWM_ModeType mode;
+	uint8 clock;		/* Clock select bits CS2:0 */
+	uint16 top;			/* Count of the PWM period, it is also the full duty cycle */
+}PWM_ConfigType;
+
 /*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
 /*
  * Description:
- * This Function is used to initialize the DC motor
+ * This Function is used to start a PWM channel with a duty cycle of zero
+ */
+void PWM_init(const PWM_ConfigType *a_configPtr);
+
+
+/*
+ * Description:
+ * This Function is used to change the duty cycle of a running channel, the
+ * duty cycle (0->255) is scaled to the TOP of the channel
+ */
+void PWM_setDutyCycle(PWM_ChannelType channel, uint8 duty_cycle);
+
+
+/*
+ * Description:
+ * This Function is used to write the compare value of a running channel
+ * directly, it gives the full resolution of the Timer1 channels
  */
-void PWM_Timer0_Start(uint8 duty_cycle);
+void PWM_setCompareValue(PWM_ChannelType channel, uint16 value);
 
 
 /*
  * Description:
- * This Function is used to de-initialize the PWM driver
+ * This Function is used to de-initialize a PWM channel
  */
-void PWM_Timer0_Stop(void);
+void PWM_deInit(PWM_ChannelType channel);
 
 #endif /* PWM_H_ */
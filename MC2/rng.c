@@ -0,0 +1,143 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<rng.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the entropy pool of the salts>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "rng.h"
+#include "cipher.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------PREPROCESSOR MACROS-------------------------------*/
+
+#define RNG_ROL(word,num)	(((word) << (num)) | ((word) >> (32 - (num))))
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static volatile uint32 g_RNG_pool[2];
+static volatile uint8 g_RNG_index = 0;		/* Word of the pool that takes the next sample */
+static uint32 g_RNG_counter = 0;			/* Makes each mixed block different */
+
+/*------------------------------FUNCTIONS PROTOTYPES(PRIVATE)----------------------------*/
+
+static void RNG_mix(uint32 *a_xPtr, uint32 *a_yPtr);
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	RNG_init
+ * [DESCRIPTION]:	This Function is used to add the saved seed to the pool. Its two words
+ * 					are XORed in the two words of the pool whole, RNG_addSample would
+ * 					overlap each sample of 16 bits with the one before and keep less than
+ * 					the 64 bits of the seed
+ * [ARGS]:		const uint8 *a_seedPtr :	This Arg shall indicate the RNG_SEED_SIZE bytes
+ * 											of the seed
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void RNG_init(const uint8 *a_seedPtr)
+{
+	uint32 x = 0;
+	uint32 y = 0;
+	uint8 sreg;
+	uint8 i;
+
+	/* The first half of the seed is the first word, least significant byte first */
+	for(i = 0; i < (RNG_SEED_SIZE / 2); i++)
+	{
+		x |= (uint32)a_seedPtr[i] << (8 * i);
+		y |= (uint32)a_seedPtr[i + (RNG_SEED_SIZE / 2)] << (8 * i);
+	}
+
+	sreg = SREG;
+	cli();
+	g_RNG_pool[0] ^= x;
+	g_RNG_pool[1] ^= y;
+	SREG = sreg;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	RNG_addSample
+ * [DESCRIPTION]:	This Function is used to add a sample to the pool. The words of the
+ * 					pool take the samples in turn, the word is rotated first so the bits
+ * 					of the old samples are not cancelled by the new ones
+ * [ARGS]:		uint16 sample :	This Arg shall indicate the sample
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void RNG_addSample(uint16 sample)
+{
+	uint8 sreg = SREG;
+	uint8 index;
+
+	cli();
+	index = g_RNG_index & 1;
+	g_RNG_pool[index] = RNG_ROL(g_RNG_pool[index], 7) ^ sample;
+	g_RNG_index++;
+	SREG = sreg;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	RNG_get
+ * [DESCRIPTION]:	This Function is used to get random bytes. Each 8 bytes are a Speck
+ * 					block of the pool and the counter, then one more block is added to the
+ * 					pool so the given bytes do not tell the next ones
+ * [ARGS]:		uint8 *a_bufferPtr :	This Arg shall indicate where the bytes are saved
+ * 				uint8 size :			This Arg shall indicate the number of bytes
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void RNG_get(uint8 *a_bufferPtr, uint8 size)
+{
+	uint32 x;
+	uint32 y;
+	uint8 sreg;
+	uint8 i;
+
+	for(i = 0; i < size; i++)
+	{
+		if((i % CIPHER_BLOCK_SIZE) == 0)
+		{
+			RNG_mix(&x, &y);
+		}
+		else if((i % CIPHER_BLOCK_SIZE) == (CIPHER_BLOCK_SIZE / 2))
+		{
+			x = y;
+		}
+
+		a_bufferPtr[i] = (uint8)x;
+		x >>= 8;
+	}
+
+	RNG_mix(&x, &y);
+	sreg = SREG;
+	cli();
+	g_RNG_pool[0] ^= x;
+	g_RNG_pool[1] ^= y;
+	SREG = sreg;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	RNG_mix
+ * [DESCRIPTION]:	This Function is used to encrypt the pool with the next counter, the
+ * 					interrupts are only disabled to read the pool
+ * [ARGS]:		uint32 *a_xPtr :	This Arg shall indicate where the first word is saved
+ * 				uint32 *a_yPtr :	This Arg shall indicate where the second word is saved
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+static void RNG_mix(uint32 *a_xPtr, uint32 *a_yPtr)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	*a_xPtr = g_RNG_pool[0];
+	*a_yPtr = g_RNG_pool[1];
+	SREG = sreg;
+
+	*a_yPtr ^= g_RNG_counter;
+	g_RNG_counter++;
+	CIPHER_encryptBlock(a_xPtr, a_yPtr);
+}
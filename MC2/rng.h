@@ -0,0 +1,52 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<rng.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the entropy pool of the salts>
+ ---------------------------------------------------------------------------*/
+
+#ifndef RNG_H_
+#define RNG_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/*
+ * The pool is two 32-bit words. The samples are only rotated and added in the
+ * pool so they can be given from the ISRs, the pool is mixed with the Speck
+ * cipher of the link when random bytes are read. The seed saved in the EEPROM
+ * is taken at the next boot so a cold boot does not start from an empty pool.
+ */
+#define RNG_SEED_SIZE			8
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to start the pool from the seed saved at the last
+ * boot, the cipher shall be initialized before
+ */
+void RNG_init(const uint8 *a_seedPtr);
+
+
+/*
+ * Description:
+ * This Function is used to add a sample of a noisy source to the pool, it can
+ * be called from an ISR
+ */
+void RNG_addSample(uint16 sample);
+
+
+/*
+ * Description:
+ * This Function is used to get random bytes from the pool, the pool is mixed
+ * again after each call so the bytes are never taken twice
+ */
+void RNG_get(uint8 *a_bufferPtr, uint8 size);
+
+#endif /* RNG_H_ */
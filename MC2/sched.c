@@ -0,0 +1,143 @@
+/*--------------------------------------------------------------------------------------
+ * [FILE NAME]:		<sched.c>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A source file for the cooperative task scheduler>
+ --------------------------------------------------------------------------------------*/
+
+/*----------------------------------------INCLUDES-------------------------------------*/
+
+#include "sched.h"
+#include "systick.h"
+#include "trace.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*------------------------------------GLOBAL VARIABLES----------------------------------*/
+
+static SCHED_TaskType g_SCHED_tasks[SCHED_MAX_TASKS];
+
+/* Pending events of each task, they are set from ISRs too */
+static volatile uint8 g_SCHED_events[SCHED_MAX_TASKS];
+
+/* Longest pass of the loop that ran a task, a ready event may wait that long */
+static uint32 g_SCHED_maxLatency = 0;
+
+/*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SCHED_createTask
+ * [DESCRIPTION]:	This Function is used to add a task to the scheduler
+ * [ARGS]:		uint8 task_id :	This Arg shall indicate the task id, it is also the task
+ * 								priority as the tasks are checked from id 0 upwards
+ * 				SCHED_TaskType a_taskPtr :	This Arg shall indicate the task function
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SCHED_createTask(uint8 task_id, SCHED_TaskType a_taskPtr)
+{
+	if(task_id < SCHED_MAX_TASKS)
+	{
+		g_SCHED_tasks[task_id] = a_taskPtr;
+		g_SCHED_events[task_id] = 0;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SCHED_setEvent
+ * [DESCRIPTION]:	This Function is used to set events for a task, the interrupts are
+ * 					disabled during the read-modify-write as an ISR may set events too
+ * [ARGS]:		uint8 task_id :	This Arg shall indicate the task id
+ * 				uint8 events :	This Arg shall indicate the events bits to set
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SCHED_setEvent(uint8 task_id, uint8 events)
+{
+	uint8 sreg;
+
+	if(task_id < SCHED_MAX_TASKS)
+	{
+		sreg = SREG;
+		cli();
+		g_SCHED_events[task_id] |= events;
+		SREG = sreg;
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SCHED_dispatch
+ * [DESCRIPTION]:	This Function is used to run the ready task that has the highest
+ * 					priority. Its events are cleared before it runs so any event set
+ * 					while it is running makes it ready again
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	TRUE if a task was run, FALSE if no task was ready
+ ----------------------------------------------------------------------------------------*/
+boolean SCHED_dispatch(void)
+{
+	uint8 id;
+	uint8 events;
+	uint8 sreg;
+
+	for(id = 0; id < SCHED_MAX_TASKS; id++)
+	{
+		if((g_SCHED_events[id] != 0) && (g_SCHED_tasks[id] != NULL_PTR))
+		{
+			sreg = SREG;
+			cli();
+			events = g_SCHED_events[id];
+			g_SCHED_events[id] = 0;
+			SREG = sreg;
+
+			(*g_SCHED_tasks[id])(events);
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SCHED_run
+ * [DESCRIPTION]:	This Function is used to run the scheduler forever. The expired system
+ * 					tick timers are served before every task so their events are seen by
+ * 					the priority check, the trace is sent in the idle time. The longest
+ * 					pass that ran a task is kept for the diagnostics
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	No Returns
+ ----------------------------------------------------------------------------------------*/
+void SCHED_run(void)
+{
+	uint32 start;
+	uint32 latency;
+
+	while(1)
+	{
+		start = SYSTICK_cycles();
+		SYSTICK_processTimers();
+		if(SCHED_dispatch() == FALSE)
+		{
+			/* The trace is sent while no task is ready */
+			TRACE_DRAIN();
+		}
+		else
+		{
+			latency = SYSTICK_cycles() - start;
+			if(latency > g_SCHED_maxLatency)
+			{
+				g_SCHED_maxLatency = latency;
+			}
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------
+ * [FUNCTION NAME]:	SCHED_getMaxLatency
+ * [DESCRIPTION]:	This Function is used to read the longest pass of the scheduler loop
+ * 					that ran a task
+ * [ARGS]:		No Arguments
+ * [RETURNS]:	The time of the pass in CPU cycles
+ ----------------------------------------------------------------------------------------*/
+uint32 SCHED_getMaxLatency(void)
+{
+	return g_SCHED_maxLatency;
+}
@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<sched.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the cooperative task scheduler>
+ ---------------------------------------------------------------------------*/
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+#define SCHED_MAX_TASKS			8
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+/* A task receives the events that were set for it since its last run, it
+ * shall return quickly without waiting for anything */
+typedef void (*SCHED_TaskType)(uint8 events);
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to add a task to the scheduler, the task id is also
+ * its priority (0 is the highest priority)
+ */
+void SCHED_createTask(uint8 task_id, SCHED_TaskType a_taskPtr);
+
+
+/*
+ * Description:
+ * This Function is used to set events for a task to make it ready, it can
+ * be called from an ISR
+ */
+void SCHED_setEvent(uint8 task_id, uint8 events);
+
+
+/*
+ * Description:
+ * This Function is used to run the ready task that has the highest priority
+ * once. It returns FALSE if no task was ready
+ */
+boolean SCHED_dispatch(void);
+
+
+/*
+ * Description:
+ * This Function is used to run the scheduler forever, it serves the system
+ * tick software timers and the ready tasks
+ */
+void SCHED_run(void);
+
+
+/*
+ * Description:
+ * This Function is used to read the longest pass of the scheduler loop that
+ * ran a task in CPU cycles, the worst time a ready task waited for the CPU
+ */
+uint32 SCHED_getMaxLatency(void);
+
+#endif /* SCHED_H_ */
@@ -0,0 +1,100 @@
+/*--------------------------------------------------------------------------
+ * [FILE NAME]:		<systick.h>
+ *
+ * [AUTHOR]:		<Marwan Gamal>
+ *
+ * [DATE CREATED]:	<19/10/2026>
+ *
+ * [DESCRIPTION]:	<A header file for the system tick and software timers>
+ ---------------------------------------------------------------------------*/
+
+#ifndef SYSTICK_H_
+#define SYSTICK_H_
+
+/*-----------------------------------INCLUDES---------------------------------*/
+
+#include "std_types.h"
+
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/* Timer1 runs on F_CPU without prescaling and clears on compare match every
+ * millisecond, so TCNT1 also counts the CPU cycles inside the current tick */
+#define SYSTICK_CYCLES_PER_MS		(F_CPU / 1000UL)
+
+/*-----------------------------TYPES DECLEARATION-----------------------------*/
+
+typedef enum
+{
+	SYSTICK_ONE_SHOT,SYSTICK_PERIODIC
+}SYSTICK_TimerMode;
+
+typedef struct SYSTICK_Timer
+{
+	struct SYSTICK_Timer *next;		/* Next timer in the list sorted by deadline */
+	uint32 deadline;				/* Tick at which the timer expires */
+	uint32 period;					/* Reload value in ms for periodic timers */
+	SYSTICK_TimerMode mode;
+	void (*callBack)(void);
+	boolean active;
+}SYSTICK_TimerType;
+
+/*-----------------------------FUNCTIONS PROTOTYPES---------------------------*/
+/*
+ * Description:
+ * This Function is used to start Timer1 as a free running 1 kHz system tick
+ */
+void SYSTICK_init(void);
+
+
+/*
+ * Description:
+ * This Function is used to read the number of milliseconds since SYSTICK_init
+ */
+uint32 SYSTICK_millis(void);
+
+
+/*
+ * Description:
+ * This Function is used to read a timestamp in CPU cycles built from the
+ * milliseconds counter and the Timer1 counter
+ */
+uint32 SYSTICK_cycles(void);
+
+
+/*
+ * Description:
+ * This Function is used to check if a deadline in ticks has been reached
+ */
+boolean SYSTICK_isExpired(uint32 deadline);
+
+
+/*
+ * Description:
+ * This Function is used to wait for the given milliseconds while the software
+ * timers keep running
+ */
+void SYSTICK_delay_ms(uint32 msec);
+
+
+/*
+ * Description:
+ * This Function is used to start a one-shot or a periodic software timer
+ */
+void SYSTICK_startTimer(SYSTICK_TimerType *a_timerPtr, uint32 msec, SYSTICK_TimerMode mode, void(*a_ptr)(void));
+
+
+/*
+ * Description:
+ * This Function is used to stop a software timer before it expires
+ */
+void SYSTICK_stopTimer(SYSTICK_TimerType *a_timerPtr);
+
+
+/*
+ * Description:
+ * This Function is used to call the call back functions of the expired
+ * software timers, it shall be called from the main loop
+ */
+void SYSTICK_processTimers(void);
+
+#endif /* SYSTICK_H_ */
@@ -16,17 +16,9 @@
 
 /*------------------------------------GLOBAL VARIABLES----------------------------------*/
 
-static volatile void(*g_TIMER0_callBackPtr)(uint16) = NULL_PTR;
-static volatile void(*g_TIMER1_callBackPtr)(uint16) = NULL_PTR;
-static volatile void(*g_TIMER2_callBackPtr)(uint16) = NULL_PTR;
-
-uint8 g_tick0 = 0;
-uint16 g_tick1 = 0;
-uint8 g_tick2 = 0;
-
-uint16 g_msec0 = 0;
-uint16 g_msec1 = 0;
-uint16 g_msec2 = 0;
+static void(* volatile g_TIMER0_callBackPtr)(void) = NULL_PTR;
+static void(* volatile g_TIMER1_callBackPtr)(void) = NULL_PTR;
+static void(* volatile g_TIMER2_callBackPtr)(void) = NULL_PTR;
 
 /*---------------------------------FUNCTIONS DEFINITIONS-------------------------------*/
 /*---------------------------------------------------------------------------------------
@@ -151,11 +143,11 @@ void TIMER_init(const TIMER_ConfigType *a_configPtr)
  * [FUNCTION NAME]:	TIMER0_setCallBack
  * [DESCRIPTION]:	This Function is used to assign the specific function used to the
  * 					global pointer to function of TIMER0 to use it in the ISR
- * [ARGS]:	void(*a_ptr)(uint16) :	This Argument is a pointer to function, indicating the
+ * [ARGS]:	void(*a_ptr)(void) :	This Argument is a pointer to function, indicating the
  * 								 	function called in the call back function
  *	[RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void TIMER0_setCallBack(void(*a_ptr)(uint16))
+void TIMER0_setCallBack(void(*a_ptr)(void))
 {
 	g_TIMER0_callBackPtr = a_ptr;
 }
@@ -164,11 +156,11 @@ void TIMER0_setCallBack(void(*a_ptr)(uint16))
  * [FUNCTION NAME]:	TIMER1_setCallBack
  * [DESCRIPTION]:	This Function is used to assign the specific function used to the
  * 					global pointer to function of TIMER1 to use it in the ISR
- * [ARGS]:	void(*a_ptr)(uint16) :	This Argument is a pointer to function, indicating the
+ * [ARGS]:	void(*a_ptr)(void) :	This Argument is a pointer to function, indicating the
  * 								 	function called in the call back function
  *	[RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void TIMER1_setCallBack(void(*a_ptr)(uint16))
+void TIMER1_setCallBack(void(*a_ptr)(void))
 {
 	g_TIMER1_callBackPtr = a_ptr;
 }
@@ -177,11 +169,11 @@ void TIMER1_setCallBack(void(*a_ptr)(uint16))
  * [FUNCTION NAME]:	TIMER2_setCallBack
  * [DESCRIPTION]:	This Function is used to assign the specific function used to the
  * 					global pointer to function of TIMER2 to use it in the ISR
- * [ARGS]:	void(*a_ptr)(uint16) :	This Argument is a pointer to function, indicating the
+ * [ARGS]:	void(*a_ptr)(void) :	This Argument is a pointer to function, indicating the
  * 								 	function called in the call back function
  *	[RETURNS]:	No Returns
  ----------------------------------------------------------------------------------------*/
-void TIMER2_setCallBack(void(*a_ptr)(uint16))
+void TIMER2_setCallBack(void(*a_ptr)(void))
 {
 	g_TIMER2_callBackPtr = a_ptr;
 }
@@ -253,7 +245,7 @@ ISR(TIMER0_OVF_vect)
 {
 	if(g_TIMER0_callBackPtr != NULL_PTR)
 	{
-		(*g_TIMER0_callBackPtr)(g_msec0);
+		(*g_TIMER0_callBackPtr)();
 	}
 }
 
@@ -267,7 +259,7 @@ ISR(TIMER0_COMP_vect)
 {
 	if(g_TIMER0_callBackPtr != NULL_PTR)
 	{
-		(*g_TIMER0_callBackPtr)(g_msec0);
+		(*g_TIMER0_callBackPtr)();
 	}
 }
 
@@ -281,11 +273,12 @@ ISR(TIMER1_OVF_vect)
 {
 	if(g_TIMER1_callBackPtr != NULL_PTR)
 	{
-		(*g_TIMER1_callBackPtr)(g_msec1);
+		(*g_TIMER1_callBackPtr)();
 	}
 }
 
 
+#if (TIMER1_COMPA_STATIC_BINDING == FALSE)
 /*---------------------------------------------------------------------------------------
  * [ISR NAME]:		TIMER1_COMPA_vect
  * [DESCRIPTION]:	This ISR will trigger the call back function when using compare match
@@ -295,9 +288,10 @@ ISR(TIMER1_COMPA_vect)
 {
 	if(g_TIMER1_callBackPtr != NULL_PTR)
 	{
-		(*g_TIMER1_callBackPtr)(g_msec1);
+		(*g_TIMER1_callBackPtr)();
 	}
 }
+#endif	/* TIMER1_COMPA_STATIC_BINDING */
 
 
 /*---------------------------------------------------------------------------------------
@@ -309,7 +303,7 @@ ISR(TIMER1_COMPB_vect)
 {
 	if(g_TIMER1_callBackPtr != NULL_PTR)
 	{
-		(*g_TIMER1_callBackPtr)(g_msec1);
+		(*g_TIMER1_callBackPtr)();
 	}
 }
 
@@ -322,10 +316,11 @@ ISR(TIMER2_OVF_vect)
 {
 	if(g_TIMER2_callBackPtr != NULL_PTR)
 	{
-		(*g_TIMER2_callBackPtr)(g_msec2);
+		(*g_TIMER2_callBackPtr)();
 	}
 }
 
+#if (TIMER2_COMP_STATIC_BINDING == FALSE)
 /*---------------------------------------------------------------------------------------
  * [ISR NAME]:		TIMER2_COMP_vect
  * [DESCRIPTION]:	This ISR will trigger the call back function when using compare match
@@ -335,6 +330,7 @@ ISR(TIMER2_COMP_vect)
 {
 	if(g_TIMER2_callBackPtr != NULL_PTR)
 	{
-		(*g_TIMER2_callBackPtr)(g_msec2);
+		(*g_TIMER2_callBackPtr)();
 	}
 }
+#endif	/* TIMER2_COMP_STATIC_BINDING */
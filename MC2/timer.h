@@ -15,15 +15,25 @@
 
 #include "std_types.h"
 
-/*------------------------------------EXTERNS---------------------------------*/
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
 
-extern uint8 g_tick0;
-extern uint16 g_tick1;
-extern uint8 g_tick2;
+/*
+ * Compile time binding of the Timer1 compare match A interrupt. When TRUE, this
+ * driver does not define the ISR and the system tick module defines it with the
+ * tick increment inlined, so no call is made through the call back pointer and
+ * only the registers used by the increment are saved. When FALSE, the ISR calls
+ * the function given to TIMER1_setCallBack.
+ * At the 1 MHz of the build a 1 ms tick is 1000 cycles. Counted from the -O0
+ * listing of the Debug build, the old call back ISR takes 102 cycles before the
+ * call back itself runs. At -Os the bound tick is estimated at about 60 cycles
+ * (6% of the CPU) against about 110 cycles (11%) through the call back, these two
+ * are counted by hand from the instruction timings and not from a listing.
+ */
+#define TIMER1_COMPA_STATIC_BINDING		TRUE
 
-extern uint16 g_msec0;
-extern uint16 g_msec1;
-extern uint16 g_msec2;
+/* Same for the Timer2 compare match interrupt, the buzzer defines it to toggle
+ * its pin for the tones */
+#define TIMER2_COMP_STATIC_BINDING		TRUE
 
 /*-----------------------------TYPES DECLEARATION-----------------------------*/
 typedef enum{
@@ -86,21 +96,21 @@ void TIMER_init(const TIMER_ConfigType *a_configPtr);
  * Description:
  * A Call back function for Timer0 driver
  */
-void TIMER0_setCallBack(void(*a_ptr)(uint16));
+void TIMER0_setCallBack(void(*a_ptr)(void));
 
 
 /*
  * Description:
  * A Call back function for Timer1 driver
  */
-void TIMER1_setCallBack(void(*a_ptr)(uint16));
+void TIMER1_setCallBack(void(*a_ptr)(void));
 
 
 /*
  * Description:
  * A Call back function for Timer2 driver
  */
-void TIMER2_setCallBack(void(*a_ptr)(uint16));
+void TIMER2_setCallBack(void(*a_ptr)(void));
 
 
 /*
@@ -15,6 +15,13 @@
 
 #include "std_types.h"
 
+/*------------------------DEFINITIONS AND CONFIGURATIONS----------------------*/
+
+/* When TRUE, the RX complete ISR saves the received bytes in a ring buffer so
+ * no byte is lost while the application is busy with something else */
+#define UART_RX_INTERRUPT		TRUE
+#define UART_RX_BUFFER_SIZE		32		/* Must be a power of 2, it holds a whole link frame */
+
 /*-----------------------------TYPES DECLEARATION-----------------------------*/
 typedef enum{
 	OFF,RESERVED,EVEN,ODD
@@ -57,6 +64,30 @@ void UART_sendByte(uint8 byte);
 uint8 UART_receiveByte(void);
 
 
+/*
+ * Description:
+ * A function responsible for checking if a received byte is waiting to be read
+ */
+boolean UART_isDataAvailable(void);
+
+
+/*
+ * Description:
+ * A function responsible for reading the counts of the framing errors and of
+ * the received bytes lost by an overrun since the start
+ */
+void UART_getErrors(uint16 *a_framingPtr, uint16 *a_overrunPtr);
+
+
+#if (UART_RX_INTERRUPT == TRUE)
+/*
+ * Description:
+ * A Call back function called from the RX complete ISR after saving a byte
+ */
+void UART_setRxCallBack(void(*a_ptr)(void));
+#endif
+
+
 /*
  * Description:
  * A function responsible for sending a string of bytes using UART
@@ -27,20 +27,30 @@
 #define RECEIVE_RE_ENTERED_PASSWORD			'@'
 #define OPEN_MAIN_MENU						'#'
 #define	ENTER_PASSWORD_AGAIN				'$'
-#define RECEIVE_PASSWORD_2					'%'
-#define ENTER_PASSWORD2_AGAIN				'^'
-#define RECEIVE_PASSWORD_3					'&'
 #define RECEIVE_PASSWORD_IN_MAIN_MENU		'*'
 #define ENTER_PASSWORD_AGAIN_MAIN_MENU		'('
-#define RECEIVE_PASSWORD_2_MAIN_MENU		')'
-#define ENTER_PASSWORD2_AGAIN_MAIN_MENU		'/'
-#define RECEIVE_PASSWORD_3_MAIN_MENU		'|'
 #define OPEN_DOOR							'['
 #define DOOR_IS_OPENED						'.'
 #define CLOSE_DOOR							';'
+#define DOOR_PROGRESS						'%'		/* Followed by the door position in percent and the door state */
+#define DOOR_REOPEN							'^'		/* Open the door again while it is closing */
+#define DOOR_ABORT							'&'		/* Stop the door where it is */
+#define DOOR_STALLED						'='		/* The door stopped before the end of its travel */
 #define ALARM_ON							']'
+#define LOCKOUT_TIME						'_'		/* Followed by the seconds left of the lockout (2 bytes) */
 #define SEND_CORRECT						'>'
 #define SEND_WRONG							'<'
+#define KEY_PRESSED							'"'		/* A key is pressed on mC1, mC2 beeps */
+#define PROFILE_DUMP						'?'		/* Sent by a PC on the link to read the profiling records */
+#define DIAGNOSTICS							')'		/* Sent by a PC on the link to read the counters of mC2 */
+#define STATE_REQUEST						'\''	/* mC1 asks mC2 for its state after its reset */
+
+/* Session handshake of the link, the hello and the challenge have no MAC */
+#define LINK_HELLO							','		/* mC1 asks mC2 for a new session */
+#define LINK_CHALLENGE						'/'		/* Followed by the nonce of mC2 */
+#define LINK_RESPONSE						'|'		/* First frame of the session, holds the nonce of mC1 */
+#define LINK_REPORT							'`'		/* Followed by the size, the command and the answer to
+													 * PROFILE_DUMP or DIAGNOSTICS, it is skipped by the link */
 
 
 #endif /* UART_COMMANDS_H_ */